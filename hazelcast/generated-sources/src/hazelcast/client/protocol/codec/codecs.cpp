@@ -289,6 +289,34 @@ map_put_encode(const std::string& name,
     return msg;
 }
 
+ClientMessage
+map_put_encode(const std::string& name,
+               const serialization::pimpl::data& key,
+               serialization::pimpl::data&& value,
+               int64_t thread_id,
+               int64_t ttl)
+{
+    size_t initial_frame_size = ClientMessage::REQUEST_HEADER_LEN +
+                                ClientMessage::INT64_SIZE +
+                                ClientMessage::INT64_SIZE;
+    ClientMessage msg(initial_frame_size);
+    msg.set_retryable(false);
+    msg.set_operation_name("map.put");
+
+    msg.set_message_type(static_cast<int32_t>(65792));
+    msg.set_partition_id(-1);
+
+    msg.set(thread_id);
+    msg.set(ttl);
+    msg.set(name);
+
+    msg.set(key);
+
+    msg.set(std::move(value), true);
+
+    return msg;
+}
+
 ClientMessage
 map_get_encode(const std::string& name,
                const serialization::pimpl::data& key,
@@ -627,6 +655,34 @@ map_set_encode(const std::string& name,
     return msg;
 }
 
+ClientMessage
+map_set_encode(const std::string& name,
+               const serialization::pimpl::data& key,
+               serialization::pimpl::data&& value,
+               int64_t thread_id,
+               int64_t ttl)
+{
+    size_t initial_frame_size = ClientMessage::REQUEST_HEADER_LEN +
+                                ClientMessage::INT64_SIZE +
+                                ClientMessage::INT64_SIZE;
+    ClientMessage msg(initial_frame_size);
+    msg.set_retryable(false);
+    msg.set_operation_name("map.set");
+
+    msg.set_message_type(static_cast<int32_t>(69376));
+    msg.set_partition_id(-1);
+
+    msg.set(thread_id);
+    msg.set(ttl);
+    msg.set(name);
+
+    msg.set(key);
+
+    msg.set(std::move(value), true);
+
+    return msg;
+}
+
 ClientMessage
 map_lock_encode(const std::string& name,
                 const serialization::pimpl::data& key,
@@ -1434,6 +1490,72 @@ map_entrieswithpagingpredicate_encode(
     return msg;
 }
 
+ClientMessage
+map_fetchkeys_encode(
+  const std::string& name,
+  const std::vector<std::pair<int32_t, int32_t>>& iteration_pointers,
+  int32_t batch)
+{
+    size_t initial_frame_size =
+      ClientMessage::REQUEST_HEADER_LEN + ClientMessage::INT32_SIZE;
+    ClientMessage msg(initial_frame_size);
+    msg.set_retryable(true);
+    msg.set_operation_name("map.fetchkeys");
+
+    msg.set_message_type(static_cast<int32_t>(79616));
+    msg.set_partition_id(-1);
+
+    msg.set(batch);
+    msg.set(name);
+
+    msg.set(iteration_pointers, true);
+
+    return msg;
+}
+
+ClientMessage
+map_fetchentries_encode(
+  const std::string& name,
+  const std::vector<std::pair<int32_t, int32_t>>& iteration_pointers,
+  int32_t batch)
+{
+    size_t initial_frame_size =
+      ClientMessage::REQUEST_HEADER_LEN + ClientMessage::INT32_SIZE;
+    ClientMessage msg(initial_frame_size);
+    msg.set_retryable(true);
+    msg.set_operation_name("map.fetchentries");
+
+    msg.set_message_type(static_cast<int32_t>(79872));
+    msg.set_partition_id(-1);
+
+    msg.set(batch);
+    msg.set(name);
+
+    msg.set(iteration_pointers, true);
+
+    return msg;
+}
+
+ClientMessage
+map_fetchnearcacheinvalidationmetadata_encode(
+  const std::vector<std::string>& names,
+  boost::uuids::uuid uuid)
+{
+    size_t initial_frame_size =
+      ClientMessage::REQUEST_HEADER_LEN + ClientMessage::UUID_SIZE;
+    ClientMessage msg(initial_frame_size);
+    msg.set_retryable(false);
+    msg.set_operation_name("map.fetchnearcacheinvalidationmetadata");
+
+    msg.set_message_type(static_cast<int32_t>(81152));
+    msg.set_partition_id(-1);
+
+    msg.set(uuid);
+    msg.set(names, true);
+
+    return msg;
+}
+
 ClientMessage
 map_removeall_encode(const std::string& name,
                      const serialization::pimpl::data& predicate)
@@ -311,6 +311,17 @@ map_put_encode(const std::string& name,
                int64_t thread_id,
                int64_t ttl);
 
+/**
+ * Same as above, but the serialized value buffer is moved into the message
+ * instead of being copied.
+ */
+ClientMessage HAZELCAST_API
+map_put_encode(const std::string& name,
+               const serialization::pimpl::data& key,
+               serialization::pimpl::data&& value,
+               int64_t thread_id,
+               int64_t ttl);
+
 /**
  * This method returns a clone of the original value, so modifying the returned
  * value does not change the actual value in the map. You should put the
@@ -466,6 +477,17 @@ map_set_encode(const std::string& name,
                int64_t thread_id,
                int64_t ttl);
 
+/**
+ * Same as above, but the serialized value buffer is moved into the message
+ * instead of being copied.
+ */
+ClientMessage HAZELCAST_API
+map_set_encode(const std::string& name,
+               const serialization::pimpl::data& key,
+               serialization::pimpl::data&& value,
+               int64_t thread_id,
+               int64_t ttl);
+
 /**
  * Acquires the lock for the specified lease time.After lease time, lock will be
  * released.If the lock is not available then the current thread becomes
@@ -933,6 +955,34 @@ map_entrieswithpagingpredicate_encode(
   const std::string& name,
   const codec::holder::paging_predicate_holder& predicate);
 
+/**
+ * Fetches specified number of keys from the specified partition starting from
+ * specified table index.
+ */
+ClientMessage HAZELCAST_API
+map_fetchkeys_encode(
+  const std::string& name,
+  const std::vector<std::pair<int32_t, int32_t>>& iteration_pointers,
+  int32_t batch);
+
+/**
+ * Fetches specified number of entries from the specified partition starting
+ * from specified table index.
+ */
+ClientMessage HAZELCAST_API
+map_fetchentries_encode(
+  const std::string& name,
+  const std::vector<std::pair<int32_t, int32_t>>& iteration_pointers,
+  int32_t batch);
+
+/**
+ * Fetches invalidation metadata from partitions of map.
+ */
+ClientMessage HAZELCAST_API
+map_fetchnearcacheinvalidationmetadata_encode(
+  const std::vector<std::string>& names,
+  boost::uuids::uuid uuid);
+
 /**
  * Removes all entries which match with the supplied predicate
  */
@@ -318,6 +318,13 @@ public:
     const config::near_cache_config* get_near_cache_config(
       const std::string& name) const;
 
+    /**
+     * \return the added Near Cache configs by their names, the names may
+     * contain wildcards
+     */
+    const std::unordered_map<std::string, config::near_cache_config>&
+    get_near_cache_configs() const;
+
     /**
      * Gets {\link com.hazelcast.client.config.client_network_config}
      *
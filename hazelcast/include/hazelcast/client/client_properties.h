@@ -101,6 +101,18 @@ public:
 
     const client_property& partition_arg_cache_size() const;
 
+    const client_property& io_thread_count() const;
+
+    const client_property& io_busy_poll() const;
+
+    const client_property& invocation_inline_completion() const;
+
+    const client_property& deserialization_chunk_size() const;
+
+    const client_property& invalidation_max_tolerated_miss_count() const;
+
+    const client_property& invalidation_reconciliation_interval_seconds() const;
+
     /**
      * Client will be sending heartbeat messages to members and this is the
      * timeout. If there is no any message passing between client and member
@@ -278,6 +290,67 @@ public:
       "hazelcast.client.sql.partition.argument.cache.size";
     static constexpr const char* PARTITION_ARGUMENT_CACHE_SIZE_DEFAULT = "1024";
 
+    /**
+     * The number of I/O threads. Each I/O thread runs its own io_context and
+     * the connections are distributed over them, so that all the I/O of a
+     * connection is handled by a single thread. The default value 1 makes all
+     * the connections share a single io_context.
+     */
+    static constexpr const char* IO_THREAD_COUNT =
+      "hazelcast.client.io.thread.count";
+    static constexpr const char* IO_THREAD_COUNT_DEFAULT = "1";
+
+    /**
+     * When enabled, the I/O threads poll their io_context in a loop instead of
+     * blocking while waiting for I/O. It lowers the latency at the cost of
+     * keeping each I/O thread busy on a core; use it only on deployments
+     * with spare cores.
+     */
+    static constexpr const char* IO_BUSY_POLL = "hazelcast.client.io.busy.poll";
+    static constexpr const char* IO_BUSY_POLL_DEFAULT = "false";
+
+    /**
+     * When enabled, invocation futures are completed directly on the I/O
+     * thread which receives the response instead of on the user executor.
+     * It saves a thread hop per response, but the continuations attached to
+     * the futures run on the I/O thread and must not block. It can be
+     * overridden per proxy.
+     */
+    static constexpr const char* INVOCATION_INLINE_COMPLETION =
+      "hazelcast.client.invocation.inline.completion";
+    static constexpr const char* INVOCATION_INLINE_COMPLETION_DEFAULT = "false";
+
+    /**
+     * The number of entries deserialized by a single task when a bulk result
+     * (e.g. get_all, entry_set, values) is converted to objects. Larger results
+     * are split into chunks which are deserialized in parallel on the user
+     * executor. 0 disables the parallel deserialization.
+     */
+    static constexpr const char* DESERIALIZATION_CHUNK_SIZE =
+      "hazelcast.client.deserialization.chunk.size";
+    static constexpr const char* DESERIALIZATION_CHUNK_SIZE_DEFAULT = "4096";
+
+    /**
+     * The number of invalidation sequences a Near Cache may miss before the
+     * records of the partitions with missed sequences are treated as stale
+     * and fetched from the cluster again.
+     */
+    static constexpr const char* INVALIDATION_MAX_TOLERATED_MISS_COUNT =
+      "hazelcast.invalidation.max.tolerated.miss.count";
+    static constexpr const char* INVALIDATION_MAX_TOLERATED_MISS_COUNT_DEFAULT =
+      "10";
+
+    /**
+     * The period in seconds at which the Near Cache invalidation metadata
+     * (partition uuids and sequences) is reconciled with the members, so that
+     * lost invalidations are detected even if no further invalidation is
+     * received. 0 disables the reconciliation.
+     */
+    static constexpr const char* INVALIDATION_RECONCILIATION_INTERVAL_SECONDS =
+      "hazelcast.invalidation.reconciliation.interval.seconds";
+    static constexpr const char*
+      INVALIDATION_RECONCILIATION_INTERVAL_SECONDS_DEFAULT = "60";
+
     /**
      * Returns the configured boolean value of a {@link ClientProperty}.
      *
@@ -329,6 +402,12 @@ private:
     client_property fail_on_indeterminate_state_;
     client_property cloud_base_url_;
     client_property partition_arg_cache_size_;
+    client_property io_thread_count_;
+    client_property io_busy_poll_;
+    client_property invocation_inline_completion_;
+    client_property deserialization_chunk_size_;
+    client_property invalidation_max_tolerated_miss_count_;
+    client_property invalidation_reconciliation_interval_seconds_;
 
     std::unordered_map<std::string, std::string> properties_map_;
 };
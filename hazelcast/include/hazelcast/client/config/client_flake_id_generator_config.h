@@ -58,6 +58,11 @@ public:
      */
     static constexpr int32_t MAXIMUM_PREFETCH_COUNT = 100000;
 
+    /**
+     * Default value for {@link #get_prefetch_low_water_mark_percentage()}.
+     */
+    static constexpr int32_t DEFAULT_PREFETCH_LOW_WATER_MARK_PERCENTAGE = 20;
+
     explicit client_flake_id_generator_config(const std::string& name);
 
     /**
@@ -113,10 +118,34 @@ public:
     client_flake_id_generator_config& set_prefetch_validity_duration(
       std::chrono::milliseconds duration);
 
+    /**
+     * @see #set_prefetch_low_water_mark_percentage(int32_t)
+     */
+    int32_t get_prefetch_low_water_mark_percentage() const;
+
+    /**
+     * Sets the percentage of the prefetched IDs, which are still unused when
+     * the next batch is requested on the background. When the current batch
+     * runs out, the next one is then usually already available and
+     * {@link flake_id_generator#new_id()} does not wait for a round-trip to the
+     * cluster. Default is 20.
+     *
+     * @param percentage the desired low water mark in the range 0..100, 0
+     * disables the background prefetch, i.e. the next batch is requested only
+     * when the current one is exhausted.
+     * @return this instance for fluent API
+     *
+     * @throws client::exception::illegal_argument if percentage is out of
+     * range.
+     */
+    client_flake_id_generator_config& set_prefetch_low_water_mark_percentage(
+      int32_t percentage);
+
 private:
     std::string name_;
     int32_t prefetch_count_;
     std::chrono::milliseconds prefetch_validity_duration_;
+    int32_t prefetch_low_water_mark_percentage_;
 };
 } // namespace config
 } // namespace client
@@ -121,6 +121,29 @@ public:
      */
     client_network_config& set_smart_routing(bool smart_routing);
 
+    /**
+     * @return the number of connections the client opens to each member
+     * @see #set_connections_per_member(int32_t)
+     */
+    int32_t get_connections_per_member() const;
+
+    /**
+     * Sets the number of connections the smart client opens to each member.
+     * Partition bound invocations are pinned to the connection with the index
+     * {@code partition_id % connections_per_member}, so that the invocations
+     * of a partition keep their order, and the rest of the invocations are
+     * spread round-robin over the connections of the target member. Only
+     * one connection is opened when smart routing is disabled. <p> Default
+     * value is {@code 1}.
+     *
+     * @param connections_per_member the number of connections, must be
+     * positive
+     * @return configured client_network_config for chaining
+     * @throws illegal_argument if connections_per_member is not positive
+     */
+    client_network_config& set_connections_per_member(
+      int32_t connections_per_member);
+
     /**
      * Returns the list of candidate addresses that client will use to establish
      * initial connection
@@ -181,6 +204,7 @@ private:
 
     std::chrono::milliseconds connection_timeout_;
     bool smart_routing_;
+    int32_t connections_per_member_{ 1 };
 
     std::vector<address> address_list_;
 
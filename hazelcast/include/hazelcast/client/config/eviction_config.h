@@ -48,7 +48,17 @@ public:
          * Policy based on maximum number of entries stored per data structure
          * (map, cache etc)
          */
-        ENTRY_COUNT
+        ENTRY_COUNT,
+        /**
+         * Policy based on maximum heap memory in megabytes used by the records
+         * of the Near Cache, see near_cache_stats::get_owned_entry_memory_cost
+         */
+        USED_HEAP_SIZE,
+        /**
+         * Policy based on maximum percentage of the heap budget (see
+         * set_heap_budget_megabytes) used by the records of the Near Cache
+         */
+        USED_HEAP_PERCENTAGE
         /* TODO,
         *
          * Policy based on maximum used native memory in megabytes per data
@@ -74,6 +84,27 @@ public:
                 FREE_NATIVE_MEMORY_PERCENTAGE*/
     };
 
+    /**
+     * Admission policy which decides if a new record may displace the record
+     * selected for eviction when the Near Cache is full
+     */
+    enum admission_policy
+    {
+        /**
+         * Every new record is admitted, the eviction policy alone selects the
+         * evicted record
+         */
+        ALWAYS,
+        /**
+         * TinyLFU: the access frequencies of the keys are estimated with a
+         * compact count-min sketch. A new record is admitted only if its key is
+         * accessed more frequently than the key of the eviction candidate, so
+         * that scans of rarely used keys do not flush the frequently used
+         * records.
+         */
+        TINY_LFU
+    };
+
     /**
      * Default maximum entry count.
      */
@@ -91,6 +122,12 @@ public:
     static constexpr eviction_policy DEFAULT_EVICTION_POLICY =
       eviction_policy::LRU;
 
+    /**
+     * Default Admission Policy.
+     */
+    static constexpr admission_policy DEFAULT_ADMISSION_POLICY =
+      admission_policy::ALWAYS;
+
     eviction_config();
 
     int32_t get_size() const;
@@ -106,6 +143,29 @@ public:
 
     eviction_config& set_eviction_policy(eviction_policy policy);
 
+    admission_policy get_admission_policy() const;
+
+    /**
+     * Sets the admission policy, it is applied only if an eviction policy
+     * other than NONE is set.
+     *
+     * \param policy the admission policy
+     * \return this config for chaining
+     */
+    eviction_config& set_admission_policy(admission_policy policy);
+
+    int32_t get_heap_budget_megabytes() const;
+
+    /**
+     * Sets the heap budget which the size is a percentage of when the
+     * max-size policy is USED_HEAP_PERCENTAGE. The same budget can be shared
+     * by the configs of several Near Caches, each taking its percentage of it.
+     *
+     * \param heap_budget_megabytes the heap budget in megabytes
+     * \return this config for chaining
+     */
+    eviction_config& set_heap_budget_megabytes(int32_t heap_budget_megabytes);
+
     eviction_strategy_type get_eviction_strategy_type() const;
 
     friend std::ostream HAZELCAST_API& operator<<(
@@ -116,6 +176,8 @@ protected:
     int32_t size_;
     max_size_policy max_size_policy_;
     eviction_policy eviction_policy_;
+    admission_policy admission_policy_;
+    int32_t heap_budget_megabytes_;
 };
 
 } // namespace config
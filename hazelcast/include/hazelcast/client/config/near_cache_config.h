@@ -17,6 +17,7 @@
 
 #include "hazelcast/client/config/in_memory_format.h"
 #include "hazelcast/client/config/eviction_config.h"
+#include "hazelcast/client/config/near_cache_preloader_config.h"
 
 #if defined(WIN32) || defined(_WIN32) || defined(WIN64) || defined(_WIN64)
 #pragma warning(push)
@@ -229,6 +230,17 @@ public:
     near_cache_config& set_eviction_config(
       const eviction_config& eviction_config);
 
+    /**
+     * Gets the configuration of the key storage and pre-loading of the Near
+     * Cache.
+     */
+    near_cache_preloader_config& get_preloader_config();
+
+    const near_cache_preloader_config& get_preloader_config() const;
+
+    near_cache_config& set_preloader_config(
+      const near_cache_preloader_config& preloader_config);
+
     friend std::ostream HAZELCAST_API& operator<<(
       std::ostream& out,
       const near_cache_config& cache_config);
@@ -255,6 +267,8 @@ private:
      * </ul>
      */
     eviction_config eviction_config_;
+
+    near_cache_preloader_config preloader_config_;
 };
 
 } // namespace config
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2008-2023, Hazelcast, Inc. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+#include "hazelcast/util/export.h"
+
+#if defined(WIN32) || defined(_WIN32) || defined(WIN64) || defined(_WIN64)
+#pragma warning(push)
+#pragma warning(disable : 4251) // for dll export
+#endif
+
+namespace hazelcast {
+namespace client {
+namespace config {
+/**
+ * Configuration for storing and pre-loading Near Cache keys.
+ *
+ * When enabled, the keys of the Near Cache are written to a file in the
+ * configured directory periodically. When the client is started again, the
+ * Near Cache is filled with the values of the stored keys before the client
+ * is reported as started, so that a restarted client does not start with a
+ * cold Near Cache.
+ *
+ * The file name is derived from the Near Cache name, hence the directory
+ * should not be shared by the clients which use Near Caches with the same
+ * name.
+ */
+class HAZELCAST_API near_cache_preloader_config
+{
+public:
+    /**
+     * Default initial delay for the Near Cache key storage.
+     */
+    static constexpr int32_t DEFAULT_STORE_INITIAL_DELAY_SECONDS = 600;
+
+    /**
+     * Default interval for the Near Cache key storage (in seconds).
+     */
+    static constexpr int32_t DEFAULT_STORE_INTERVAL_SECONDS = 600;
+
+    near_cache_preloader_config();
+
+    explicit near_cache_preloader_config(const std::string& directory);
+
+    bool is_enabled() const;
+
+    near_cache_preloader_config& set_enabled(bool enabled);
+
+    const std::string& get_directory() const;
+
+    /**
+     * @param directory the directory of the key files, the working directory
+     * of the process if empty
+     */
+    near_cache_preloader_config& set_directory(const std::string& directory);
+
+    int32_t get_store_initial_delay_seconds() const;
+
+    near_cache_preloader_config& set_store_initial_delay_seconds(
+      int32_t store_initial_delay_seconds);
+
+    int32_t get_store_interval_seconds() const;
+
+    near_cache_preloader_config& set_store_interval_seconds(
+      int32_t store_interval_seconds);
+
+    friend std::ostream HAZELCAST_API& operator<<(
+      std::ostream& out,
+      const near_cache_preloader_config& config);
+
+private:
+    bool enabled_;
+    std::string directory_;
+    int32_t store_initial_delay_seconds_;
+    int32_t store_interval_seconds_;
+};
+} // namespace config
+} // namespace client
+} // namespace hazelcast
+
+#if defined(WIN32) || defined(_WIN32) || defined(WIN64) || defined(_WIN64)
+#pragma warning(pop)
+#endif
@@ -41,6 +41,17 @@ public:
      */
     static const int DEFAULT_BUFFER_SIZE_BYTE = 128 * KILO_BYTE;
 
+    /**
+     * default upper bound for the number of bytes written in one socket flush
+     */
+    static const int DEFAULT_MAX_WRITE_BATCH_SIZE_BYTE = 128 * KILO_BYTE;
+
+    /**
+     * default upper bound for the number of buffers (iovec entries) written
+     * in one socket flush
+     */
+    static const int DEFAULT_MAX_WRITE_BATCH_BUFFERS = 512;
+
     socket_options();
 
     /**
@@ -127,6 +138,47 @@ public:
      */
     socket_options& set_buffer_size_in_bytes(int buffer_size);
 
+    /**
+     * Gets the maximum number of bytes that are coalesced into a single
+     * gather write when several messages are queued for the same connection.
+     *
+     * The default value is DEFAULT_MAX_WRITE_BATCH_SIZE_BYTE
+     *
+     * @return the maximum batch size in bytes
+     */
+    int get_max_write_batch_size_in_bytes() const;
+
+    /**
+     * Sets the maximum number of bytes that are coalesced into a single
+     * gather write. A message larger than this limit is still written, but
+     * alone. If set to 0 or less, every message is written separately.
+     *
+     * @param max_write_batch_size Number of bytes
+     * @return SocketOptions configured
+     */
+    socket_options& set_max_write_batch_size_in_bytes(int max_write_batch_size);
+
+    /**
+     * Gets the maximum number of buffers (frames) that are coalesced into a
+     * single gather write.
+     *
+     * The default value is DEFAULT_MAX_WRITE_BATCH_BUFFERS
+     *
+     * @return the maximum number of buffers in one write
+     */
+    int get_max_write_batch_buffers() const;
+
+    /**
+     * Sets the maximum number of buffers (frames) that are coalesced into a
+     * single gather write. A message with more frames than this limit is
+     * still written, but alone. If set to 0 or less, every message is written
+     * separately.
+     *
+     * @param max_write_batch_buffers Number of buffers
+     * @return SocketOptions configured
+     */
+    socket_options& set_max_write_batch_buffers(int max_write_batch_buffers);
+
 private:
     // socket options
 
@@ -139,6 +191,10 @@ private:
     int linger_seconds_;
 
     int buffer_size_;
+
+    int max_write_batch_size_;
+
+    int max_write_batch_buffers_;
 };
 
 } // namespace config
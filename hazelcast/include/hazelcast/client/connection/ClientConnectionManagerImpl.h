@@ -20,6 +20,7 @@
 #include <random>
 #include <thread>
 #include <future>
+#include <unordered_map>
 #include <vector>
 #include <mutex>
 #include <boost/asio.hpp>
@@ -110,6 +111,29 @@ public:
 
     std::shared_ptr<Connection> get_connection(boost::uuids::uuid uuid);
 
+    /**
+     * @return the connections to the member, the one in the active
+     * connections first, empty if the client is not connected to the member
+     */
+    std::vector<std::shared_ptr<Connection>> get_member_connections(
+      boost::uuids::uuid uuid);
+
+    /**
+     * Spreads the invocations which are not bound to a partition over the
+     * connections to the member of the given connection.
+     *
+     * @return the next connection to the member of the given connection in
+     * round-robin order, the given connection itself if it is the only one
+     */
+    std::shared_ptr<Connection> next_member_connection(
+      const std::shared_ptr<Connection>& connection);
+
+    /**
+     * @return all the authenticated connections including the additional
+     * connections opened to the members
+     */
+    std::vector<std::shared_ptr<Connection>> get_all_connections();
+
     bool is_alive();
 
     void on_connection_close(const std::shared_ptr<Connection>& connection);
@@ -226,6 +250,23 @@ private:
 
     void connect_to_all_members();
 
+    /**
+     * Opens the connection to the member if it does not exist and then the
+     * additional connections up to the configured connections per member.
+     */
+    void connect_to_member(const member& m);
+
+    bool has_all_connections(boost::uuids::uuid member_uuid);
+
+    /**
+     * Registers the connection as an additional connection to the member if
+     * more connections per member are configured.
+     *
+     * @return false if the member already has all its connections
+     */
+    bool add_extra_connection(boost::uuids::uuid member_uuid,
+                              const std::shared_ptr<Connection>& connection);
+
     static void shutdown_with_external_thread(
       std::weak_ptr<client::impl::hazelcast_client_instance_impl> client_impl);
 
@@ -277,11 +318,20 @@ private:
       const std::shared_ptr<Connection>& connection,
       auth_response& response);
 
+    /**
+     * Removes the registered connection again if it is closed during the
+     * authentication, and closes it if the client is shut down.
+     *
+     * @return the connection, nullptr if it is closed already
+     */
+    std::shared_ptr<Connection> check_authenticated_connection(
+      const std::shared_ptr<Connection>& connection);
+
     std::atomic_bool alive_;
     logger& logger_;
     std::chrono::milliseconds connection_timeout_millis_;
     spi::ClientContext& client_;
-    std::unique_ptr<boost::asio::io_context> io_context_;
+    std::vector<std::unique_ptr<boost::asio::io_context>> io_contexts_;
     socket_interceptor socket_interceptor_;
     util::SynchronizedMap<member, bool> connecting_members_;
     // TODO: change with CopyOnWriteArraySet<ConnectionListener> as in Java
@@ -294,12 +344,13 @@ private:
     std::unique_ptr<boost::asio::ip::tcp::resolver> io_resolver_;
     std::unique_ptr<internal::socket::SocketFactory> socket_factory_;
     HeartbeatManager heartbeat_;
-    std::thread io_thread_;
-    std::unique_ptr<boost::asio::io_context::work> io_guard_;
+    std::vector<std::thread> io_threads_;
+    std::vector<std::unique_ptr<boost::asio::io_context::work>> io_guards_;
     const bool async_start_;
     const config::client_connection_strategy_config::reconnect_mode
       reconnect_mode_;
     const bool smart_routing_enabled_;
+    const int32_t connections_per_member_;
     boost::optional<boost::asio::steady_timer> connect_to_members_timer_;
     boost::uuids::uuid client_uuid_;
     boost::chrono::milliseconds authentication_timeout_;
@@ -314,6 +365,15 @@ private:
                           boost::hash<boost::uuids::uuid>>
       active_connections_;
     util::SynchronizedMap<int32_t, Connection> active_connection_ids_;
+    // The connections opened to a member in addition to the one in
+    // active_connections_. They are only opened while the member has an
+    // active connection and closed together with it.
+    std::unordered_map<boost::uuids::uuid,
+                       std::vector<std::shared_ptr<Connection>>,
+                       boost::hash<boost::uuids::uuid>>
+      extra_connections_;
+    std::mutex extra_connections_mutex_;
+    std::atomic<uint32_t> round_robin_index_{ 0 };
 #ifdef __linux__
     // default support for 16 byte atomics is missing for linux
     util::Sync<boost::uuids::uuid> cluster_id_;
@@ -24,6 +24,7 @@
 
 #include "hazelcast/client/socket.h"
 #include "hazelcast/client/connection/ReadHandler.h"
+#include "hazelcast/client/connection/correlation_table.h"
 #include "hazelcast/util/SynchronizedMap.h"
 #include "hazelcast/util/Closeable.h"
 #include "hazelcast/client/protocol/ClientMessageBuilder.h"
@@ -130,9 +131,8 @@ public:
     friend std::ostream& operator<<(std::ostream& os,
                                     const Connection& connection);
 
-    ReadHandler read_handler;
-    std::unordered_map<int64_t, std::shared_ptr<spi::impl::ClientInvocation>>
-      invocations;
+    ReadHandler<Connection> read_handler;
+    correlation_table invocations;
 
 private:
     void log_close();
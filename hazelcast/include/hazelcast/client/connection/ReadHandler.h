@@ -17,48 +17,239 @@
 #pragma once
 
 #include <stdint.h>
+#include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
 
 #include "hazelcast/util/ByteBuffer.h"
+#include "hazelcast/client/protocol/ClientMessage.h"
 #include "hazelcast/client/protocol/ClientMessageBuilder.h"
 
-#if defined(WIN32) || defined(_WIN32) || defined(WIN64) || defined(_WIN64)
-#pragma warning(push)
-#pragma warning(disable : 4251) // for dll export
-#endif
-
 namespace hazelcast {
 namespace client {
-
-namespace serialization {}
-namespace spi {
-class ClientContext;
-}
 namespace connection {
-class Connection;
 
-class HAZELCAST_API ReadHandler
+/**
+ * Parses the bytes received by a connection into client messages.
+ *
+ * The socket reads into a receive buffer which grows when the reads fill it
+ * up or a message does not fit into it, and shrinks back when the traffic
+ * calms down. Every complete message in the buffer is copied into its message
+ * with a single copy and all of them are dispatched in one pass per read. A
+ * message which is not complete stays in the buffer until the rest of it is
+ * received. Only a message larger than MAX_BUFFER_SIZE is assembled frame by
+ * frame over the reads.
+ *
+ * The messages are passed to MessageHandler::handle_client_message and the
+ * handler is closed via MessageHandler::close when a malformed frame is
+ * received.
+ */
+template<typename MessageHandler>
+class ReadHandler
 {
 public:
-    ReadHandler(Connection& connection, size_t buffer_size);
+    static constexpr size_t MAX_BUFFER_SIZE = 1 << 20;
+
+    ReadHandler(MessageHandler& handler, size_t buffer_size)
+      : handler_(handler)
+      , buffer_(buffer_size)
+      , initial_capacity_(buffer_size)
+      , builder_(handler)
+      , last_read_time_(std::chrono::steady_clock::now().time_since_epoch())
+    {}
+
+    /**
+     * @return the position the next socket read should write to
+     */
+    char* read_position() { return &buffer_[limit_]; }
+
+    /**
+     * @return the number of bytes that can be written at read_position
+     */
+    size_t read_space() const { return buffer_.size() - limit_; }
+
+    /**
+     * Handles the bytes_read bytes written at read_position and dispatches
+     * all the messages which are completed by them.
+     */
+    void handle(size_t bytes_read)
+    {
+        last_read_time_ = std::chrono::steady_clock::now().time_since_epoch();
+
+        auto space_before_read = read_space();
+        limit_ += bytes_read;
+
+        size_t position = 0;
+        size_t required = 0;
+        while (position < limit_) {
+            if (streaming_) {
+                util::ByteBuffer remaining_bytes(&buffer_[position],
+                                                 limit_ - position);
+                // it is important to check the on_data return value since
+                // there may be left data less than a frame header size
+                bool completed = builder_.on_data(remaining_bytes);
+                position += remaining_bytes.position();
+                if (!completed) {
+                    break;
+                }
+                streaming_ = false;
+                continue;
+            }
+
+            auto length = complete_message_length(
+              &buffer_[position], limit_ - position, required);
+            if (length > 0) {
+                std::unique_ptr<protocol::ClientMessage> message(
+                  new protocol::ClientMessage());
+                std::memcpy(
+                  message->wr_ptr(length), &buffer_[position], length);
+                position += length;
+                builder_.on_message(std::move(message));
+                continue;
+            }
+
+            if (required == 0) {
+                handler_.close("Received a malformed frame");
+                limit_ = 0;
+                return;
+            }
 
-    ~ReadHandler();
+            if (required > MAX_BUFFER_SIZE) {
+                // assemble the message frame by frame instead of waiting for
+                // it in the buffer
+                streaming_ = true;
+                continue;
+            }
+            break;
+        }
 
-    void handle();
+        if (position > 0) {
+            std::memmove(&buffer_[0], &buffer_[position], limit_ - position);
+            limit_ -= position;
+        }
 
-    std::chrono::steady_clock::time_point get_last_read_time() const;
+        adapt_capacity(
+          bytes_read, space_before_read, streaming_ ? 0 : required);
+    }
 
-    char* buffer;
-    util::ByteBuffer byte_buffer;
+    std::chrono::steady_clock::time_point get_last_read_time() const
+    {
+        return std::chrono::steady_clock::time_point{ last_read_time_ };
+    }
+
+    /**
+     * @return the current size of the receive buffer
+     */
+    size_t capacity() const { return buffer_.size(); }
 
 private:
-    protocol::ClientMessageBuilder<Connection> builder_;
+    // the number of successive small reads after which the buffer shrinks
+    static constexpr int32_t SHRINK_AFTER_SMALL_READS = 64;
+
+    /**
+     * @param required is set to the number of bytes known to be needed for
+     * the message if it is not complete
+     * @return the length of the message at data, 0 if the message is not
+     * complete
+     */
+    static size_t complete_message_length(const char* data,
+                                          size_t available,
+                                          size_t& required)
+    {
+        using protocol::ClientMessage;
+        size_t length = 0;
+        while (true) {
+            if (available - length <
+                ClientMessage::SIZE_OF_FRAME_LENGTH_AND_FLAGS) {
+                required =
+                  length + ClientMessage::SIZE_OF_FRAME_LENGTH_AND_FLAGS;
+                return 0;
+            }
+
+            auto* frame =
+              reinterpret_cast<const ClientMessage::frame_header_type*>(
+                data + length);
+            auto frame_len = static_cast<int32_t>(frame->frame_len);
+            if (frame_len < static_cast<int32_t>(
+                              ClientMessage::SIZE_OF_FRAME_LENGTH_AND_FLAGS)) {
+                required = 0;
+                return 0;
+            }
+
+            length += static_cast<size_t>(frame_len);
+            if (length > available) {
+                required = length;
+                return 0;
+            }
+
+            if (ClientMessage::is_flag_set(frame->flags,
+                                           ClientMessage::IS_FINAL_FLAG)) {
+                return length;
+            }
+        }
+    }
+
+    void adapt_capacity(size_t bytes_read,
+                        size_t space_before_read,
+                        size_t required)
+    {
+        auto capacity = buffer_.size();
+        if (required > capacity) {
+            // let the pending message fit into the buffer
+            auto new_capacity = capacity;
+            while (new_capacity < required) {
+                new_capacity <<= 1;
+            }
+            resize((std::min)(new_capacity, MAX_BUFFER_SIZE));
+            small_reads_ = 0;
+        } else if (bytes_read == space_before_read &&
+                   capacity < MAX_BUFFER_SIZE) {
+            // the read filled the buffer, there may be more bytes waiting
+            resize((std::min)(capacity << 1, MAX_BUFFER_SIZE));
+            small_reads_ = 0;
+        } else if (capacity > initial_capacity_ && limit_ == 0 &&
+                   bytes_read < capacity / 8) {
+            if (++small_reads_ >= SHRINK_AFTER_SMALL_READS) {
+                resize((std::max)(capacity >> 1, initial_capacity_));
+                small_reads_ = 0;
+            }
+        } else {
+            small_reads_ = 0;
+        }
+
+        if (read_space() == 0) {
+            // a partial frame header of a streamed message fills the buffer
+            resize(capacity << 1);
+        }
+    }
+
+    void resize(size_t new_capacity)
+    {
+        buffer_.resize(new_capacity);
+        buffer_.shrink_to_fit();
+    }
+
+    MessageHandler& handler_;
+    std::vector<char> buffer_;
+    const size_t initial_capacity_;
+    // end of the received bytes in buffer_
+    size_t limit_{ 0 };
+    // set while a message larger than MAX_BUFFER_SIZE is being received
+    bool streaming_{ false };
+    int32_t small_reads_{ 0 };
+    protocol::ClientMessageBuilder<MessageHandler> builder_;
     std::atomic<std::chrono::steady_clock::duration> last_read_time_;
 };
+
+template<typename MessageHandler>
+constexpr size_t ReadHandler<MessageHandler>::MAX_BUFFER_SIZE;
+
+template<typename MessageHandler>
+constexpr int32_t ReadHandler<MessageHandler>::SHRINK_AFTER_SMALL_READS;
 } // namespace connection
 } // namespace client
 } // namespace hazelcast
-
-#if defined(WIN32) || defined(_WIN32) || defined(WIN64) || defined(_WIN64)
-#pragma warning(pop)
-#endif
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2008-2023, Hazelcast, Inc. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "hazelcast/util/export.h"
+
+#if defined(WIN32) || defined(_WIN32) || defined(WIN64) || defined(_WIN64)
+#pragma warning(push)
+#pragma warning(disable : 4251) // for dll export
+#endif
+
+namespace hazelcast {
+namespace client {
+namespace spi {
+namespace impl {
+class ClientInvocation;
+}
+} // namespace spi
+
+namespace connection {
+/**
+ * The in-flight invocations of a connection, indexed by the call id half of
+ * the correlation id.
+ *
+ * The table is a preallocated ring of slots: the slot of an invocation is its
+ * call id masked by the capacity. Since call ids are handed out sequentially,
+ * consecutive invocations land in consecutive slots. An insert into an
+ * occupied slot (e.g. a long living listener registration) fails and the
+ * caller moves on to the next call id. Lookups and removals never allocate;
+ * the table only grows (doubling) when it is three quarters full.
+ *
+ * The table is not synchronized. It is only accessed from within the socket
+ * strand of its connection.
+ */
+class HAZELCAST_API correlation_table
+{
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 1024;
+
+    explicit correlation_table(size_t initial_capacity = DEFAULT_CAPACITY);
+
+    /**
+     * @return false if the slot of the call id is in use, the invocation is
+     * not added in that case
+     */
+    bool insert(int64_t correlation_id,
+                std::shared_ptr<spi::impl::ClientInvocation> invocation);
+
+    /**
+     * @return the invocation registered with the correlation id or nullptr
+     */
+    const std::shared_ptr<spi::impl::ClientInvocation>* find(
+      int64_t correlation_id) const;
+
+    /**
+     * @return true if an invocation with the correlation id is removed
+     */
+    bool erase(int64_t correlation_id);
+
+    size_t size() const;
+
+    size_t capacity() const;
+
+    /**
+     * Calls f for every registered invocation. f may erase entries while
+     * iterating, but must not insert.
+     */
+    template<typename F>
+    void for_each(F f) const
+    {
+        for (size_t i = 0; i < slots_.size(); ++i) {
+            if (slots_[i].invocation) {
+                // keep the invocation alive even if f erases its slot
+                auto invocation = slots_[i].invocation;
+                f(invocation);
+            }
+        }
+    }
+
+    /**
+     * @return the call id half of a correlation id composed by the socket
+     */
+    static int32_t call_id_of(int64_t correlation_id);
+
+private:
+    struct slot
+    {
+        int64_t correlation_id;
+        std::shared_ptr<spi::impl::ClientInvocation> invocation;
+    };
+
+    size_t index_of(int64_t correlation_id) const;
+
+    void grow();
+
+    std::vector<slot> slots_;
+    size_t mask_;
+    size_t size_{ 0 };
+};
+} // namespace connection
+} // namespace client
+} // namespace hazelcast
+
+#if defined(WIN32) || defined(_WIN32) || defined(WIN64) || defined(_WIN64)
+#pragma warning(pop)
+#endif
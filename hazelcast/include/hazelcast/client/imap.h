@@ -66,6 +66,12 @@ class HAZELCAST_API imap : public proxy::IMapImpl
 public:
     static constexpr const char* SERVICE_NAME = "hz:impl:mapService";
 
+    /**
+     * Default number of entries fetched per request by iterate_entries and
+     * iterate_keys.
+     */
+    static constexpr int32_t DEFAULT_ITERATION_FETCH_SIZE = 1000;
+
     imap(const std::string& instance_name, spi::ClientContext* context)
       : proxy::IMapImpl(instance_name, context)
     {}
@@ -858,6 +864,143 @@ public:
           std::move(future), predicate);
     }
 
+    /**
+     * Same as key_set(), but the keys are deserialized only when they are
+     * accessed, see lazy_vector.
+     *
+     * @return a vector clone of the keys contained in this map
+     */
+    template<typename K>
+    boost::future<lazy_vector<K>> key_set_lazy()
+    {
+        return to_lazy_vector<K>(proxy::IMapImpl::key_set_data());
+    }
+
+    /**
+     * Same as key_set(const P&), but the keys are deserialized only when they
+     * are accessed, see lazy_vector. Paging predicates are not supported
+     * since their results are sorted on the client.
+     *
+     * @param predicate query criteria
+     * @return result key set of the query
+     */
+    template<
+      typename K,
+      typename P,
+      class = typename std::enable_if<
+        !std::is_base_of<query::paging_predicate_marker, P>::value>::type>
+    boost::future<lazy_vector<K>> key_set_lazy(const P& predicate)
+    {
+        return to_lazy_vector<K>(
+          proxy::IMapImpl::key_set_data(to_data(predicate)));
+    }
+
+    /**
+     * Same as values(), but the values are deserialized only when they are
+     * accessed, see lazy_vector.
+     *
+     * @return a vector clone of the values contained in this map
+     */
+    template<typename V>
+    boost::future<lazy_vector<V>> values_lazy()
+    {
+        return to_lazy_vector<V>(proxy::IMapImpl::values_data());
+    }
+
+    /**
+     * Same as values(const P&), but the values are deserialized only when
+     * they are accessed, see lazy_vector. Paging predicates are not supported
+     * since their results are sorted on the client.
+     *
+     * @param predicate the criteria for values to match
+     * @return a vector clone of the values contained in this map
+     */
+    template<
+      typename V,
+      typename P,
+      class = typename std::enable_if<
+        !std::is_base_of<query::paging_predicate_marker, P>::value>::type>
+    boost::future<lazy_vector<V>> values_lazy(const P& predicate)
+    {
+        return to_lazy_vector<V>(
+          proxy::IMapImpl::values_data(to_data(predicate)));
+    }
+
+    /**
+     * Same as entry_set(), but the keys and values are deserialized only when
+     * they are accessed, see lazy_entry_vector.
+     *
+     * @return a vector clone of the keys mappings in this map
+     */
+    template<typename K, typename V>
+    boost::future<lazy_entry_vector<K, V>> entry_set_lazy()
+    {
+        return to_lazy_entry_vector<K, V>(proxy::IMapImpl::entry_set_data());
+    }
+
+    /**
+     * Same as entry_set(const P&), but the keys and values are deserialized
+     * only when they are accessed, see lazy_entry_vector. Paging predicates
+     * are not supported since their results are sorted on the client.
+     *
+     * @param predicate query criteria
+     * @return result entry vector of the query
+     */
+    template<
+      typename K,
+      typename V,
+      typename P,
+      class = typename std::enable_if<
+        !std::is_base_of<query::paging_predicate_marker, P>::value>::type>
+    boost::future<lazy_entry_vector<K, V>> entry_set_lazy(const P& predicate)
+    {
+        return to_lazy_entry_vector<K, V>(
+          proxy::IMapImpl::entry_set_data(to_data(predicate)));
+    }
+
+    /**
+     * Returns an iterator which streams the entries of this map partition by
+     * partition in batches of at most fetch_size entries:
+     * <pre>
+     *   auto it = map->iterate_entries<int, std::string>(1000);
+     *   while (it.has_next()) {
+     *       for (auto& entry : it.next().get()) {
+     *           // ... use the entry
+     *       }
+     *   }
+     * </pre>
+     * Unlike entry_set(), which transfers the whole map at once, the client
+     * holds at most two batches at a time: the one being consumed and the
+     * prefetched next one.
+     *
+     * @param fetch_size the maximum number of entries fetched per request
+     * @return the iterator
+     * @throws illegal_argument if fetch_size is not positive
+     */
+    template<typename K, typename V>
+    map::entry_iterator<K, V> iterate_entries(
+      int32_t fetch_size = DEFAULT_ITERATION_FETCH_SIZE)
+    {
+        return map::entry_iterator<K, V>(
+          proxy::IMapImpl::entry_fetcher(fetch_size), serialization_service_);
+    }
+
+    /**
+     * Same as iterate_entries(int32_t), but streams only the keys of this
+     * map.
+     *
+     * @param fetch_size the maximum number of keys fetched per request
+     * @return the iterator
+     * @throws illegal_argument if fetch_size is not positive
+     */
+    template<typename K>
+    map::key_iterator<K> iterate_keys(
+      int32_t fetch_size = DEFAULT_ITERATION_FETCH_SIZE)
+    {
+        return map::key_iterator<K>(proxy::IMapImpl::key_fetcher(fetch_size),
+                                    serialization_service_);
+    }
+
     /**
      * Adds an index to this map for the specified entries so
      * that queries can run faster.
@@ -1191,10 +1334,10 @@ protected:
 
     virtual boost::future<boost::optional<serialization::pimpl::data>>
     put_internal(const serialization::pimpl::data& key_data,
-                 const serialization::pimpl::data& value_data,
+                 serialization::pimpl::data&& value_data,
                  std::chrono::milliseconds ttl)
     {
-        return proxy::IMapImpl::put_data(key_data, value_data, ttl);
+        return proxy::IMapImpl::put_data(key_data, std::move(value_data), ttl);
     }
 
     virtual boost::future<protocol::ClientMessage> try_put_transient_internal(
@@ -1230,10 +1373,10 @@ protected:
 
     virtual boost::future<protocol::ClientMessage> set_internal(
       const serialization::pimpl::data& key_data,
-      const serialization::pimpl::data& value_data,
+      serialization::pimpl::data&& value_data,
       std::chrono::milliseconds ttl)
     {
-        return proxy::IMapImpl::set(key_data, value_data, ttl);
+        return proxy::IMapImpl::set(key_data, std::move(value_data), ttl);
     }
 
     virtual boost::future<bool> evict_internal(
@@ -16,8 +16,13 @@
 
 #pragma once
 
-#include <string>
+#include <chrono>
+#include <deque>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "hazelcast/util/export.h"
 #include "hazelcast/client/spi/EventHandler.h"
@@ -61,12 +66,56 @@ public:
      */
     void on_listener_register() override {}
 
+    /**
+     * If true, the events of this handler are not posted to the event threads
+     * one by one but queued, and the queued events are delivered in batches to
+     * handle_batch, in the order they are received. At most one batch of a
+     * handler is processed at a time.
+     */
+    virtual bool coalesce_events() const { return false; }
+
+    /**
+     * Handles a batch of queued events, see coalesce_events. Handles the
+     * events one by one by default.
+     *
+     * @param first_received_at the time the first event of the batch is
+     * received
+     */
+    virtual void handle_batch(
+      const std::vector<std::shared_ptr<protocol::ClientMessage>>& events,
+      std::chrono::steady_clock::time_point first_received_at);
+
+    /**
+     * Queues the event to be handled in a batch.
+     *
+     * @return true if no batch is scheduled for this handler, the caller
+     * should then schedule draining the queue with drain_events
+     */
+    bool enqueue_event(std::shared_ptr<protocol::ClientMessage> event);
+
+    /**
+     * Removes all the queued events. If no event is queued, the scheduled
+     * drain is completed and the next enqueue_event schedules a new one.
+     *
+     * @param first_received_at set to the time the first returned event is
+     * received
+     */
+    std::vector<std::shared_ptr<protocol::ClientMessage>> drain_events(
+      std::chrono::steady_clock::time_point& first_received_at);
+
     void set_logger(logger* lg);
 
     logger* get_logger() const;
 
 protected:
     logger* logger_;
+
+private:
+    std::mutex pending_events_lock_;
+    std::deque<std::pair<std::chrono::steady_clock::time_point,
+                         std::shared_ptr<protocol::ClientMessage>>>
+      pending_events_;
+    bool drain_scheduled_{ false };
 };
 } // namespace impl
 } // namespace client
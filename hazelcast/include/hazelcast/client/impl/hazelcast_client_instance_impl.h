@@ -51,6 +51,12 @@ class AddressProvider;
 namespace internal {
 namespace nearcache {
 class NearCacheManager;
+
+namespace impl {
+namespace invalidation {
+class RepairingTask;
+} // namespace invalidation
+} // namespace impl
 } // namespace nearcache
 } // namespace internal
 
@@ -239,6 +245,8 @@ private:
     spi::ProxyManager proxy_manager_;
     std::shared_ptr<spi::impl::sequence::CallIdSequence> call_id_sequence_;
     std::unique_ptr<statistics::Statistics> statistics_;
+    std::unique_ptr<internal::nearcache::impl::invalidation::RepairingTask>
+      repairing_task_;
     protocol::ClientExceptionFactory exception_factory_;
     std::string instance_name_;
     static std::atomic<int32_t> CLIENT_ID;
@@ -254,6 +262,7 @@ private:
     cp::cp_subsystem cp_subsystem_;
     sql::sql_service sql_service_;
     cp::internal::session::proxy_session_manager proxy_session_manager_;
+    cp::internal::raft_group_leader_cache raft_group_leader_cache_;
 
     hazelcast_client_instance_impl(const hazelcast_client_instance_impl& rhs) =
       delete;
@@ -270,6 +279,12 @@ private:
 
     void initalize_near_cache_manager();
 
+    /**
+     * Creates the maps whose Near Cache pre-loader is enabled, so that their
+     * Near Caches are pre-loaded before the client is started.
+     */
+    void preload_near_caches();
+
     void check_discovery_configuration_consistency(bool address_list_provided,
                                                    bool aws_enabled,
                                                    bool cloud_enabled);
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2008-2023, Hazelcast, Inc. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "hazelcast/util/export.h"
+
+#if defined(WIN32) || defined(_WIN32) || defined(WIN64) || defined(_WIN64)
+#pragma warning(push)
+#pragma warning(disable : 4251) // for dll export
+#endif
+
+namespace hazelcast {
+namespace client {
+namespace internal {
+namespace eviction {
+namespace impl {
+namespace admission {
+/**
+ * A count-min sketch with 4 bit counters which estimates the access frequency
+ * of the keys for the TinyLFU admission policy.
+ *
+ * Each key is counted in one counter of each of the DEPTH rows and its
+ * frequency is the minimum of those counters, so that hash collisions only
+ * overestimate the frequency. Sixteen counters are packed into a word. When
+ * the number of the counted accesses reaches ten times the width of the
+ * sketch, all the counters are halved, so that the frequencies age and the
+ * keys which were popular in the past do not stay in the cache forever.
+ *
+ * The counters are updated without locks. Concurrent updates may lose an
+ * increment, which only makes the estimation slightly less accurate.
+ */
+class HAZELCAST_API FrequencySketch
+{
+public:
+    static constexpr int32_t MAX_FREQUENCY = 15;
+
+    /**
+     * @param expected_size the expected number of the records in the cache,
+     * the width of the sketch is the next power of two, bounded by MIN_WIDTH
+     * and MAX_WIDTH
+     */
+    explicit FrequencySketch(int64_t expected_size);
+
+    /**
+     * Counts an access of the key with the given hash.
+     */
+    void increment(int32_t hash);
+
+    /**
+     * @return the estimated access frequency of the key with the given hash,
+     * at most MAX_FREQUENCY
+     */
+    int32_t frequency(int32_t hash) const;
+
+    /**
+     * @return the number of the counters per row
+     */
+    size_t get_width() const;
+
+private:
+    static constexpr int DEPTH = 4;
+    static constexpr size_t MIN_WIDTH = 16;
+    static constexpr size_t MAX_WIDTH = 1 << 20;
+    static constexpr int COUNTERS_PER_WORD = 16;
+    static const uint64_t SEEDS[DEPTH];
+
+    static size_t width_for(int64_t expected_size);
+
+    std::atomic<uint64_t>& word_of(uint64_t spread_hash,
+                                   int row,
+                                   int& shift) const;
+
+    void reset();
+
+    const size_t width_;
+    const size_t words_per_row_;
+    const int64_t sample_size_;
+    std::unique_ptr<std::atomic<uint64_t>[]> table_;
+    std::atomic<int64_t> additions_;
+};
+} // namespace admission
+} // namespace impl
+} // namespace eviction
+} // namespace internal
+} // namespace client
+} // namespace hazelcast
+
+#if defined(WIN32) || defined(_WIN32) || defined(WIN64) || defined(_WIN64)
+#pragma warning(pop)
+#endif
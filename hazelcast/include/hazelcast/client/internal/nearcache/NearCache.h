@@ -19,6 +19,7 @@
 #include <assert.h>
 
 #include <memory>
+#include <vector>
 
 #include "hazelcast/client/config/in_memory_format.h"
 #include "hazelcast/util/export.h"
@@ -50,6 +51,12 @@ class DataStructureAdapter;
 }
 
 namespace nearcache {
+namespace impl {
+namespace invalidation {
+class StaleReadDetector;
+}
+} // namespace impl
+
 class HAZELCAST_API BaseNearCache
   : public spi::InitializingObject
   , public util::Clearable
@@ -157,6 +164,20 @@ public:
         return false;
     }
 
+    /**
+     * Removes the values associated with the given keys in one pass and
+     * increases the invalidation statistics.
+     *
+     * @param keys the keys of the values will be invalidated
+     * @return the number of the invalidated values
+     */
+    virtual int64_t invalidate_all(
+      const std::vector<std::shared_ptr<K>>& /* keys */)
+    {
+        assert(0);
+        return 0;
+    }
+
     /**
      * @return
      */
@@ -189,6 +210,31 @@ public:
         assert(0);
         return -1;
     }
+
+    /**
+     * Writes the keys of the Near Cache to the key file if the pre-loader is
+     * enabled, see client::config::near_cache_preloader_config.
+     */
+    virtual void store_keys() { assert(0); }
+
+    /**
+     * @return the keys of the key file to pre-load the Near Cache with, none
+     * if the pre-loader is not enabled
+     */
+    virtual std::vector<std::shared_ptr<K>> load_keys()
+    {
+        assert(0);
+        return {};
+    }
+
+    /**
+     * Sets the detector of the stale records, see RepairingHandler.
+     */
+    virtual void set_stale_read_detector(
+      std::shared_ptr<impl::invalidation::StaleReadDetector> /* detector */)
+    {
+        assert(0);
+    }
 };
 
 template class HAZELCAST_API
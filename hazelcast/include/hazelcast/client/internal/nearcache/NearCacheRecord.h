@@ -127,6 +127,16 @@ public:
      * when one of supplied or existing is null returns {@code false}
      */
     virtual bool has_same_uuid(boost::uuids::uuid /* that_uuid */) const = 0;
+
+    /**
+     * @return the partition id of the key of this record
+     */
+    virtual int32_t get_partition_id() const = 0;
+
+    /**
+     * @param partition_id the partition id of the key of this record
+     */
+    virtual void set_partition_id(int32_t /* partition_id */) = 0;
 };
 } // namespace nearcache
 } // namespace internal
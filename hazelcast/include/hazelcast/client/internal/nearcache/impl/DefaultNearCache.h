@@ -18,11 +18,14 @@
 #include <string>
 #include <memory>
 #include <thread>
+#include <vector>
 
 #include "hazelcast/util/Preconditions.h"
 #include "hazelcast/client/internal/nearcache/NearCache.h"
 #include "hazelcast/client/internal/nearcache/impl/store/NearCacheDataRecordStore.h"
 #include "hazelcast/client/internal/nearcache/impl/store/NearCacheObjectRecordStore.h"
+#include "hazelcast/client/internal/nearcache/impl/preloader/NearCachePreloader.h"
+#include "hazelcast/client/monitor/impl/NearCacheStatsImpl.h"
 #include "hazelcast/client/config/near_cache_config.h"
 #include "hazelcast/client/serialization/serialization.h"
 #include "hazelcast/client/monitor/near_cache_stats.h"
@@ -69,6 +72,7 @@ public:
         near_cache_record_store_->initialize();
 
         schedule_expiration_task();
+        create_preloader();
     }
 
     const std::string& get_name() const override { return name_; }
@@ -113,6 +117,11 @@ public:
         return near_cache_record_store_->invalidate(key);
     }
 
+    int64_t invalidate_all(const std::vector<std::shared_ptr<KS>>& keys) override
+    {
+        return near_cache_record_store_->invalidate_all(keys);
+    }
+
     bool is_invalidated_on_change() const override
     {
         return near_cache_config_.is_invalidate_on_change();
@@ -127,6 +136,10 @@ public:
             boost::system::error_code ignored;
             expiration_timer_->cancel(ignored);
         }
+        if (store_timer_) {
+            boost::system::error_code ignored;
+            store_timer_->cancel(ignored);
+        }
         near_cache_record_store_->destroy();
     }
 
@@ -150,6 +163,30 @@ public:
 
     int size() const override { return near_cache_record_store_->size(); }
 
+    void set_stale_read_detector(
+      std::shared_ptr<invalidation::StaleReadDetector> detector) override
+    {
+        near_cache_record_store_->set_stale_read_detector(std::move(detector));
+    }
+
+    void store_keys() override
+    {
+        if (preloader_) {
+            preloader_->store_keys(near_cache_record_store_->keys());
+        }
+    }
+
+    std::vector<std::shared_ptr<KS>> load_keys() override
+    {
+        std::vector<std::shared_ptr<KS>> keys;
+        if (preloader_) {
+            for (auto& key : preloader_->load_keys()) {
+                keys.push_back(std::make_shared<KS>(std::move(key)));
+            }
+        }
+        return keys;
+    }
+
 private:
     std::unique_ptr<NearCacheRecordStore<KS, V>> create_near_cache_record_store(
       const std::string& name,
@@ -213,6 +250,26 @@ private:
         }
     }
 
+    void create_preloader()
+    {
+        const auto& preloader_config = near_cache_config_.get_preloader_config();
+        if (!preloader_config.is_enabled()) {
+            return;
+        }
+
+        preloader_.reset(new preloader::NearCachePreloader(
+          name_,
+          preloader_config,
+          std::static_pointer_cast<monitor::impl::NearCacheStatsImpl>(
+            near_cache_record_store_->get_near_cache_stats()),
+          logger_));
+        store_timer_ = execution_service_->schedule_with_repetition(
+          [=]() { store_keys(); },
+          std::chrono::seconds(
+            preloader_config.get_store_initial_delay_seconds()),
+          std::chrono::seconds(preloader_config.get_store_interval_seconds()));
+    }
+
     std::string name_;
     const client::config::near_cache_config& near_cache_config_;
     std::shared_ptr<spi::impl::ClientExecutionServiceImpl> execution_service_;
@@ -222,6 +279,8 @@ private:
     std::unique_ptr<NearCacheRecordStore<KS, V>> near_cache_record_store_;
     std::atomic_bool expiration_cancelled_;
     std::shared_ptr<boost::asio::steady_timer> expiration_timer_;
+    std::unique_ptr<preloader::NearCachePreloader> preloader_;
+    std::shared_ptr<boost::asio::steady_timer> store_timer_;
 };
 } // namespace impl
 } // namespace nearcache
@@ -17,6 +17,7 @@
 
 #include <assert.h>
 #include <memory>
+#include <vector>
 
 #include "hazelcast/client/spi/InitializingObject.h"
 
@@ -40,6 +41,10 @@ class near_cache_stats;
 namespace internal {
 namespace nearcache {
 namespace impl {
+namespace invalidation {
+class StaleReadDetector;
+}
+
 /**
  * {@link NearCacheRecordStore} is the contract point to store keys and values
  * as
@@ -103,6 +108,19 @@ public:
         return false;
     }
 
+    /**
+     * Invalidates the given keys in one pass over the records, see
+     * invalidate.
+     *
+     * @return the number of the invalidated records
+     */
+    virtual int64_t invalidate_all(
+      const std::vector<std::shared_ptr<K>>& /* keys */)
+    {
+        assert(0);
+        return 0;
+    }
+
     /**
      * Removes all stored values.
      */
@@ -151,6 +169,15 @@ public:
         return -1;
     }
 
+    /**
+     * @return a copy of the keys of the stored records
+     */
+    virtual std::vector<std::shared_ptr<K>> keys() const
+    {
+        assert(0);
+        return {};
+    }
+
     /**
      * Performs expiration and evicts expired records.
      */
@@ -175,6 +202,17 @@ public:
      * Persists the key set of the Near Cache.
      */
     virtual void store_keys() { assert(0); }
+
+    /**
+     * Sets the detector which stamps the new records with the invalidation
+     * metadata and detects the stale records on reads. Without a detector
+     * the records are never stale.
+     */
+    virtual void set_stale_read_detector(
+      std::shared_ptr<invalidation::StaleReadDetector> /* detector */)
+    {
+        assert(0);
+    }
 };
 } // namespace impl
 } // namespace nearcache
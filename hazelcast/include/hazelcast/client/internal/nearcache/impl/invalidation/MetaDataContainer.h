@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2008-2023, Hazelcast, Inc. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+#include <boost/uuid/uuid.hpp>
+
+#include "hazelcast/util/export.h"
+
+#if defined(WIN32) || defined(_WIN32) || defined(WIN64) || defined(_WIN64)
+#pragma warning(push)
+#pragma warning(disable : 4251) // for dll export
+#endif
+
+namespace hazelcast {
+namespace client {
+namespace internal {
+namespace nearcache {
+namespace impl {
+namespace invalidation {
+/**
+ * Contains one partitions' invalidation metadata: the uuid of the partition,
+ * the last received invalidation sequence, the last known stale sequence and
+ * the number of sequences which are detected as missed.
+ *
+ * Records created before the stale sequence of their partition, or with a
+ * different partition uuid, are treated as stale.
+ */
+class HAZELCAST_API MetaDataContainer
+{
+public:
+    MetaDataContainer();
+
+    boost::uuids::uuid get_uuid() const;
+
+    void set_uuid(boost::uuids::uuid uuid);
+
+    /**
+     * Sets the uuid only if the current uuid is the expected one.
+     *
+     * @return true if the uuid is updated
+     */
+    bool cas_uuid(boost::uuids::uuid expected, boost::uuids::uuid uuid);
+
+    int64_t get_sequence() const;
+
+    void set_sequence(int64_t sequence);
+
+    bool cas_sequence(int64_t expected, int64_t sequence);
+
+    void reset_sequence();
+
+    int64_t get_stale_sequence() const;
+
+    bool cas_stale_sequence(int64_t expected, int64_t stale_sequence);
+
+    void reset_stale_sequence();
+
+    int64_t get_missed_sequence_count() const;
+
+    int64_t add_and_get_missed_sequence_count(int64_t missed_sequence_count);
+
+private:
+    mutable std::mutex uuid_lock_;
+    boost::uuids::uuid uuid_;
+    std::atomic<int64_t> sequence_;
+    std::atomic<int64_t> stale_sequence_;
+    std::atomic<int64_t> missed_sequence_count_;
+};
+} // namespace invalidation
+} // namespace impl
+} // namespace nearcache
+} // namespace internal
+} // namespace client
+} // namespace hazelcast
+
+#if defined(WIN32) || defined(_WIN32) || defined(WIN64) || defined(_WIN64)
+#pragma warning(pop)
+#endif
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2008-2023, Hazelcast, Inc. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <boost/optional.hpp>
+#include <boost/uuid/uuid.hpp>
+
+#include "hazelcast/client/internal/nearcache/impl/invalidation/MetaDataContainer.h"
+#include "hazelcast/client/internal/nearcache/impl/invalidation/StaleReadDetector.h"
+#include "hazelcast/util/export.h"
+
+#if defined(WIN32) || defined(_WIN32) || defined(WIN64) || defined(_WIN64)
+#pragma warning(push)
+#pragma warning(disable : 4251) // for dll export
+#endif
+
+namespace hazelcast {
+namespace client {
+namespace internal {
+namespace nearcache {
+namespace impl {
+namespace invalidation {
+/**
+ * Keeps the invalidation metadata of a Near Cache per partition and repairs it
+ * with the sequences and partition uuids carried by the invalidation events.
+ *
+ * A gap between the last received and the next sequence of a partition means
+ * that invalidation events are lost; the gap is counted as missed sequences
+ * and RepairingTask marks the records of that partition as stale once the
+ * total miss count exceeds the tolerated count. A changed partition uuid
+ * (e.g. after the partition is lost on the members) makes all the records of
+ * the partition stale immediately.
+ */
+class HAZELCAST_API RepairingHandler : public StaleReadDetector
+{
+public:
+    /**
+     * @param name the name of the Near Cache
+     * @param partition_count the partition count of the cluster
+     * @param name_partition_id the partition of the Near Cache name, map wide
+     * events (e.g. clear) are sequenced on that partition
+     */
+    RepairingHandler(std::string name,
+                     int32_t partition_count,
+                     int32_t name_partition_id);
+
+    const std::string& get_name() const;
+
+    int32_t get_partition_count() const;
+
+    /**
+     * Repairs the metadata with the sequence of a received invalidation. The
+     * invalidation itself is applied to the Near Cache by the caller.
+     *
+     * @param key the invalidated key, none for a map wide invalidation
+     */
+    void handle(const boost::optional<serialization::pimpl::data>& key,
+                boost::uuids::uuid partition_uuid,
+                int64_t sequence);
+
+    void check_or_repair_uuid(int32_t partition_id, boost::uuids::uuid uuid);
+
+    /**
+     * Moves the sequence of the partition forward and counts the skipped
+     * sequences as missed.
+     *
+     * @param via_anti_entropy true if the sequence is fetched from a member,
+     * then the next sequence itself is not received either
+     */
+    void check_or_repair_sequence(int32_t partition_id,
+                                  int64_t next_sequence,
+                                  bool via_anti_entropy = false);
+
+    /**
+     * Records with a lower sequence than the last received sequence of the
+     * partition become stale.
+     */
+    void update_last_known_stale_sequence(MetaDataContainer& meta_data);
+
+    void init_uuid(int32_t partition_id, boost::uuids::uuid uuid);
+
+    void init_sequence(int32_t partition_id, int64_t sequence);
+
+    int32_t get_partition_id(const serialization::pimpl::data& key) override;
+
+    MetaDataContainer& get_meta_data_container(int32_t partition_id) override;
+
+private:
+    const std::string name_;
+    const int32_t partition_count_;
+    const int32_t name_partition_id_;
+    std::unique_ptr<MetaDataContainer[]> meta_data_containers_;
+};
+} // namespace invalidation
+} // namespace impl
+} // namespace nearcache
+} // namespace internal
+} // namespace client
+} // namespace hazelcast
+
+#if defined(WIN32) || defined(_WIN32) || defined(WIN64) || defined(_WIN64)
+#pragma warning(pop)
+#endif
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2008-2023, Hazelcast, Inc. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/asio/steady_timer.hpp>
+#include <boost/thread/future.hpp>
+
+#include "hazelcast/client/internal/nearcache/impl/invalidation/RepairingHandler.h"
+#include "hazelcast/util/SynchronizedMap.h"
+#include "hazelcast/util/export.h"
+
+#if defined(WIN32) || defined(_WIN32) || defined(WIN64) || defined(_WIN64)
+#pragma warning(push)
+#pragma warning(disable : 4251) // for dll export
+#endif
+
+namespace hazelcast {
+class logger;
+
+namespace client {
+namespace spi {
+class ClientContext;
+}
+
+namespace protocol {
+class ClientMessage;
+}
+
+namespace internal {
+namespace nearcache {
+namespace impl {
+namespace invalidation {
+/**
+ * Runs periodically and repairs the invalidation metadata of the registered
+ * Near Caches:
+ * - when the missed sequences of a Near Cache exceed the tolerated count
+ *   (hazelcast.invalidation.max.tolerated.miss.count), the records of the
+ *   partitions with a missed sequence are made stale, so that only those
+ *   partitions are fetched from the cluster again.
+ * - every reconciliation interval
+ *   (hazelcast.invalidation.reconciliation.interval.seconds), the partition
+ *   uuids and the last sequences are fetched from the members, so that lost
+ *   invalidations are detected even if no further invalidation is received.
+ */
+class HAZELCAST_API RepairingTask
+{
+public:
+    explicit RepairingTask(spi::ClientContext& client_context);
+
+    /**
+     * Creates the handler of the Near Cache if not created yet and
+     * initializes its metadata from the members. The task is started with the
+     * first registration.
+     */
+    std::shared_ptr<RepairingHandler> register_and_get_handler(
+      const std::string& name);
+
+    void deregister_handler(const std::string& name);
+
+    void shutdown();
+
+    int64_t get_max_tolerated_miss_count() const;
+
+    std::chrono::seconds get_reconciliation_interval() const;
+
+private:
+    static constexpr std::chrono::seconds RUN_PERIOD{ 1 };
+
+    void run();
+
+    void fix_sequence_gaps();
+
+    bool is_above_max_tolerated_miss_count(RepairingHandler& handler) const;
+
+    void update_last_known_stale_sequences(RepairingHandler& handler);
+
+    bool is_anti_entropy_needed();
+
+    void run_anti_entropy();
+
+    /**
+     * Fetches the metadata of the handlers from all the data members and
+     * repairs (or initializes) the handlers with it.
+     */
+    boost::future<void> fetch_metadata(
+      const std::vector<std::shared_ptr<RepairingHandler>>& handlers,
+      bool init);
+
+    static void apply_metadata(
+      protocol::ClientMessage& response,
+      const std::vector<std::shared_ptr<RepairingHandler>>& handlers,
+      bool init);
+
+    spi::ClientContext& client_context_;
+    logger& logger_;
+    int64_t max_tolerated_miss_count_;
+    std::chrono::seconds reconciliation_interval_;
+    util::SynchronizedMap<std::string, RepairingHandler> handlers_;
+    std::atomic<bool> started_{ false };
+    std::atomic<bool> anti_entropy_in_progress_{ false };
+    std::chrono::steady_clock::time_point last_anti_entropy_run_;
+    std::shared_ptr<boost::asio::steady_timer> timer_;
+};
+} // namespace invalidation
+} // namespace impl
+} // namespace nearcache
+} // namespace internal
+} // namespace client
+} // namespace hazelcast
+
+#if defined(WIN32) || defined(_WIN32) || defined(WIN64) || defined(_WIN64)
+#pragma warning(pop)
+#endif
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2008-2023, Hazelcast, Inc. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+
+#include "hazelcast/util/export.h"
+
+namespace hazelcast {
+namespace client {
+namespace serialization {
+namespace pimpl {
+class data;
+}
+} // namespace serialization
+
+namespace internal {
+namespace nearcache {
+namespace impl {
+namespace invalidation {
+class MetaDataContainer;
+
+/**
+ * Used by the Near Cache record store to stamp the new records with the
+ * invalidation metadata of their partition and to detect the stale records
+ * on reads.
+ *
+ * @see RepairingHandler
+ */
+class HAZELCAST_API StaleReadDetector
+{
+public:
+    virtual ~StaleReadDetector() = default;
+
+    /**
+     * @return the partition id of the key
+     */
+    virtual int32_t get_partition_id(const serialization::pimpl::data& key) = 0;
+
+    /**
+     * @return the invalidation metadata of the partition
+     */
+    virtual MetaDataContainer& get_meta_data_container(int32_t partition_id) = 0;
+};
+} // namespace invalidation
+} // namespace impl
+} // namespace nearcache
+} // namespace internal
+} // namespace client
+} // namespace hazelcast
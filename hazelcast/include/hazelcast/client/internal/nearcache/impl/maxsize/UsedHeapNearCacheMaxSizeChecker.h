@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2008-2023, Hazelcast, Inc. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include "hazelcast/client/internal/eviction/MaxSizeChecker.h"
+
+#if defined(WIN32) || defined(_WIN32) || defined(WIN64) || defined(_WIN64)
+#pragma warning(push)
+#pragma warning(disable : 4251) // for dll export
+#endif
+
+namespace hazelcast {
+namespace client {
+namespace monitor {
+namespace impl {
+class NearCacheStatsImpl;
+}
+} // namespace monitor
+
+namespace internal {
+namespace nearcache {
+namespace impl {
+namespace maxsize {
+/**
+ * Near Cache max-size policy implementation for
+ * config::eviction_config::USED_HEAP_SIZE and
+ * config::eviction_config::USED_HEAP_PERCENTAGE. Checks the memory cost of the
+ * records which the record store accounts in the Near Cache statistics.
+ *
+ * @see MaxSizeChecker
+ */
+class HAZELCAST_API UsedHeapNearCacheMaxSizeChecker
+  : public eviction::MaxSizeChecker
+{
+public:
+    static constexpr int64_t ONE_MEGABYTE = 1024 * 1024;
+
+    UsedHeapNearCacheMaxSizeChecker(
+      int64_t max_size_in_bytes,
+      std::shared_ptr<monitor::impl::NearCacheStatsImpl> near_cache_stats);
+
+    bool is_reached_to_max_size() const override;
+
+    int64_t get_max_size_in_bytes() const;
+
+private:
+    const int64_t max_size_in_bytes_;
+    std::shared_ptr<monitor::impl::NearCacheStatsImpl> near_cache_stats_;
+};
+} // namespace maxsize
+} // namespace impl
+} // namespace nearcache
+} // namespace internal
+} // namespace client
+} // namespace hazelcast
+
+#if defined(WIN32) || defined(_WIN32) || defined(WIN64) || defined(_WIN64)
+#pragma warning(pop)
+#endif
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2008-2023, Hazelcast, Inc. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "hazelcast/client/config/near_cache_preloader_config.h"
+#include "hazelcast/util/export.h"
+
+#if defined(WIN32) || defined(_WIN32) || defined(WIN64) || defined(_WIN64)
+#pragma warning(push)
+#pragma warning(disable : 4251) // for dll export
+#endif
+
+namespace hazelcast {
+class logger;
+
+namespace client {
+namespace serialization {
+namespace pimpl {
+class data;
+}
+} // namespace serialization
+
+namespace monitor {
+namespace impl {
+class NearCacheStatsImpl;
+}
+} // namespace monitor
+
+namespace internal {
+namespace nearcache {
+namespace impl {
+namespace preloader {
+/**
+ * Stores the keys of a Near Cache to a file and loads them back, see
+ * client::config::near_cache_preloader_config.
+ *
+ * The file starts with a magic number and the file format version, followed
+ * by the keys as length prefixed serialized data. The keys are written one by
+ * one to a temporary file which replaces the key file when all the keys are
+ * written, so that a crash during the storage does not corrupt the previous
+ * key file. The key file is memory mapped when the keys are loaded.
+ */
+class HAZELCAST_API NearCachePreloader
+{
+public:
+    static constexpr int32_t MAGIC = 0x48434e50;
+    static constexpr int32_t FILE_FORMAT_VERSION = 1;
+
+    NearCachePreloader(
+      const std::string& near_cache_name,
+      const client::config::near_cache_preloader_config& preloader_config,
+      std::shared_ptr<monitor::impl::NearCacheStatsImpl> near_cache_stats,
+      logger& lg);
+
+    /**
+     * Replaces the key file with the given keys. The failures are logged and
+     * reported with the Near Cache statistics.
+     */
+    void store_keys(
+      const std::vector<std::shared_ptr<serialization::pimpl::data>>& keys);
+
+    /**
+     * @return the keys of the key file, none if the file does not exist or
+     * is not a valid key file
+     */
+    std::vector<serialization::pimpl::data> load_keys();
+
+    const std::string& get_store_file() const;
+
+    /**
+     * @return the name of the key file of the Near Cache, the characters
+     * which are not allowed in file names are replaced
+     */
+    static std::string get_store_file_name(const std::string& near_cache_name);
+
+private:
+    void write_keys(
+      const std::vector<std::shared_ptr<serialization::pimpl::data>>& keys,
+      int64_t& written_bytes,
+      int32_t& key_count);
+
+    const std::string near_cache_name_;
+    const std::string store_file_;
+    const std::string tmp_store_file_;
+    std::shared_ptr<monitor::impl::NearCacheStatsImpl> near_cache_stats_;
+    logger& logger_;
+    // the store task may be delayed and overlap with the next run
+    std::mutex store_lock_;
+};
+} // namespace preloader
+} // namespace impl
+} // namespace nearcache
+} // namespace internal
+} // namespace client
+} // namespace hazelcast
+
+#if defined(WIN32) || defined(_WIN32) || defined(WIN64) || defined(_WIN64)
+#pragma warning(pop)
+#endif
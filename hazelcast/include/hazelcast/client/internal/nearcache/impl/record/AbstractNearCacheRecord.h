@@ -22,6 +22,7 @@
 #include "hazelcast/util/export.h"
 
 #include "hazelcast/client/internal/nearcache/NearCacheRecord.h"
+#include <boost/uuid/nil_generator.hpp>
 #include <boost/uuid/uuid.hpp>
 
 #if defined(WIN32) || defined(_WIN32) || defined(WIN64) || defined(_WIN64)
@@ -53,6 +54,8 @@ public:
       : value_(v)
       , creation_time_(create_time)
       , sequence_(0)
+      , uuid_(boost::uuids::nil_uuid())
+      , partition_id_(-1)
       , expiration_time_(expiry_time)
       , access_time_(NearCacheRecord<V>::TIME_NOT_SET)
       , access_hit_(0)
@@ -136,11 +139,19 @@ public:
         return uuid_ == that_uuid;
     }
 
+    int32_t get_partition_id() const override { return partition_id_; }
+
+    void set_partition_id(int32_t partition_id) override
+    {
+        partition_id_ = partition_id;
+    }
+
 protected:
     std::shared_ptr<V> value_;
     int64_t creation_time_;
     int64_t sequence_;
     boost::uuids::uuid uuid_;
+    int32_t partition_id_;
 
     std::atomic<int64_t> expiration_time_;
     std::atomic<int64_t> access_time_;
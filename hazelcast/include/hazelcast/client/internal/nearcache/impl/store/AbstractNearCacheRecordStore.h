@@ -18,6 +18,7 @@
 #include <stdint.h>
 #include <memory>
 #include <cassert>
+#include <vector>
 
 #include "hazelcast/client/monitor/impl/NearCacheStatsImpl.h"
 #include "hazelcast/client/config/near_cache_config.h"
@@ -28,7 +29,10 @@
 #include "hazelcast/client/serialization/serialization.h"
 #include "hazelcast/client/internal/eviction/EvictionPolicyEvaluatorProvider.h"
 #include "hazelcast/client/internal/eviction/EvictionStrategyProvider.h"
+#include "hazelcast/client/internal/eviction/impl/admission/FrequencySketch.h"
 #include "hazelcast/client/internal/nearcache/impl/NearCacheRecordStore.h"
+#include "hazelcast/client/internal/nearcache/impl/invalidation/MetaDataContainer.h"
+#include "hazelcast/client/internal/nearcache/impl/invalidation/StaleReadDetector.h"
 #include "hazelcast/client/internal/eviction/EvictionListener.h"
 #include "hazelcast/client/internal/nearcache/impl/store/BaseHeapNearCacheRecordStore.h"
 #include "hazelcast/client/serialization/pimpl/data.h"
@@ -80,17 +84,29 @@ public:
         this->eviction_checker_ = create_eviction_checker(near_cache_config_);
         this->eviction_strategy_ = create_eviction_strategy(evictionConfig);
         this->eviction_policy_ = evictionConfig.get_eviction_policy();
+        if (evictionConfig.get_admission_policy() ==
+            client::config::eviction_config::TINY_LFU) {
+            int64_t expected_size =
+              evictionConfig.get_maximum_size_policy() ==
+                  client::config::eviction_config::ENTRY_COUNT
+                ? evictionConfig.get_size()
+                : DEFAULT_ADMISSION_EXPECTED_SIZE;
+            this->frequency_sketch_.reset(
+              new eviction::impl::admission::FrequencySketch(expected_size));
+        }
     }
 
-    /*
-                            public void setStaleReadDetector(StaleReadDetector
-       staleReadDetector) { this.staleReadDetector = staleReadDetector;
-                                }
+    void set_stale_read_detector(
+      std::shared_ptr<invalidation::StaleReadDetector> detector) override
+    {
+        std::atomic_store(&stale_read_detector_, std::move(detector));
+    }
 
-                            public StaleReadDetector getStaleReadDetector() {
-                                    return staleReadDetector;
-                                }
-    */
+    std::shared_ptr<invalidation::StaleReadDetector> get_stale_read_detector()
+      const
+    {
+        return std::atomic_load(&stale_read_detector_);
+    }
 
     // public for tests.
     virtual const std::shared_ptr<R> get_record(const std::shared_ptr<KS>& /* key */)
@@ -115,6 +131,10 @@ public:
     {
         check_available();
 
+        if (frequency_sketch_) {
+            frequency_sketch_->increment(key->hash());
+        }
+
         std::shared_ptr<R> record;
         std::shared_ptr<V> value;
         try {
@@ -125,6 +145,11 @@ public:
                     on_expire(key, record);
                     return std::shared_ptr<V>();
                 }
+                if (is_stale_read(record)) {
+                    invalidate(key);
+                    near_cache_stats_->increment_misses();
+                    return std::shared_ptr<V>();
+                }
                 on_record_access(record);
                 near_cache_stats_->increment_hits();
                 value = record_to_value(record.get());
@@ -180,6 +205,35 @@ public:
         }
     }
 
+    int64_t invalidate_all(const std::vector<std::shared_ptr<KS>>& keys) override
+    {
+        check_available();
+
+        auto records = remove_records(keys);
+        int64_t removedCount = 0;
+        for (size_t i = 0; i < keys.size(); ++i) {
+            const auto& record = records[i];
+            bool removed = false;
+            try {
+                if (record) {
+                    removed = true;
+                    ++removedCount;
+                    near_cache_stats_->decrement_owned_entry_count();
+                    near_cache_stats_->decrement_owned_entry_memory_cost(
+                      get_total_storage_memory_cost(keys[i].get(),
+                                                    record.get()));
+                    near_cache_stats_->increment_invalidations();
+                }
+                near_cache_stats_->increment_invalidation_requests();
+                on_remove(keys[i], record, removed);
+            } catch (exception::iexception& error) {
+                on_remove_error(keys[i], record, removed, error);
+                throw;
+            }
+        }
+        return removedCount;
+    }
+
     void clear() override
     {
         check_available();
@@ -204,6 +258,12 @@ public:
         return (int)records_->size();
     }
 
+    std::vector<std::shared_ptr<KS>> keys() const override
+    {
+        check_available();
+        return records_->keys();
+    }
+
     std::shared_ptr<monitor::near_cache_stats> get_near_cache_stats()
       const override
     {
@@ -214,11 +274,16 @@ public:
     void do_eviction_if_required() override
     {
         check_available();
-        if (is_eviction_enabled()) {
-            eviction_strategy_->evict(records_.get(),
-                                      eviction_policy_evaluator_.get(),
-                                      eviction_checker_.get(),
-                                      this);
+        // with an admission policy the victims are chosen when a record is
+        // put, so that the new record can be rejected instead
+        if (is_eviction_enabled() && !frequency_sketch_) {
+            // evicting one record may not be enough for the memory based
+            // max-size policies, evict until the max-size is not reached
+            while (eviction_strategy_->evict(records_.get(),
+                                             eviction_policy_evaluator_.get(),
+                                             eviction_checker_.get(),
+                                             this) > 0) {
+            }
         }
     }
 
@@ -298,6 +363,23 @@ protected:
         return std::shared_ptr<R>();
     }
 
+    /**
+     * Removes the records of the keys, at once if the record map supports it.
+     *
+     * @return the removed records in the order of the keys, null for a key
+     * without a record
+     */
+    virtual std::vector<std::shared_ptr<R>> remove_records(
+      const std::vector<std::shared_ptr<KS>>& keys)
+    {
+        std::vector<std::shared_ptr<R>> records;
+        records.reserve(keys.size());
+        for (const auto& key : keys) {
+            records.push_back(remove_record(key));
+        }
+        return records;
+    }
+
     virtual bool contains_record_key(const std::shared_ptr<KS>& /* key */) const
     {
         assert(0);
@@ -425,10 +507,37 @@ protected:
         }
     }
 
-    void on_record_create(const std::shared_ptr<KS>&/* key */,
+    /**
+     * A record is stale if its partition uuid changed or if an invalidation
+     * of its partition is lost after the record is created.
+     */
+    bool is_stale_read(const std::shared_ptr<R>& record) const
+    {
+        auto detector = get_stale_read_detector();
+        if (!detector) {
+            return false;
+        }
+
+        auto& meta_data =
+          detector->get_meta_data_container(record->get_partition_id());
+        return !record->has_same_uuid(meta_data.get_uuid()) ||
+               record->get_invalidation_sequence() <
+                 meta_data.get_stale_sequence();
+    }
+
+    void on_record_create(const std::shared_ptr<KS>& key,
                           const std::shared_ptr<R>& record)
     {
         record->set_creation_time(util::current_time_millis());
+
+        auto detector = get_stale_read_detector();
+        if (detector) {
+            auto partition_id = detector->get_partition_id(*key);
+            auto& meta_data = detector->get_meta_data_container(partition_id);
+            record->set_partition_id(partition_id);
+            record->set_invalidation_sequence(meta_data.get_sequence());
+            record->set_uuid(meta_data.get_uuid());
+        }
     }
 
     void on_record_access(const std::shared_ptr<R>& record)
@@ -525,11 +634,10 @@ MEM.arrayIndexScale(Object[].class) : (Integer.SIZE / Byte.SIZE);
       eviction_strategy_;
     ::hazelcast::client::config::eviction_policy eviction_policy_;
     std::unique_ptr<NCRM> records_;
+    std::shared_ptr<invalidation::StaleReadDetector> stale_read_detector_;
+    std::unique_ptr<eviction::impl::admission::FrequencySketch>
+      frequency_sketch_;
 
-    /*
-                                volatile StaleReadDetector staleReadDetector =
-       ALWAYS_FRESH;
-    */
 private:
     class MaxSizeEvictionChecker : public eviction::EvictionChecker
     {
@@ -563,6 +671,12 @@ private:
             return;
         }
 
+        if (frequency_sketch_ && is_eviction_enabled() &&
+            !contains_record_key(key) && !admit(key)) {
+            near_cache_stats_->increment_admission_rejections();
+            return;
+        }
+
         std::shared_ptr<R> record;
         std::shared_ptr<R> oldRecord;
         try {
@@ -579,7 +693,46 @@ private:
         }
     }
 
+    /**
+     * TinyLFU admission: while the Near Cache is full, the new key is compared
+     * with the victim which the eviction policy chooses from a sample of the
+     * records. The victim is evicted only if the new key is accessed more
+     * frequently, otherwise the new key is not cached. Hence a scan of keys
+     * which are accessed once does not flush the frequently accessed records.
+     *
+     * @return true if the new key should be put
+     */
+    bool admit(const std::shared_ptr<KS>& key)
+    {
+        int32_t candidate_frequency = frequency_sketch_->frequency(key->hash());
+        while (eviction_checker_->is_eviction_required()) {
+            auto samples = records_->sample(ADMISSION_SAMPLE_COUNT);
+            if (!samples) {
+                return true;
+            }
+            auto victims = eviction_policy_evaluator_->evaluate(*samples);
+            if (!victims || victims->empty()) {
+                return true;
+            }
+            const auto& victim = (*victims)[0];
+            // expired records are always replaced
+            if (!victim->get_evictable()->is_expired_at(
+                  util::current_time_millis()) &&
+                candidate_frequency <=
+                  frequency_sketch_->frequency(
+                    victim->get_accessor()->hash())) {
+                return false;
+            }
+            if (records_->evict(victims.get(), this) == 0) {
+                return true;
+            }
+        }
+        return true;
+    }
+
     static const int MILLI_SECONDS_IN_A_SECOND = 1000;
+    static const int32_t ADMISSION_SAMPLE_COUNT = 15;
+    static const int64_t DEFAULT_ADMISSION_EXPECTED_SIZE = 1 << 16;
 };
 } // namespace store
 } // namespace impl
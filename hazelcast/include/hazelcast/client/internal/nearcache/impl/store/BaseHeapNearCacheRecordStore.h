@@ -20,6 +20,7 @@
 #include "hazelcast/client/internal/nearcache/impl/store/HeapNearCacheRecordMap.h"
 #include "hazelcast/client/internal/nearcache/impl/store/AbstractNearCacheRecordStore.h"
 #include "hazelcast/client/internal/nearcache/impl/maxsize/EntryCountNearCacheMaxSizeChecker.h"
+#include "hazelcast/client/internal/nearcache/impl/maxsize/UsedHeapNearCacheMaxSizeChecker.h"
 
 #if defined(WIN32) || defined(_WIN32) || defined(WIN64) || defined(_WIN64)
 #pragma warning(push)
@@ -99,16 +100,35 @@ protected:
     {
         typename client::config::eviction_config::max_size_policy
           maxSizePolicy = eviction_config.get_maximum_size_policy();
-        if (maxSizePolicy == client::config::eviction_config::ENTRY_COUNT) {
-            return std::unique_ptr<eviction::MaxSizeChecker>(
-              new maxsize::EntryCountNearCacheMaxSizeChecker<K, V, KS, R>(
-                eviction_config.get_size(), *ANCRS::records_));
+        switch (maxSizePolicy) {
+            case client::config::eviction_config::ENTRY_COUNT:
+                return std::unique_ptr<eviction::MaxSizeChecker>(
+                  new maxsize::EntryCountNearCacheMaxSizeChecker<K, V, KS, R>(
+                    eviction_config.get_size(), *ANCRS::records_));
+            case client::config::eviction_config::USED_HEAP_SIZE:
+                return std::unique_ptr<eviction::MaxSizeChecker>(
+                  new maxsize::UsedHeapNearCacheMaxSizeChecker(
+                    eviction_config.get_size() *
+                      maxsize::UsedHeapNearCacheMaxSizeChecker::ONE_MEGABYTE,
+                    ANCRS::near_cache_stats_));
+            case client::config::eviction_config::USED_HEAP_PERCENTAGE:
+                if (eviction_config.get_heap_budget_megabytes() > 0 &&
+                    eviction_config.get_size() <= 100) {
+                    return std::unique_ptr<eviction::MaxSizeChecker>(
+                      new maxsize::UsedHeapNearCacheMaxSizeChecker(
+                        eviction_config.get_heap_budget_megabytes() *
+                          maxsize::UsedHeapNearCacheMaxSizeChecker::
+                            ONE_MEGABYTE *
+                          eviction_config.get_size() / 100,
+                        ANCRS::near_cache_stats_));
+                }
+                break;
         }
         std::ostringstream out;
         out << "Invalid max-size policy " << '(' << (int)maxSizePolicy
-            << ") for " << near_cache_config.get_name() << "! Only "
-            << (int)client::config::eviction_config::ENTRY_COUNT
-            << " is supported.";
+            << ") for " << near_cache_config.get_name() << "! "
+            << (int)client::config::eviction_config::USED_HEAP_PERCENTAGE
+            << " requires a heap budget and a size between 1 and 100.";
         BOOST_THROW_EXCEPTION(exception::illegal_argument(out.str()));
     }
 
@@ -139,11 +159,41 @@ protected:
         return ANCRS::records_->remove(key);
     }
 
+    std::vector<std::shared_ptr<R>> remove_records(
+      const std::vector<std::shared_ptr<KS>>& keys) override
+    {
+        return ANCRS::records_->remove_all(keys);
+    }
+
     bool contains_record_key(const std::shared_ptr<KS>& key) const override
     {
         return ANCRS::records_->contains_key(key);
     }
 
+    /**
+     * @return the heap memory used by the serialized data, including its
+     * buffer
+     */
+    static int64_t get_data_memory_cost(const serialization::pimpl::data* data)
+    {
+        return data != NULL
+                 ? static_cast<int64_t>(sizeof(serialization::pimpl::data) +
+                                        data->total_size())
+                 : 0;
+    }
+
+    int64_t get_key_storage_memory_cost(KS* key) const override
+    {
+        return
+          // reference to this key inside the record map
+          REFERENCE_SIZE
+          // the key data itself
+          + get_data_memory_cost(key);
+    }
+
+    static const int64_t REFERENCE_SIZE =
+      sizeof(std::shared_ptr<serialization::pimpl::data>);
+
     static const int32_t DEFAULT_INITIAL_CAPACITY = 1000;
 };
 } // namespace store
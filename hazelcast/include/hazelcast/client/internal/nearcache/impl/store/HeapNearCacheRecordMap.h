@@ -131,7 +131,7 @@ public:
              it != eviction_candidates->end();
              ++it) {
             const std::shared_ptr<C>& evictionCandidate = *it;
-            if (util::SynchronizedMap<std::shared_ptr<KS>, R>::remove(
+            if (util::SampleableConcurrentHashMap<K, V, KS, R>::remove(
                   evictionCandidate->get_accessor())
                   .get() != NULL) {
                 actualEvictedCount++;
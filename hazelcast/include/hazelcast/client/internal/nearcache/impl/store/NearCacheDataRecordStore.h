@@ -46,9 +46,6 @@ public:
       HeapNearCacheRecordMap<K, V, KS, record::NearCacheDataRecord>>
       ANCRS;
 
-    static const int64_t REFERENCE_SIZE =
-      sizeof(std::shared_ptr<serialization::pimpl::data>);
-
     NearCacheDataRecordStore(const std::string& name,
                              const client::config::near_cache_config& config,
                              serialization::pimpl::SerializationService& ss)
@@ -61,14 +58,11 @@ public:
     {}
 
 protected:
-    int64_t get_key_storage_memory_cost(KS* key) const override
-    {
-        return
-          // reference to this key data inside map ("store" field)
-          REFERENCE_SIZE
-          // cost of this key data
-          + (key != NULL ? key->total_size() : 0);
-    }
+    typedef BaseHeapNearCacheRecordStore<K,
+                                         V,
+                                         KS,
+                                         record::NearCacheDataRecord>
+      BHNCRS;
 
     int64_t get_record_storage_memory_cost(
       record::NearCacheDataRecord* record) const override
@@ -76,22 +70,13 @@ protected:
         if (record == NULL) {
             return 0L;
         }
-        std::shared_ptr<serialization::pimpl::data> value = record->get_value();
         return
-          // reference to this record inside map ("store" field)
-          REFERENCE_SIZE
-          // reference to "value" field
-          + REFERENCE_SIZE
-          // heap cost of this value data
-          + (value.get() != NULL ? (int64_t)value->total_size() : 0)
-          // 3 primitive int64_t typed fields: "creationTime", "expirationTime"
-          // and "accessTime"
-          + (3 * (sizeof(std::atomic<int64_t>)))
-          // reference to "accessHit" field
-          + REFERENCE_SIZE
-          // primitive int typed "value" field in "AtomicInteger" typed
-          // "accessHit" field
-          + (sizeof(std::atomic<int32_t>));
+          // reference to this record inside the record map
+          BHNCRS::REFERENCE_SIZE
+          // the record with its time, hit and invalidation fields
+          + sizeof(record::NearCacheDataRecord)
+          // the value data
+          + BHNCRS::get_data_memory_cost(record->get_value().get());
     }
 
     std::unique_ptr<record::NearCacheDataRecord> value_to_record(
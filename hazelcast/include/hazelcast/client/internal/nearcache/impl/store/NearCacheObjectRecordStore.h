@@ -58,19 +58,25 @@ public:
     {}
 
 protected:
-    int64_t get_key_storage_memory_cost(KS* /* key */) const override
-    {
-        // memory cost for "OBJECT" in memory format is totally not supported,
-        // so just return zero
-        return 0L;
-    }
+    typedef BaseHeapNearCacheRecordStore<K,
+                                         V,
+                                         KS,
+                                         record::NearCacheObjectRecord<V>>
+      BHNCRS;
 
     int64_t get_record_storage_memory_cost(
-      record::NearCacheObjectRecord<V>* /* record */) const override
+      record::NearCacheObjectRecord<V>* record) const override
     {
-        // memory cost for "OBJECT" in memory format is totally not supported,
-        // so just return zero
-        return 0L;
+        if (record == NULL) {
+            return 0L;
+        }
+        return
+          // reference to this record inside the record map
+          BHNCRS::REFERENCE_SIZE
+          // the record with its time, hit and invalidation fields
+          + sizeof(record::NearCacheObjectRecord<V>)
+          // the value object
+          + get_value_memory_cost(record->get_value().get());
     }
 
     //@Override
@@ -108,6 +114,28 @@ protected:
     }
 
 private:
+    static int64_t get_value_memory_cost(const serialization::pimpl::data* value)
+    {
+        return BHNCRS::get_data_memory_cost(value);
+    }
+
+    static int64_t get_value_memory_cost(const typed_data* value)
+    {
+        return value != NULL ? static_cast<int64_t>(sizeof(typed_data)) +
+                                 BHNCRS::get_data_memory_cost(&value->get_data())
+                             : 0;
+    }
+
+    /**
+     * The heap memory owned by a deserialized object is not known, only the
+     * object itself is accounted.
+     */
+    template<typename T>
+    static int64_t get_value_memory_cost(const T* value)
+    {
+        return value != NULL ? static_cast<int64_t>(sizeof(T)) : 0;
+    }
+
     std::unique_ptr<record::NearCacheObjectRecord<V>> value_to_record_internal(
       const std::shared_ptr<V>& value)
     {
@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include <algorithm>
 #include <unordered_map>
 #include <deque>
 
@@ -130,13 +131,15 @@ public:
             outbox_entry.buffers.reserve(datas.size());
             for (const auto& data : datas) {
                 outbox_entry.buffers.emplace_back(boost::asio::buffer(data));
+                outbox_entry.bytes += data.size();
             }
             outbox_entry.message = std::move(message);
             outbox_entry.invocation = std::move(invocation);
             this->outbox_.push_back(std::move(outbox_entry));
 
             if (this->outbox_.size() > 1) {
-                // async write is in progress
+                // async write is in progress, the entry is picked up by the
+                // next batch once it completes
                 return;
             }
 
@@ -222,8 +225,8 @@ protected:
     void do_read(const std::shared_ptr<connection::Connection> connection)
     {
         socket_.async_read_some(
-          boost::asio::buffer(connection->read_handler.byte_buffer.ix(),
-                              connection->read_handler.byte_buffer.remaining()),
+          boost::asio::buffer(connection->read_handler.read_position(),
+                              connection->read_handler.read_space()),
           socket_strand_.wrap(
             [=](const boost::system::error_code& ec, std::size_t bytes_read) {
                 if (ec) {
@@ -237,28 +240,57 @@ protected:
                     return;
                 }
 
-                connection->read_handler.byte_buffer.safe_increment_position(
-                  bytes_read);
-
-                connection->read_handler.handle();
+                connection->read_handler.handle(bytes_read);
 
                 do_read(connection);
             }));
     }
 
+    /**
+     * Drains as many queued outbox entries as the configured batch limits
+     * allow into a single gather write. The entries stay at the front of the
+     * outbox until the write completes, so a non-empty outbox means that a
+     * write is in progress. At least one entry is always written, even if it
+     * exceeds the limits by itself.
+     */
     void do_write(const std::shared_ptr<connection::Connection> connection)
     {
+        const auto max_bytes = static_cast<std::size_t>(
+          (std::max)(socket_options_.get_max_write_batch_size_in_bytes(), 0));
+        const auto max_buffers = static_cast<std::size_t>(
+          (std::max)(socket_options_.get_max_write_batch_buffers(), 0));
+
+        write_buffers_.clear();
+        std::size_t batch_bytes = 0;
+        std::size_t batch_size = 0;
+        for (const auto& outbox_entry : outbox_) {
+            if (batch_size > 0 &&
+                (batch_bytes + outbox_entry.bytes > max_bytes ||
+                 write_buffers_.size() + outbox_entry.buffers.size() >
+                   max_buffers)) {
+                break;
+            }
+
+            write_buffers_.insert(write_buffers_.end(),
+                                  outbox_entry.buffers.begin(),
+                                  outbox_entry.buffers.end());
+            batch_bytes += outbox_entry.bytes;
+            ++batch_size;
+        }
+
         auto handler =
-          [connection, this](const boost::system::error_code& ec,
-                             std::size_t /* bytes_written */) {
+          [connection, batch_size, this](const boost::system::error_code& ec,
+                                         std::size_t /* bytes_written */) {
               auto invocation = std::move(outbox_[0].invocation);
-              this->outbox_.pop_front();
+              this->outbox_.erase(this->outbox_.begin(),
+                                  this->outbox_.begin() + batch_size);
 
               if (ec) {
                   auto message =
                     (boost::format{ "Error %1% during invocation write for %2% "
-                                    "on connection %3%" } %
-                     ec % *invocation % *connection)
+                                    "(batch of %3% messages) on connection "
+                                    "%4%" } %
+                     ec % *invocation % batch_size % *connection)
                       .str();
                   connection->close(message);
               } else {
@@ -271,9 +303,8 @@ protected:
               }
           };
 
-        const auto& message = outbox_[0].buffers;
         boost::asio::async_write(
-          socket_, message, socket_strand_.wrap(handler));
+          socket_, write_buffers_, socket_strand_.wrap(handler));
     }
 
     virtual void post_connect() {}
@@ -323,9 +354,7 @@ protected:
         int64_t message_call_id;
         do {
             message_call_id = generate_new_call_id(connection);
-        } while (
-          !connection->invocations.insert({ message_call_id, invocation })
-             .second);
+        } while (!connection->invocations.insert(message_call_id, invocation));
 
         message->set_correlation_id(message_call_id);
     }
@@ -341,12 +370,15 @@ protected:
     struct entry
     {
         std::vector<boost::asio::const_buffer> buffers;
+        std::size_t bytes{ 0 };
         std::shared_ptr<spi::impl::ClientInvocation> invocation;
         std::shared_ptr<protocol::ClientMessage> message;
     };
 
     typedef std::deque<entry> Outbox;
     Outbox outbox_;
+    // gather list of the write in progress, reused between flushes
+    std::vector<boost::asio::const_buffer> write_buffers_;
 };
 } // namespace socket
 } // namespace internal
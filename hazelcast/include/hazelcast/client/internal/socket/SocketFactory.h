@@ -15,7 +15,9 @@
  */
 #pragma once
 
+#include <atomic>
 #include <memory>
+#include <vector>
 
 #include "hazelcast/util/export.h"
 
@@ -45,8 +47,12 @@ namespace socket {
 class HAZELCAST_API SocketFactory
 {
 public:
+    /**
+     * @param io_contexts the io_contexts to distribute the sockets over, each
+     * new socket is bound to the next one in round-robin order
+     */
     SocketFactory(spi::ClientContext& client_context,
-                  boost::asio::io_context& io,
+                  std::vector<boost::asio::io_context*> io_contexts,
                   boost::asio::ip::tcp::resolver& resolver);
 
     bool start();
@@ -57,7 +63,8 @@ public:
 
 private:
     spi::ClientContext& client_context_;
-    boost::asio::io_context& io_;
+    std::vector<boost::asio::io_context*> io_contexts_;
+    std::atomic<size_t> next_io_context_{ 0 };
     boost::asio::ip::tcp::resolver& io_resolver_;
 #ifdef HZ_BUILD_WITH_SSL
     std::shared_ptr<boost::asio::ssl::context> ssl_context_;
@@ -0,0 +1,346 @@
+/*
+ * Copyright (c) 2008-2023, Hazelcast, Inc. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "hazelcast/client/serialization/serialization.h"
+
+#if defined(WIN32) || defined(_WIN32) || defined(WIN64) || defined(_WIN64)
+#pragma warning(push)
+#pragma warning(disable : 4251) // for dll export
+#endif
+
+namespace hazelcast {
+namespace client {
+/**
+ * A query result which keeps the serialized elements as received from the
+ * cluster and deserializes an element only when it is accessed for the first
+ * time. The deserialized element is cached, later accesses return the same
+ * object. Until the elements are accessed, the memory use is close to the
+ * size of the serialized data.
+ *
+ * The result is not synchronized: it must not be accessed by multiple threads
+ * concurrently. It must not outlive the client that produced it.
+ *
+ * @tparam T the type of the elements
+ */
+template<typename T>
+class lazy_vector
+{
+public:
+    class const_iterator
+    {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const T* pointer;
+        typedef const T& reference;
+
+        const_iterator(const lazy_vector* owner, size_t index)
+          : owner_(owner)
+          , index_(index)
+        {}
+
+        reference operator*() const { return (*owner_)[index_]; }
+
+        pointer operator->() const { return &(*owner_)[index_]; }
+
+        const_iterator& operator++()
+        {
+            ++index_;
+            return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+            const_iterator previous(*this);
+            ++index_;
+            return previous;
+        }
+
+        bool operator==(const const_iterator& rhs) const
+        {
+            return owner_ == rhs.owner_ && index_ == rhs.index_;
+        }
+
+        bool operator!=(const const_iterator& rhs) const
+        {
+            return !(*this == rhs);
+        }
+
+    private:
+        const lazy_vector* owner_;
+        size_t index_;
+    };
+
+    lazy_vector(std::vector<serialization::pimpl::data> data,
+                serialization::pimpl::SerializationService& serialization_service)
+      : data_(std::move(data))
+      , objects_(data_.size())
+      , serialization_service_(&serialization_service)
+    {}
+
+    size_t size() const { return data_.size(); }
+
+    bool empty() const { return data_.empty(); }
+
+    /**
+     * @return the element at the index, deserialized on first access
+     */
+    const T& operator[](size_t index) const
+    {
+        auto& object = objects_[index];
+        if (!object) {
+            // the elements of query results are never null
+            object.reset(new T(std::move(
+              serialization_service_->to_object<T>(data_[index]).value())));
+        }
+        return *object;
+    }
+
+    /**
+     * @throws std::out_of_range if the index is not less than size()
+     */
+    const T& at(size_t index) const
+    {
+        if (index >= data_.size()) {
+            throw std::out_of_range("lazy_vector::at");
+        }
+        return (*this)[index];
+    }
+
+    /**
+     * @return true if the element at the index is already deserialized
+     */
+    bool is_deserialized(size_t index) const
+    {
+        return static_cast<bool>(objects_[index]);
+    }
+
+    /**
+     * @return the serialized form of the element at the index
+     */
+    const serialization::pimpl::data& get_data(size_t index) const
+    {
+        return data_[index];
+    }
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+
+    const_iterator end() const { return const_iterator(this, data_.size()); }
+
+    /**
+     * Deserializes all the elements which are not accessed yet.
+     *
+     * @return the elements in order
+     */
+    std::vector<T> to_vector() const
+    {
+        std::vector<T> result;
+        result.reserve(data_.size());
+        for (size_t i = 0; i < data_.size(); ++i) {
+            result.push_back((*this)[i]);
+        }
+        return result;
+    }
+
+private:
+    std::vector<serialization::pimpl::data> data_;
+    mutable std::vector<std::unique_ptr<T>> objects_;
+    serialization::pimpl::SerializationService* serialization_service_;
+};
+
+/**
+ * The entry counterpart of lazy_vector: keys and values are deserialized
+ * separately on their first access, so that e.g. scanning the keys does not
+ * deserialize any value.
+ *
+ * The result is not synchronized: it must not be accessed by multiple threads
+ * concurrently. It must not outlive the client that produced it.
+ *
+ * @tparam K the type of the keys
+ * @tparam V the type of the values
+ */
+template<typename K, typename V>
+class lazy_entry_vector
+{
+public:
+    typedef std::vector<
+      std::pair<serialization::pimpl::data, serialization::pimpl::data>>
+      data_entries;
+
+    class const_iterator
+    {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef std::pair<const K&, const V&> value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef void pointer;
+        typedef value_type reference;
+
+        const_iterator(const lazy_entry_vector* owner, size_t index)
+          : owner_(owner)
+          , index_(index)
+        {}
+
+        /**
+         * @return the entry at the iterator position, both its key and value
+         * are deserialized
+         */
+        reference operator*() const
+        {
+            return reference(owner_->key(index_), owner_->value(index_));
+        }
+
+        const_iterator& operator++()
+        {
+            ++index_;
+            return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+            const_iterator previous(*this);
+            ++index_;
+            return previous;
+        }
+
+        bool operator==(const const_iterator& rhs) const
+        {
+            return owner_ == rhs.owner_ && index_ == rhs.index_;
+        }
+
+        bool operator!=(const const_iterator& rhs) const
+        {
+            return !(*this == rhs);
+        }
+
+    private:
+        const lazy_entry_vector* owner_;
+        size_t index_;
+    };
+
+    lazy_entry_vector(
+      data_entries entries,
+      serialization::pimpl::SerializationService& serialization_service)
+      : entries_(std::move(entries))
+      , keys_(entries_.size())
+      , values_(entries_.size())
+      , serialization_service_(&serialization_service)
+    {}
+
+    size_t size() const { return entries_.size(); }
+
+    bool empty() const { return entries_.empty(); }
+
+    /**
+     * @return the key of the entry at the index, deserialized on first access
+     */
+    const K& key(size_t index) const
+    {
+        return get(keys_, entries_[index].first, index);
+    }
+
+    /**
+     * @return the value of the entry at the index, deserialized on first
+     * access
+     */
+    const V& value(size_t index) const
+    {
+        return get(values_, entries_[index].second, index);
+    }
+
+    /**
+     * @return true if the key of the entry at the index is already
+     * deserialized
+     */
+    bool is_key_deserialized(size_t index) const
+    {
+        return static_cast<bool>(keys_[index]);
+    }
+
+    /**
+     * @return true if the value of the entry at the index is already
+     * deserialized
+     */
+    bool is_value_deserialized(size_t index) const
+    {
+        return static_cast<bool>(values_[index]);
+    }
+
+    /**
+     * @return the serialized key and value of the entry at the index
+     */
+    const std::pair<serialization::pimpl::data, serialization::pimpl::data>&
+    get_data(size_t index) const
+    {
+        return entries_[index];
+    }
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+
+    const_iterator end() const
+    {
+        return const_iterator(this, entries_.size());
+    }
+
+    /**
+     * Deserializes all the keys and values which are not accessed yet.
+     *
+     * @return the entries in order
+     */
+    std::vector<std::pair<K, V>> to_vector() const
+    {
+        std::vector<std::pair<K, V>> result;
+        result.reserve(entries_.size());
+        for (size_t i = 0; i < entries_.size(); ++i) {
+            result.emplace_back(key(i), value(i));
+        }
+        return result;
+    }
+
+private:
+    template<typename T>
+    const T& get(std::vector<std::unique_ptr<T>>& objects,
+                 const serialization::pimpl::data& data,
+                 size_t index) const
+    {
+        auto& object = objects[index];
+        if (!object) {
+            // the keys and values of query results are never null
+            object.reset(new T(
+              std::move(serialization_service_->to_object<T>(data).value())));
+        }
+        return *object;
+    }
+
+    data_entries entries_;
+    mutable std::vector<std::unique_ptr<K>> keys_;
+    mutable std::vector<std::unique_ptr<V>> values_;
+    serialization::pimpl::SerializationService* serialization_service_;
+};
+} // namespace client
+} // namespace hazelcast
+
+#if defined(WIN32) || defined(_WIN32) || defined(WIN64) || defined(_WIN64)
+#pragma warning(pop)
+#endif
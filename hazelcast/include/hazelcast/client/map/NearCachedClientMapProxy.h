@@ -15,15 +15,21 @@
  */
 #pragma once
 
+#include <algorithm>
+#include <chrono>
 #include <memory>
+#include <unordered_map>
+#include <vector>
 
 #include "hazelcast/client/imap.h"
 #include "hazelcast/client/client_config.h"
 #include "hazelcast/client/config/near_cache_config.h"
 #include "hazelcast/client/map/impl/nearcache/InvalidationAwareWrapper.h"
 #include "hazelcast/client/internal/nearcache/impl/KeyStateMarkerImpl.h"
+#include "hazelcast/client/internal/nearcache/impl/invalidation/RepairingTask.h"
 #include "hazelcast/client/internal/nearcache/NearCacheManager.h"
 #include "hazelcast/client/internal/nearcache/NearCache.h"
+#include "hazelcast/client/monitor/impl/NearCacheStatsImpl.h"
 #include "hazelcast/client/protocol/codec/codecs.h"
 #include "hazelcast/client/protocol/codec/codecs.h"
 #include "hazelcast/client/spi/ClientContext.h"
@@ -93,19 +99,28 @@ protected:
 
         invalidate_on_change_ = near_cache_->is_invalidated_on_change();
         if (invalidate_on_change_) {
+            repairing_handler_ =
+              this->get_context().get_repairing_task().register_and_get_handler(
+                spi::ClientProxy::get_name());
+            near_cache_->set_stale_read_detector(repairing_handler_);
+
             std::shared_ptr<client::impl::BaseEventHandler> invalidationHandler(
-              new ClientMapAddNearCacheEventHandler(near_cache_));
+              new ClientMapAddNearCacheEventHandler(near_cache_,
+                                                    repairing_handler_));
             add_near_cache_invalidate_listener(invalidationHandler);
         }
 
         local_map_stats_ =
           monitor::impl::LocalMapStatsImpl(near_cache_->get_near_cache_stats());
+
+        preload_near_cache();
     }
 
     void post_destroy() override
     {
         try {
             remove_near_cache_invalidation_listener();
+            deregister_repairing_handler();
             spi::ClientProxy::get_context()
               .get_near_cache_manager()
               .destroy_near_cache(spi::ClientProxy::get_name());
@@ -118,6 +133,7 @@ protected:
     void on_destroy() override
     {
         remove_near_cache_invalidation_listener();
+        deregister_repairing_handler();
         spi::ClientProxy::get_context()
           .get_near_cache_manager()
           .destroy_near_cache(spi::ClientProxy::get_name());
@@ -261,11 +277,12 @@ protected:
 
     boost::future<boost::optional<serialization::pimpl::data>> put_internal(
       const serialization::pimpl::data& key_data,
-      const serialization::pimpl::data& value_data,
+      serialization::pimpl::data&& value_data,
       std::chrono::milliseconds ttl) override
     {
         try {
-            auto previousValue = imap::put_internal(key_data, value_data, ttl);
+            auto previousValue =
+              imap::put_internal(key_data, std::move(value_data), ttl);
             invalidate_near_cache(key_data);
             return previousValue;
         } catch (exception::iexception&) {
@@ -338,11 +355,12 @@ protected:
 
     boost::future<protocol::ClientMessage> set_internal(
       const serialization::pimpl::data& key_data,
-      const serialization::pimpl::data& value_data,
+      serialization::pimpl::data&& value_data,
       std::chrono::milliseconds ttl) override
     {
         try {
-            auto result = proxy::IMapImpl::set(key_data, value_data, ttl);
+            auto result =
+              proxy::IMapImpl::set(key_data, std::move(value_data), ttl);
             invalidate_near_cache(key_data);
             return result;
         } catch (exception::iexception&) {
@@ -465,6 +483,68 @@ protected:
     }
 
 private:
+    static constexpr size_t PRELOAD_BATCH_SIZE = 100;
+
+    /**
+     * Fills the Near Cache with the values of the keys stored by the
+     * pre-loader. The keys are grouped by partition and fetched with
+     * get_all_internal in batches of PRELOAD_BATCH_SIZE keys.
+     */
+    void preload_near_cache()
+    {
+        auto keys = near_cache_->load_keys();
+        if (keys.empty()) {
+            return;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        auto& partition_service = this->get_context().get_partition_service();
+        std::unordered_map<int32_t, std::vector<serialization::pimpl::data>>
+          partition_keys;
+        for (auto& key : keys) {
+            auto partition_id = partition_service.get_partition_id(*key);
+            partition_keys[partition_id].push_back(std::move(*key));
+        }
+
+        std::vector<boost::future<EntryVector>> futures;
+        for (auto& entry : partition_keys) {
+            auto& batch_keys = entry.second;
+            for (size_t i = 0; i < batch_keys.size(); i += PRELOAD_BATCH_SIZE) {
+                auto end = std::min(batch_keys.size(), i + PRELOAD_BATCH_SIZE);
+                futures.push_back(get_all_internal(
+                  entry.first,
+                  std::vector<serialization::pimpl::data>(
+                    batch_keys.begin() + i, batch_keys.begin() + end)));
+            }
+        }
+
+        size_t failed_batches = 0;
+        for (auto& f : futures) {
+            try {
+                f.get();
+            } catch (exception::iexception& e) {
+                ++failed_batches;
+                HZ_LOG(logger_,
+                       finest,
+                       boost::str(boost::format("Cannot pre-load a batch of "
+                                                "Near Cache %1%. %2%") %
+                                  spi::ClientProxy::get_name() % e.what()));
+            }
+        }
+
+        HZ_LOG(
+          logger_,
+          info,
+          boost::str(
+            boost::format("Pre-loaded %1% keys of Near Cache %2% in %3% ms, "
+                          "%4% of %5% batches failed") %
+            keys.size() % spi::ClientProxy::get_name() %
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+              std::chrono::steady_clock::now() - start)
+              .count() %
+            failed_batches % futures.size()));
+    }
+
     impl::nearcache::KeyStateMarker* get_key_state_marker()
     {
         return std::static_pointer_cast<
@@ -500,34 +580,89 @@ private:
         proxy::ProxyImpl::deregister_listener(invalidation_listener_id_).get();
     }
 
+    void deregister_repairing_handler()
+    {
+        if (!repairing_handler_) {
+            return;
+        }
+
+        spi::ClientProxy::get_context().get_repairing_task().deregister_handler(
+          spi::ClientProxy::get_name());
+    }
+
+    /**
+     * Invalidation events are coalesced, see BaseEventHandler::coalesce_events,
+     * so that the invalidations received during bulk writes are applied in one
+     * pass over the records per batch instead of one event task per key.
+     */
     class ClientMapAddNearCacheEventHandler
       : public protocol::codec::map_addnearcacheinvalidationlistener_handler
     {
     public:
-        // TODO: implement RepairingTask as in Java client
         ClientMapAddNearCacheEventHandler(
           const std::shared_ptr<
             internal::nearcache::NearCache<serialization::pimpl::data, V>>&
-            cache)
+            cache,
+          std::shared_ptr<
+            internal::nearcache::impl::invalidation::RepairingHandler>
+            repairing_handler)
           : near_cache_(cache)
+          , repairing_handler_(std::move(repairing_handler))
+          , near_cache_stats_(
+              std::static_pointer_cast<monitor::impl::NearCacheStatsImpl>(
+                cache->get_near_cache_stats()))
         {}
 
         void before_listener_register() override { near_cache_->clear(); }
 
         void on_listener_register() override { near_cache_->clear(); }
 
+        bool coalesce_events() const override { return true; }
+
+        void handle(protocol::ClientMessage& event) override
+        {
+            protocol::codec::map_addnearcacheinvalidationlistener_handler::
+              handle(event);
+            invalidate_pending_keys();
+        }
+
+        void handle_batch(
+          const std::vector<std::shared_ptr<protocol::ClientMessage>>& events,
+          std::chrono::steady_clock::time_point first_received_at) override
+        {
+            try {
+                for (const auto& event : events) {
+                    protocol::codec::
+                      map_addnearcacheinvalidationlistener_handler::handle(
+                        *event);
+                }
+            } catch (...) {
+                invalidate_pending_keys();
+                throw;
+            }
+
+            auto keyCount = invalidate_pending_keys();
+            near_cache_stats_->add_invalidation_batch(
+              keyCount,
+              std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - first_received_at)
+                .count());
+        }
+
         void handle_imapinvalidation(
           const boost::optional<serialization::pimpl::data>& key,
           boost::uuids::uuid /* source_uuid */,
-          boost::uuids::uuid /* partition_uuid */,
-          int64_t /* sequence */) override
+          boost::uuids::uuid partition_uuid,
+          int64_t sequence) override
         {
+            repairing_handler_->handle(key, partition_uuid, sequence);
             // null key means Near Cache has to remove all entries in it (see
             // MapAddNearCacheEntryListenerMessageTask)
             if (!key) {
+                pending_keys_.clear();
                 near_cache_->clear();
             } else {
-                near_cache_->invalidate(
+                pending_keys_.push_back(
                   std::make_shared<serialization::pimpl::data>(*key));
             }
         }
@@ -535,19 +670,43 @@ private:
         void handle_imapbatchinvalidation(
           const std::vector<serialization::pimpl::data>& keys,
           const std::vector<boost::uuids::uuid>& /* source_uuids */,
-          const std::vector<boost::uuids::uuid>& /* partition_uuids */,
-          const std::vector<int64_t>& /* sequences */) override
+          const std::vector<boost::uuids::uuid>& partition_uuids,
+          const std::vector<int64_t>& sequences) override
         {
-            for (auto& k : keys) {
-                near_cache_->invalidate(
-                  std::make_shared<serialization::pimpl::data>(k));
+            for (size_t i = 0; i < keys.size(); ++i) {
+                repairing_handler_->handle(
+                  keys[i], partition_uuids[i], sequences[i]);
+                pending_keys_.push_back(
+                  std::make_shared<serialization::pimpl::data>(keys[i]));
             }
         }
 
     private:
+        /**
+         * Removes the keys collected from the decoded events at once.
+         *
+         * @return the number of the keys
+         */
+        int64_t invalidate_pending_keys()
+        {
+            auto keyCount = static_cast<int64_t>(pending_keys_.size());
+            if (keyCount > 0) {
+                std::vector<std::shared_ptr<serialization::pimpl::data>> keys;
+                keys.swap(pending_keys_);
+                near_cache_->invalidate_all(keys);
+            }
+            return keyCount;
+        }
+
         std::shared_ptr<
           internal::nearcache::NearCache<serialization::pimpl::data, V>>
           near_cache_;
+        std::shared_ptr<
+          internal::nearcache::impl::invalidation::RepairingHandler>
+          repairing_handler_;
+        std::shared_ptr<monitor::impl::NearCacheStatsImpl> near_cache_stats_;
+        // events are handled by one event thread at a time
+        std::vector<std::shared_ptr<serialization::pimpl::data>> pending_keys_;
     };
 
     class NearCacheEntryListenerMessageCodec
@@ -663,9 +822,14 @@ private:
     std::shared_ptr<
       internal::nearcache::NearCache<serialization::pimpl::data, V>>
       near_cache_;
+    std::shared_ptr<internal::nearcache::impl::invalidation::RepairingHandler>
+      repairing_handler_;
     boost::uuids::uuid invalidation_listener_id_;
     logger& logger_;
 };
+
+template<typename K, typename V>
+constexpr size_t NearCachedClientMapProxy<K, V>::PRELOAD_BATCH_SIZE;
 } // namespace map
 } // namespace client
 } // namespace hazelcast
@@ -92,6 +92,14 @@ public:
         return near_cache_->invalidate(key);
     }
 
+    int64_t invalidate_all(const std::vector<std::shared_ptr<K>>& keys) override
+    {
+        for (const auto& key : keys) {
+            key_state_marker_->try_remove(*key);
+        }
+        return near_cache_->invalidate_all(keys);
+    }
+
     bool is_invalidated_on_change() const override
     {
         return near_cache_->is_invalidated_on_change();
@@ -122,6 +130,20 @@ public:
 
     int size() const override { return near_cache_->size(); }
 
+    void store_keys() override { near_cache_->store_keys(); }
+
+    std::vector<std::shared_ptr<K>> load_keys() override
+    {
+        return near_cache_->load_keys();
+    }
+
+    void set_stale_read_detector(
+      std::shared_ptr<internal::nearcache::impl::invalidation::StaleReadDetector>
+        detector) override
+    {
+        near_cache_->set_stale_read_detector(std::move(detector));
+    }
+
     KeyStateMarker* get_key_state_marker() { return key_state_marker_.get(); }
 
 private:
@@ -0,0 +1,261 @@
+/*
+ * Copyright (c) 2008-2023, Hazelcast, Inc. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <functional>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <boost/optional.hpp>
+#include <boost/thread/future.hpp>
+
+#include "hazelcast/client/serialization/serialization.h"
+
+#if defined(WIN32) || defined(_WIN32) || defined(WIN64) || defined(_WIN64)
+#pragma warning(push)
+#pragma warning(disable : 4251) // for dll export
+#endif
+
+namespace hazelcast {
+namespace client {
+namespace map {
+namespace impl {
+/**
+ * The (index, size) pairs by which a member resumes the iteration of a
+ * partition.
+ */
+typedef std::vector<std::pair<int32_t, int32_t>> iteration_pointers;
+
+/**
+ * Walks the partitions of a map one by one, fetching at most fetch_size items
+ * of a partition per request. The next batch is requested as soon as the
+ * current one arrives, so that it is transferred while the current batch is
+ * consumed. Hence, at most two batches are held in memory at any time.
+ *
+ * @tparam D the serialized batch type, the keys or the entries
+ */
+template<typename D>
+class partition_fetcher
+  : public std::enable_shared_from_this<partition_fetcher<D>>
+{
+public:
+    typedef std::pair<iteration_pointers, D> fetch_result;
+    typedef std::function<boost::future<fetch_result>(int32_t,
+                                                      const iteration_pointers&,
+                                                      int32_t)>
+      fetch_function;
+
+    partition_fetcher(int32_t partition_count,
+                      int32_t fetch_size,
+                      fetch_function fetch)
+      : partition_count_(partition_count)
+      , fetch_size_(fetch_size)
+      , fetch_(std::move(fetch))
+      , partition_id_(0)
+      , pointers_(initial_pointers())
+      , finished_(partition_count <= 0)
+    {}
+
+    bool has_next() const { return !finished_; }
+
+    /**
+     * @return the next non empty batch, or an empty batch if there are no
+     * more items
+     */
+    boost::future<D> next()
+    {
+        if (finished_) {
+            return boost::make_ready_future(D());
+        }
+
+        boost::future<fetch_result> fetched;
+        if (prefetched_) {
+            fetched = std::move(*prefetched_);
+            prefetched_.reset();
+        } else {
+            fetched = fetch_(partition_id_, pointers_, fetch_size_);
+        }
+
+        auto self = this->shared_from_this();
+        return fetched
+          .then(boost::launch::sync,
+                [self](boost::future<fetch_result> f) {
+                    return self->on_fetched(f.get());
+                })
+          .unwrap();
+    }
+
+private:
+    static iteration_pointers initial_pointers()
+    {
+        return { { (std::numeric_limits<int32_t>::max)(), -1 } };
+    }
+
+    boost::future<D> on_fetched(fetch_result result)
+    {
+        if (result.first.empty() || result.first.back().first < 0) {
+            // the partition is exhausted
+            pointers_ = initial_pointers();
+            finished_ = ++partition_id_ >= partition_count_;
+        } else {
+            pointers_ = std::move(result.first);
+        }
+
+        if (finished_) {
+            return boost::make_ready_future(std::move(result.second));
+        }
+
+        // prefetch while the caller consumes this batch
+        prefetched_ = fetch_(partition_id_, pointers_, fetch_size_);
+        if (result.second.empty()) {
+            return next();
+        }
+        return boost::make_ready_future(std::move(result.second));
+    }
+
+    const int32_t partition_count_;
+    const int32_t fetch_size_;
+    fetch_function fetch_;
+    int32_t partition_id_;
+    iteration_pointers pointers_;
+    bool finished_;
+    boost::optional<boost::future<fetch_result>> prefetched_;
+};
+} // namespace impl
+
+/**
+ * Iterates the entries of a map partition by partition, in batches of a
+ * configured size, see imap::iterate_entries. Only the current batch and the
+ * prefetched next batch are held in memory, so that maps larger than the
+ * client memory can be scanned.
+ *
+ * The iteration is not a snapshot: entries updated during the iteration may
+ * or may not be returned, each entry is returned at most once as long as the
+ * cluster is stable.
+ *
+ * This class is NOT thread-safe, the future returned by next() must be
+ * completed before next() or has_next() is called again.
+ *
+ * @tparam K the type of the keys
+ * @tparam V the type of the values
+ */
+template<typename K, typename V>
+class entry_iterator
+{
+public:
+    typedef std::vector<
+      std::pair<serialization::pimpl::data, serialization::pimpl::data>>
+      data_entries;
+
+    entry_iterator(
+      std::shared_ptr<impl::partition_fetcher<data_entries>> fetcher,
+      serialization::pimpl::SerializationService& serialization_service)
+      : fetcher_(std::move(fetcher))
+      , serialization_service_(&serialization_service)
+    {}
+
+    /**
+     * @return false if all the partitions are iterated. If true, next() may
+     * still return an empty batch when the remaining partitions are empty.
+     */
+    bool has_next() const { return fetcher_->has_next(); }
+
+    /**
+     * @return the next batch of entries
+     */
+    boost::future<std::vector<std::pair<K, V>>> next()
+    {
+        auto serialization_service = serialization_service_;
+        return fetcher_->next().then(
+          boost::launch::sync,
+          [serialization_service](boost::future<data_entries> f) {
+              auto entries = f.get();
+              std::vector<std::pair<K, V>> result;
+              result.reserve(entries.size());
+              for (const auto& e : entries) {
+                  result.emplace_back(
+                    serialization_service->to_object<K>(e.first).value(),
+                    serialization_service->to_object<V>(e.second).value());
+              }
+              return result;
+          });
+    }
+
+private:
+    std::shared_ptr<impl::partition_fetcher<data_entries>> fetcher_;
+    serialization::pimpl::SerializationService* serialization_service_;
+};
+
+/**
+ * The key counterpart of entry_iterator, see imap::iterate_keys.
+ *
+ * @tparam K the type of the keys
+ */
+template<typename K>
+class key_iterator
+{
+public:
+    key_iterator(
+      std::shared_ptr<
+        impl::partition_fetcher<std::vector<serialization::pimpl::data>>>
+        fetcher,
+      serialization::pimpl::SerializationService& serialization_service)
+      : fetcher_(std::move(fetcher))
+      , serialization_service_(&serialization_service)
+    {}
+
+    /**
+     * @return false if all the partitions are iterated. If true, next() may
+     * still return an empty batch when the remaining partitions are empty.
+     */
+    bool has_next() const { return fetcher_->has_next(); }
+
+    /**
+     * @return the next batch of keys
+     */
+    boost::future<std::vector<K>> next()
+    {
+        auto serialization_service = serialization_service_;
+        return fetcher_->next().then(
+          boost::launch::sync,
+          [serialization_service](
+            boost::future<std::vector<serialization::pimpl::data>> f) {
+              auto keys = f.get();
+              std::vector<K> result;
+              result.reserve(keys.size());
+              for (const auto& k : keys) {
+                  result.push_back(
+                    serialization_service->to_object<K>(k).value());
+              }
+              return result;
+          });
+    }
+
+private:
+    std::shared_ptr<
+      impl::partition_fetcher<std::vector<serialization::pimpl::data>>>
+      fetcher_;
+    serialization::pimpl::SerializationService* serialization_service_;
+};
+} // namespace map
+} // namespace client
+} // namespace hazelcast
+
+#if defined(WIN32) || defined(_WIN32) || defined(WIN64) || defined(_WIN64)
+#pragma warning(pop)
+#endif
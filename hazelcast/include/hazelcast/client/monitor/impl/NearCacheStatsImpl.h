@@ -75,6 +75,15 @@ public:
 
     void increment_evictions();
 
+    /**
+     * @return the number of the new records which are not admitted to the
+     * Near Cache by the admission policy, see
+     * config::eviction_config::admission_policy
+     */
+    int64_t get_admission_rejections();
+
+    void increment_admission_rejections();
+
     int64_t get_expirations() override;
 
     void increment_expirations();
@@ -89,12 +98,33 @@ public:
 
     void reset_invalidation_events();
 
+    /**
+     * Records a batch of invalidation events applied at once.
+     *
+     * @param key_count the number of the invalidated keys in the batch
+     * @param lag the time in milliseconds from the receipt of the first event
+     * of the batch until the batch is applied
+     */
+    void add_invalidation_batch(int64_t key_count, int64_t lag);
+
+    int64_t get_invalidation_batches();
+
+    int64_t get_invalidation_batch_keys();
+
+    int64_t get_max_invalidation_batch_size();
+
+    int64_t get_total_invalidation_lag();
+
+    int64_t get_max_invalidation_lag();
+
     int64_t get_persistence_count() override;
 
     void add_persistence(int64_t duration,
                          int32_t written_bytes,
                          int32_t key_count);
 
+    void add_persistence_failure(const std::string& failure);
+
     int64_t get_last_persistence_time() override;
 
     int64_t get_last_persistence_duration() override;
@@ -114,10 +144,16 @@ private:
     std::atomic<int64_t> hits_;
     std::atomic<int64_t> misses_;
     std::atomic<int64_t> evictions_;
+    std::atomic<int64_t> admission_rejections_;
     std::atomic<int64_t> expirations_;
 
     std::atomic<int64_t> invalidations_;
     std::atomic<int64_t> invalidation_requests_;
+    std::atomic<int64_t> invalidation_batches_;
+    std::atomic<int64_t> invalidation_batch_keys_;
+    std::atomic<int64_t> max_invalidation_batch_size_;
+    std::atomic<int64_t> total_invalidation_lag_;
+    std::atomic<int64_t> max_invalidation_lag_;
 
     std::atomic<int64_t> persistence_count_;
     std::atomic<int64_t> last_persistence_time_;
@@ -127,6 +163,8 @@ private:
     util::Sync<std::string> last_persistence_failure_;
 
     static const double PERCENTAGE;
+
+    static void update_max(std::atomic<int64_t>& max, int64_t value);
 };
 } // namespace impl
 } // namespace monitor
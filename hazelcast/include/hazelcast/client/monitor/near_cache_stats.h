@@ -60,7 +60,8 @@ public:
 
     /**
      * Returns memory cost (number of bytes) of Near Cache entries owned by this
-     * member.
+     * member. This is the heap memory which the USED_HEAP_SIZE and
+     * USED_HEAP_PERCENTAGE max-size policies are checked against.
      *
      * @return memory cost (number of bytes) of Near Cache entries owned by this
      * member.
@@ -43,6 +43,7 @@
 #include "hazelcast/client/map/data_entry_view.h"
 #include "hazelcast/client/member.h"
 #include "hazelcast/client/protocol/codec/ErrorCodec.h"
+#include "hazelcast/client/protocol/frame_buffer_pool.h"
 #include "hazelcast/client/query/paging_predicate.h"
 #include "hazelcast/client/serialization/pimpl/data.h"
 #include "hazelcast/client/sql/impl/query_id.h"
@@ -271,6 +272,16 @@ public:
     explicit ClientMessage(size_t initial_frame_size,
                            bool is_fingle_frame = false);
 
+    ClientMessage(const ClientMessage&) = default;
+    ClientMessage(ClientMessage&&) = default;
+    ClientMessage& operator=(const ClientMessage&) = default;
+    ClientMessage& operator=(ClientMessage&&) = default;
+
+    /**
+     * Gives the frame blocks back to the frame_buffer_pool.
+     */
+    ~ClientMessage();
+
     const std::vector<std::vector<byte>>& get_buffer() const
     {
         return data_buffer_;
@@ -293,9 +304,9 @@ public:
         }
         if (max_available_bytes < bytes_to_reserve) {
             // add a new buffer enough size to hold the minimum requested bytes
-            data_buffer_.emplace_back();
+            data_buffer_.emplace_back(frame_buffer_pool::instance().acquire(
+              (std::max)(EXPECTED_DATA_BLOCK_SIZE, bytes_to_reserve)));
             b = data_buffer_.rbegin();
-            b->reserve((std::max)(EXPECTED_DATA_BLOCK_SIZE, bytes_to_reserve));
         }
 
         auto position = b->size();
@@ -1288,6 +1299,41 @@ public:
         contains_serialized_data_in_request_ = true;
     }
 
+    /**
+     * Writes the serialized value as a data frame, taking over its buffer.
+     * If the bytes do not fit into the current block, the buffer itself
+     * becomes the next block of the message instead of being copied, so
+     * large values are never copied on the encode path.
+     */
+    inline void set(serialization::pimpl::data&& value, bool is_final = false)
+    {
+        auto data_size = value.total_size();
+        auto b = data_buffer_.rbegin();
+        if (value.data_size() == 0 ||
+            (b != data_buffer_.rend() &&
+             b->capacity() - b->size() >=
+               sizeof(frame_header_type) + data_size)) {
+            set(static_cast<const serialization::pimpl::data&>(value),
+                is_final);
+            return;
+        }
+
+        auto* header =
+          reinterpret_cast<frame_header_type*>(wr_ptr(sizeof(frame_header_type)));
+        header->frame_len = sizeof(frame_header_type) + data_size;
+        header->flags = is_final ? IS_FINAL_FLAG : DEFAULT_FLAGS;
+
+        const auto& replicated_schemas = value.schemas_will_be_replicated();
+
+        copy(begin(replicated_schemas),
+             end(replicated_schemas),
+             back_inserter(schemas_will_be_replicated_));
+
+        data_buffer_.emplace_back(value.release_byte_array());
+
+        contains_serialized_data_in_request_ = true;
+    }
+
     inline void set(const serialization::pimpl::data* value,
                     bool is_final = false)
     {
@@ -1600,6 +1646,11 @@ ClientMessage::set(
   const std::vector<std::pair<boost::uuids::uuid, int64_t>>& values,
   bool is_final);
 
+template<>
+void HAZELCAST_API
+ClientMessage::set(const std::vector<std::pair<int32_t, int32_t>>& values,
+                   bool is_final);
+
 } // namespace protocol
 } // namespace client
 } // namespace hazelcast
@@ -54,38 +54,44 @@ public:
             isCompleted = is_final_frame_ && remaining_frame_bytes_ == 0;
             if (isCompleted) {
                 // MESSAGE IS COMPLETE HERE
-                message_->wrap_for_read();
-                isCompleted = true;
-
-                if (message_->is_flag_set(
-                      ClientMessage::UNFRAGMENTED_MESSAGE)) {
-                    // MESSAGE IS COMPLETE HERE
-                    message_handler_.handle_client_message(std::move(message_));
-                } else {
-                    message_->rd_ptr(ClientMessage::FRAGMENTATION_ID_OFFSET);
-                    auto fragmentation_id = message_->get<int64_t>();
-                    auto flags = message_->get_header_flags();
-                    message_->drop_fragmentation_frame();
-                    if (ClientMessage::is_flag_set(
-                          flags, ClientMessage::BEGIN_FRAGMENT_FLAG)) {
-                        // put the message into the partial messages list
-                        add_to_partial_messages(fragmentation_id, message_);
-                    } else {
-                        // This is the intermediate frame. Append at the
-                        // previous message buffer
-                        append_existing_partial_message(
-                          fragmentation_id,
-                          message_,
-                          ClientMessage::is_flag_set(
-                            flags, ClientMessage::END_FRAGMENT_FLAG));
-                    }
-                }
+                on_message(std::move(message_));
             }
         }
 
         return isCompleted;
     }
 
+    /**
+     * Dispatches a message whose frames are all received. The fragments of a
+     * fragmented message are collected until its last fragment is received.
+     */
+    void on_message(std::unique_ptr<ClientMessage> message)
+    {
+        message->wrap_for_read();
+
+        if (message->is_flag_set(ClientMessage::UNFRAGMENTED_MESSAGE)) {
+            message_handler_.handle_client_message(std::move(message));
+        } else {
+            message->rd_ptr(ClientMessage::FRAGMENTATION_ID_OFFSET);
+            auto fragmentation_id = message->get<int64_t>();
+            auto flags = message->get_header_flags();
+            message->drop_fragmentation_frame();
+            if (ClientMessage::is_flag_set(
+                  flags, ClientMessage::BEGIN_FRAGMENT_FLAG)) {
+                // put the message into the partial messages list
+                add_to_partial_messages(fragmentation_id, message);
+            } else {
+                // This is the intermediate frame. Append at the
+                // previous message buffer
+                append_existing_partial_message(
+                  fragmentation_id,
+                  message,
+                  ClientMessage::is_flag_set(flags,
+                                             ClientMessage::END_FRAGMENT_FLAG));
+            }
+        }
+    }
+
 private:
     void add_to_partial_messages(int64_t fragmentation_id,
                                  std::unique_ptr<ClientMessage>& message)
@@ -38,22 +38,7 @@ public:
       std::shared_ptr<sql::sql_row_metadata> row_metadata = nullptr);
 
 private:
-    template<typename T>
-    static std::vector<boost::any> to_vector_of_any(
-      std::vector<boost::optional<T>> values)
-    {
-        auto size = values.size();
-        std::vector<boost::any> vector_of_any(size);
-        for (std::size_t i = 0; i < size; ++i) {
-            auto& value = values[i];
-            if (value) {
-                vector_of_any[i] = std::move(*value);
-            }
-        }
-        return vector_of_any;
-    }
-
-    static std::vector<boost::any> decode_column_values(
+    static sql::sql_page::column decode_column_values(
       ClientMessage& msg,
       sql::sql_column_type column_type);
 };
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2008-2023, Hazelcast, Inc. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include "hazelcast/util/byte.h"
+#include "hazelcast/util/export.h"
+
+#if defined(WIN32) || defined(_WIN32) || defined(WIN64) || defined(_WIN64)
+#pragma warning(push)
+#pragma warning(disable : 4251) // for dll export
+#endif
+
+namespace hazelcast {
+namespace client {
+namespace protocol {
+/**
+ * Size classed pool of the byte blocks which hold the frames of a
+ * ClientMessage. A request or response block is taken from the pool when the
+ * message grows and given back when the message is destroyed, i.e. after the
+ * outbox entry is written and the invocation is completed.
+ *
+ * Each size class is guarded by its own mutex and keeps a bounded number of
+ * free blocks. Blocks larger than the largest class are neither pooled nor
+ * kept.
+ */
+class HAZELCAST_API frame_buffer_pool
+{
+public:
+    static constexpr size_t SIZE_CLASS_COUNT = 4;
+
+    /**
+     * @return the process wide pool shared by all client messages
+     */
+    static frame_buffer_pool& instance();
+
+    /**
+     * @param min_capacity the minimum number of bytes the block should hold
+     * @return an empty block whose capacity is at least min_capacity
+     */
+    std::vector<byte> acquire(size_t min_capacity);
+
+    /**
+     * Gives the block back to the pool. The block is dropped if its size
+     * class is full or it does not fit any size class.
+     */
+    void release(std::vector<byte>&& buffer);
+
+    /**
+     * @return the number of acquisitions served from a pooled block
+     */
+    int64_t hits() const;
+
+    /**
+     * @return the number of acquisitions which needed a new allocation
+     */
+    int64_t misses() const;
+
+    /**
+     * @return the number of blocks currently kept in the pool
+     */
+    int64_t pooled_count() const;
+
+private:
+    struct size_class
+    {
+        size_t buffer_size;
+        size_t max_pooled;
+        mutable std::mutex mutex;
+        std::vector<std::vector<byte>> free_buffers;
+    };
+
+    frame_buffer_pool();
+
+    size_class classes_[SIZE_CLASS_COUNT];
+    std::atomic<int64_t> hits_{ 0 };
+    std::atomic<int64_t> misses_{ 0 };
+};
+} // namespace protocol
+} // namespace client
+} // namespace hazelcast
+
+#if defined(WIN32) || defined(_WIN32) || defined(WIN64) || defined(_WIN64)
+#pragma warning(pop)
+#endif
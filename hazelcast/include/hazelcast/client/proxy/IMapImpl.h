@@ -21,6 +21,7 @@
 #include "hazelcast/util/Util.h"
 #include "hazelcast/client/proxy/ProxyImpl.h"
 #include "hazelcast/client/map/data_entry_view.h"
+#include "hazelcast/client/map/partition_iterator.h"
 #include "hazelcast/client/protocol/codec/codecs.h"
 
 #if defined(WIN32) || defined(_WIN32) || defined(WIN64) || defined(_WIN64)
@@ -137,6 +138,11 @@ protected:
       const serialization::pimpl::data& value,
       std::chrono::milliseconds ttl);
 
+    boost::future<boost::optional<serialization::pimpl::data>> put_data(
+      const serialization::pimpl::data& key,
+      serialization::pimpl::data&& value,
+      std::chrono::milliseconds ttl);
+
     boost::future<protocol::ClientMessage> put_transient(
       const serialization::pimpl::data& key,
       const serialization::pimpl::data& value,
@@ -160,6 +166,11 @@ protected:
       const serialization::pimpl::data& value,
       std::chrono::milliseconds ttl);
 
+    boost::future<protocol::ClientMessage> set(
+      const serialization::pimpl::data& key,
+      serialization::pimpl::data&& value,
+      std::chrono::milliseconds ttl);
+
     boost::future<protocol::ClientMessage> lock(
       const serialization::pimpl::data& key);
 
@@ -221,6 +232,21 @@ protected:
     key_set_for_paging_predicate_data(
       protocol::codec::holder::paging_predicate_holder const& predicate);
 
+    /**
+     * @return a fetcher which iterates the entries partition by partition,
+     * fetch_size entries per request
+     */
+    std::shared_ptr<map::impl::partition_fetcher<EntryVector>> entry_fetcher(
+      int32_t fetch_size);
+
+    /**
+     * @return a fetcher which iterates the keys partition by partition,
+     * fetch_size keys per request
+     */
+    std::shared_ptr<
+      map::impl::partition_fetcher<std::vector<serialization::pimpl::data>>>
+    key_fetcher(int32_t fetch_size);
+
     boost::future<EntryVector> entry_set_data();
 
     boost::future<EntryVector> entry_set_data(
@@ -15,12 +15,17 @@
  */
 #pragma once
 
+#include <atomic>
+#include <functional>
+#include <iterator>
+#include <memory>
 #include <unordered_map>
 #include <boost/thread/future.hpp>
 
 #include "hazelcast/client/serialization/serialization.h"
 #include "hazelcast/client/protocol/ClientMessage.h"
 #include "hazelcast/client/entry_view.h"
+#include "hazelcast/client/lazy_result.h"
 
 #if defined(WIN32) || defined(_WIN32) || defined(WIN64) || defined(_WIN64)
 #pragma warning(push)
@@ -56,6 +61,23 @@ public:
                                    [](boost::future<T> f) { f.get(); });
     }
 
+    /**
+     * Overrides the client wide
+     * client_properties::INVOCATION_INLINE_COMPLETION setting for the
+     * invocations of this proxy. When enabled, the futures returned by this
+     * proxy are completed on the I/O thread which receives the response, hence
+     * the continuations attached to them must not block.
+     *
+     * @param inline_completion true to complete the futures on the I/O thread
+     */
+    void set_inline_completion(bool inline_completion);
+
+    /**
+     * @return true if the futures of this proxy are completed on the I/O
+     * thread
+     */
+    bool is_inline_completion() const;
+
 protected:
     SerializingProxy(spi::ClientContext& context,
                      const std::string& object_name);
@@ -93,23 +115,102 @@ protected:
         return to_data<T>(&object);
     }
 
+    /**
+     * @return the number of chunks a bulk result of count entries is
+     * deserialized in, see client_properties::DESERIALIZATION_CHUNK_SIZE
+     */
+    size_t deserialization_chunk_count(size_t count) const;
+
+    /**
+     * Runs convert_chunk(chunk_index, begin, end) for every chunk of the
+     * index range [0, count). All but the last chunk are run on the user
+     * executor, the last one is run on the calling thread.
+     *
+     * @return a future completed when all the chunks are converted, with the
+     * first exception thrown by a chunk, if any
+     */
+    boost::future<void> run_chunked(
+      size_t count,
+      std::function<void(size_t, size_t, size_t)> convert_chunk);
+
+    /**
+     * Converts the items [0, count) by calling convert(index) for each of
+     * them, in parallel chunks if the count is large enough.
+     *
+     * @return the converted items in index order
+     */
+    template<typename T, typename Convert>
+    boost::future<std::vector<T>> convert_chunked(size_t count,
+                                                  Convert convert)
+    {
+        auto chunk_count = deserialization_chunk_count(count);
+        if (chunk_count <= 1) {
+            std::vector<T> result;
+            result.reserve(count);
+            for (size_t i = 0; i < count; ++i) {
+                result.push_back(convert(i));
+            }
+            return boost::make_ready_future(std::move(result));
+        }
+
+        auto chunks = std::make_shared<std::vector<std::vector<T>>>(chunk_count);
+        return run_chunked(
+                 count,
+                 [chunks, convert](size_t chunk, size_t begin, size_t end) {
+                     auto& items = (*chunks)[chunk];
+                     items.reserve(end - begin);
+                     for (size_t i = begin; i < end; ++i) {
+                         items.push_back(convert(i));
+                     }
+                 })
+          .then(boost::launch::sync, [chunks, count](boost::future<void> f) {
+              f.get();
+              std::vector<T> result;
+              result.reserve(count);
+              for (auto& items : *chunks) {
+                  result.insert(result.end(),
+                                std::make_move_iterator(items.begin()),
+                                std::make_move_iterator(items.end()));
+              }
+              return result;
+          });
+    }
+
+    /**
+     * Deserializes the entries of each partition as soon as its response
+     * arrives, the final map is presized with the total entry count.
+     */
     template<typename K, typename V>
     inline boost::future<std::unordered_map<K, V>> to_object_map(
       std::vector<boost::future<EntryVector>>& futures)
     {
-        return boost::when_all(futures.begin(), futures.end())
+        std::vector<boost::future<std::vector<std::pair<K, V>>>> converted;
+        converted.reserve(futures.size());
+        for (auto& f : futures) {
+            // it is guaranteed that all values are non-null
+            converted.push_back(to_entry_object_vector<K, V>(std::move(f)));
+        }
+
+        return boost::when_all(converted.begin(), converted.end())
           .then(boost::launch::sync,
-                [this](
-                  boost::future<boost::csbl::vector<boost::future<EntryVector>>>
-                    results_data) {
+                [](boost::future<boost::csbl::vector<
+                     boost::future<std::vector<std::pair<K, V>>>>>
+                     results_data) {
+                    auto results = results_data.get();
+                    std::vector<std::vector<std::pair<K, V>>> partitions;
+                    partitions.reserve(results.size());
+                    size_t total = 0;
+                    for (auto& partition_future : results) {
+                        partitions.push_back(partition_future.get());
+                        total += partitions.back().size();
+                    }
+
                     std::unordered_map<K, V> result;
-                    for (auto& entryVectorFuture : results_data.get()) {
-                        for (auto& entry : entryVectorFuture.get()) {
-                            auto val = to_object<V>(entry.second);
-                            // it is guaranteed that all values are non-null
-                            assert(val.has_value());
-                            result.emplace(to_object<K>(entry.first).value(),
-                                           std::move(val.value()));
+                    result.reserve(total);
+                    for (auto& partition : partitions) {
+                        for (auto& entry : partition) {
+                            result.emplace(std::move(entry.first),
+                                           std::move(entry.second));
                         }
                     }
                     return result;
@@ -239,38 +340,76 @@ protected:
     template<typename T>
     inline boost::future<std::vector<T>> to_object_vector(
       boost::future<std::vector<serialization::pimpl::data>> data_future)
+    {
+        return data_future
+          .then(
+            boost::launch::sync,
+            [this](boost::future<std::vector<serialization::pimpl::data>> f) {
+                auto data_result =
+                  std::make_shared<std::vector<serialization::pimpl::data>>(
+                    f.get());
+                return convert_chunked<T>(
+                  data_result->size(), [this, data_result](size_t i) {
+                      // The object is guaranteed to exist (non-null)
+                      return std::move(
+                        to_object<T>((*data_result)[i]).value());
+                  });
+            })
+          .unwrap();
+    }
+
+    template<typename T>
+    inline boost::future<lazy_vector<T>> to_lazy_vector(
+      boost::future<std::vector<serialization::pimpl::data>> data_future)
     {
         return data_future.then(
           boost::launch::sync,
           [this](boost::future<std::vector<serialization::pimpl::data>> f) {
-              auto dataResult = f.get();
-              std::vector<T> result;
-              result.reserve(dataResult.size());
-              for (const auto& d : dataResult) {
-                  // The object is guaranteed to exist (non-null)
-                  result.push_back(std::move(to_object<T>(d).value()));
-              }
-              return result;
+              return lazy_vector<T>(f.get(), serialization_service_);
           });
     }
 
     template<typename K, typename V>
-    boost::future<std::unordered_map<K, boost::optional<V>>> to_object_map(
-      boost::future<EntryVector> entries_data)
+    inline boost::future<lazy_entry_vector<K, V>> to_lazy_entry_vector(
+      boost::future<EntryVector> data_future)
     {
-        return entries_data.then(
+        return data_future.then(
           boost::launch::sync, [this](boost::future<EntryVector> f) {
-              auto entries = f.get();
-              std::unordered_map<K, boost::optional<V>> result;
-              result.reserve(entries.size());
-              for (const auto& e : entries) {
-                  result.insert({ std::move(to_object<K>(e.first)).value(),
-                                  to_object<V>(e.second) });
-              }
-              return result;
+              return lazy_entry_vector<K, V>(f.get(), serialization_service_);
           });
     }
 
+    template<typename K, typename V>
+    boost::future<std::unordered_map<K, boost::optional<V>>> to_object_map(
+      boost::future<EntryVector> entries_data)
+    {
+        return entries_data
+          .then(
+            boost::launch::sync,
+            [this](boost::future<EntryVector> f) {
+                auto entries = std::make_shared<EntryVector>(f.get());
+                return convert_chunked<std::pair<K, boost::optional<V>>>(
+                  entries->size(), [this, entries](size_t i) {
+                      const auto& e = (*entries)[i];
+                      return std::pair<K, boost::optional<V>>(
+                        std::move(to_object<K>(e.first)).value(),
+                        to_object<V>(e.second));
+                  });
+            })
+          .unwrap()
+          .then(boost::launch::sync,
+                [](boost::future<std::vector<std::pair<K, boost::optional<V>>>>
+                     f) {
+                    auto entries = f.get();
+                    std::unordered_map<K, boost::optional<V>> result;
+                    result.reserve(entries.size());
+                    for (auto& e : entries) {
+                        result.insert(std::move(e));
+                    }
+                    return result;
+                });
+    }
+
     template<typename K, typename V>
     inline boost::future<boost::optional<entry_view<K, V>>>
     to_object_entry_view(
@@ -301,19 +440,21 @@ protected:
     inline boost::future<std::vector<std::pair<K, V>>> to_entry_object_vector(
       boost::future<EntryVector> data_future)
     {
-        return data_future.then(
-          boost::launch::sync, [this](boost::future<EntryVector> f) {
-              auto dataEntryVector = f.get();
-              std::vector<std::pair<K, V>> result;
-              result.reserve(dataEntryVector.size());
-              for (const auto& e : dataEntryVector) {
-                  // please note that the key and value will never be null
-                  result.emplace_back(
-                    std::move(to_object<K>(e.first)).value(),
-                    std::move(to_object<V>(e.second)).value());
-              }
-              return result;
-          });
+        return data_future
+          .then(boost::launch::sync,
+                [this](boost::future<EntryVector> f) {
+                    auto entries = std::make_shared<EntryVector>(f.get());
+                    return convert_chunked<std::pair<K, V>>(
+                      entries->size(), [this, entries](size_t i) {
+                          const auto& e = (*entries)[i];
+                          // please note that the key and value will never be
+                          // null
+                          return std::pair<K, V>(
+                            std::move(to_object<K>(e.first)).value(),
+                            std::move(to_object<V>(e.second)).value());
+                      });
+                })
+          .unwrap();
     }
 
     template<typename T>
@@ -398,6 +539,8 @@ protected:
     spi::impl::ClientPartitionServiceImpl& partition_service_;
     std::string object_name_;
     spi::ClientContext& client_context_;
+    std::atomic<bool> inline_completion_;
+    size_t deserialization_chunk_size_;
 
 private:
     template<typename T>
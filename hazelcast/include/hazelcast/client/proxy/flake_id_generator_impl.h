@@ -17,6 +17,8 @@
 
 #include <memory>
 #include <atomic>
+#include <mutex>
+#include <boost/optional.hpp>
 #include <boost/smart_ptr/atomic_shared_ptr.hpp>
 
 #include "hazelcast/client/proxy/ProxyImpl.h"
@@ -33,44 +35,19 @@ class HAZELCAST_API flake_id_generator_impl : public ProxyImpl
 {
 public:
     /**
-     * Generates and returns a cluster-wide unique ID.
+     * Set of IDs returned from {@link flake_id_generator}.
      * <p>
-     * Operation on member is always local, if the member has valid node ID,
-     * otherwise it's remote. On client, this method goes to a random member and
-     * gets a batch of IDs, which will then be returned locally for limited
-     * time. The pre-fetch size and the validity time can be configured for each
-     * client and member, see {@code ClientConfig.addFlakeIdGeneratorConfig()}
-     * for client config. <p> <b>Note:</b> Values returned from this method may
-     * be not strictly ordered.
-     *
-     * @return new cluster-wide unique ID
-     *
-     * @throws node_id_out_of_range if node ID for all members in the cluster is
-     * out of valid range. See "Node ID overflow" in {@link FlakeIdGenerator
-     * class documentation} for more details.
-     */
-    boost::future<int64_t> new_id();
-
-protected:
-    flake_id_generator_impl(const std::string& service_name,
-                            const std::string& object_name,
-                            spi::ClientContext* context);
-
-private:
-    /**
-     * Set of IDs returned from {@link FlakeIdGenerator}.
-     * <p>
-     * IDs can be iterated using a foreach loop:
+     * IDs can be iterated using the iterator:
      * <pre>{@code
-     *    IdBatch idBatch = myFlakeIdGenerator.newIdBatch(100);
-     *    for (Long id : idBatch) {
-     *        // ... use the id
+     *    auto batch = generator->new_ids(100).get();
+     *    for (auto it = batch.iterator(); it != batch.end(); ++it) {
+     *        // ... use the id *it
      *    }
      * }</pre>
      * <p>
      * Object is immutable.
      */
-    class IdBatch
+    class HAZELCAST_API IdBatch
     {
     public:
         IdBatch(int64_t base, int64_t increment, int32_t batch_size);
@@ -108,7 +85,7 @@ private:
 
         private:
             int64_t base2_;
-            const int64_t increment_;
+            int64_t increment_;
             int32_t remaining_;
         };
 
@@ -124,30 +101,129 @@ private:
         static IdIterator endOfBatch;
     };
 
+    /**
+     * Generates and returns a cluster-wide unique ID.
+     * <p>
+     * Operation on member is always local, if the member has valid node ID,
+     * otherwise it's remote. On client, this method goes to a random member and
+     * gets a batch of IDs, which will then be returned locally for limited
+     * time. The pre-fetch size and the validity time can be configured for each
+     * client and member, see {@code ClientConfig.addFlakeIdGeneratorConfig()}
+     * for client config. <p> The next batch is requested on the background
+     * when the unused IDs of the current batch drop below the configured
+     * low water mark, hence the returned future is usually ready. Concurrent
+     * calls which find the current batch exhausted share a single request.
+     * <p> <b>Note:</b> Values returned from this method may be not strictly
+     * ordered.
+     *
+     * @return new cluster-wide unique ID
+     *
+     * @throws node_id_out_of_range if node ID for all members in the cluster is
+     * out of valid range. See "Node ID overflow" in {@link FlakeIdGenerator
+     * class documentation} for more details.
+     */
+    boost::future<int64_t> new_id();
+
+    /**
+     * Generates a contiguous range of cluster-wide unique IDs, i.e. the IDs
+     * {@code base + i * increment} for {@code 0 <= i < count}.
+     * <p>
+     * A range no larger than the configured prefetch count is taken from the
+     * prefetched IDs, a larger one is requested from the cluster with a
+     * dedicated call.
+     *
+     * @param count the number of IDs, in the range
+     * 1..client_flake_id_generator_config::MAXIMUM_PREFETCH_COUNT
+     * @return the generated IDs
+     *
+     * @throws illegal_argument if count is out of range
+     */
+    boost::future<IdBatch> new_ids(int32_t count);
+
+protected:
+    flake_id_generator_impl(const std::string& service_name,
+                            const std::string& object_name,
+                            spi::ClientContext* context);
+
+private:
     class Block
     {
     public:
-        Block(IdBatch&& id_batch, std::chrono::milliseconds validity);
+        /**
+         * @param low_water_mark the number of unused IDs at which the next
+         * block should be prefetched, 0 for no prefetch
+         */
+        Block(IdBatch&& id_batch,
+              std::chrono::milliseconds validity,
+              int32_t low_water_mark);
+
+        /**
+         * Takes count consecutive IDs from the block.
+         *
+         * @param base set to the first taken ID
+         * @param low_water_reached set to true if this call took the block to
+         * its low water mark, this happens for exactly one call per block
+         * @return false if the block is expired or has less than count IDs left
+         */
+        bool reserve(int32_t count, int64_t& base, bool& low_water_reached);
 
         /**
-         * Returns next ID or INT64_MIN, if there is none.
+         * @return true if the block is not expired and has at least count IDs
+         * left
          */
-        int64_t next();
+        bool has_remaining(int32_t count) const;
+
+        int64_t get_increment() const;
 
     private:
         IdBatch id_batch_;
         std::chrono::steady_clock::time_point invalid_since_;
         std::atomic<int32_t> num_returned_;
+        int32_t prefetch_index_;
     };
 
     boost::future<flake_id_generator_impl::IdBatch> new_id_batch(int32_t size);
 
-    int64_t new_id_internal();
+    /**
+     * Takes count IDs from the current block, starts the background prefetch
+     * if the low water mark is reached.
+     *
+     * @return false if the current block can not serve count IDs
+     */
+    bool try_reserve(int32_t count, int64_t& base, int64_t& increment);
+
+    /**
+     * Makes a block with at least count IDs current, either by promoting the
+     * prefetched block or by waiting for the (single) in-flight refill.
+     */
+    boost::future<void> next_block(int32_t count);
+
+    /**
+     * Starts a background refill unless one is already in flight or a
+     * prefetched block is waiting.
+     */
+    void prefetch();
+
+    /**
+     * Returns the in-flight refill or starts a new one. The refilled block
+     * becomes the prefetched block.
+     *
+     * @param guard the held lock_, it is released before a request is sent
+     */
+    boost::shared_future<void> refill(std::unique_lock<std::mutex>& guard);
+
+    void complete_refill(boost::promise<void>& promise,
+                         boost::future<IdBatch> batch);
 
     int32_t batch_size_;
     std::chrono::milliseconds validity_;
+    int32_t low_water_mark_;
     boost::atomic_shared_ptr<Block> block_;
+    // guards next_block_ and refill_
     std::mutex lock_;
+    boost::shared_ptr<Block> next_block_;
+    // the in-flight refill request, if any
+    boost::optional<boost::shared_future<void>> refill_;
 };
 
 } // namespace proxy
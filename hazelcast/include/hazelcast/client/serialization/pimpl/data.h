@@ -69,6 +69,12 @@ public:
 
     const std::vector<byte>& to_byte_array() const;
 
+    /**
+     * Moves the serialized bytes out of this data, leaving it empty. Used to
+     * hand the buffer over to a client message frame without a copy.
+     */
+    std::vector<byte> release_byte_array();
+
     int32_t get_type() const;
 
     const schemas_t& schemas_will_be_replicated() const;
@@ -31,6 +31,7 @@ class logger;
 
 namespace cp {
 namespace internal {
+class raft_group_leader_cache;
 namespace session {
 class proxy_session_manager;
 }
@@ -66,7 +67,13 @@ class Connection;
 namespace internal {
 namespace nearcache {
 class NearCacheManager;
+
+namespace impl {
+namespace invalidation {
+class RepairingTask;
 }
+} // namespace impl
+} // namespace nearcache
 } // namespace internal
 
 namespace protocol {
@@ -123,6 +130,9 @@ public:
 
     internal::nearcache::NearCacheManager& get_near_cache_manager();
 
+    internal::nearcache::impl::invalidation::RepairingTask&
+    get_repairing_task();
+
     client_properties& get_client_properties();
 
     cluster& get_cluster();
@@ -155,6 +165,8 @@ public:
 
     cp::internal::session::proxy_session_manager& get_proxy_session_manager();
 
+    cp::internal::raft_group_leader_cache& get_raft_group_leader_cache();
+
     serialization::pimpl::default_schema_service& get_schema_service();
 
 private:
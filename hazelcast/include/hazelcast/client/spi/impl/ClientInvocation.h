@@ -112,6 +112,16 @@ public:
       const std::string& object_name,
       boost::uuids::uuid uuid);
 
+    /**
+     * Selects where the future returned by invoke is completed. By default
+     * the client wide setting is used.
+     *
+     * @param inline_completion true to complete the future directly on the
+     * I/O thread which receives the response, false to complete it on the
+     * user executor
+     */
+    void set_inline_completion(bool inline_completion);
+
     boost::future<protocol::ClientMessage> invoke();
 
     boost::future<protocol::ClientMessage> invoke_urgent();
@@ -157,6 +167,18 @@ private:
     boost::future<void> replicate_schemas(
       std::vector<serialization::pimpl::schema> schemas);
 
+    /**
+     * Returns the future of the invocation, completed on the user executor
+     * or, in inline completion mode, directly by the response.
+     */
+    boost::future<protocol::ClientMessage> completion_future();
+
+    /**
+     * Releases the back pressure slot of the invocation just before its
+     * future is completed in inline completion mode.
+     */
+    void complete_call_id_sequence();
+
     logger& logger_;
     lifecycle_service& lifecycle_service_;
     ClientInvocationServiceImpl& invocation_service_;
@@ -180,6 +202,10 @@ private:
     boost::promise<protocol::ClientMessage> invocation_promise_;
     bool urgent_;
     bool smart_routing_;
+    bool inline_completion_;
+    // set while the back pressure slot of an inline completed invocation is
+    // taken
+    std::atomic<bool> call_id_sequence_pending_{ false };
 
     int32_t backup_acks_received_ = 0;
 
@@ -250,7 +276,7 @@ private:
 
     void erase_invocation() const;
 
-    void complete(const std::shared_ptr<protocol::ClientMessage>& msg);
+    void complete(std::shared_ptr<protocol::ClientMessage> msg);
 
     void complete_with_pending_response();
 };
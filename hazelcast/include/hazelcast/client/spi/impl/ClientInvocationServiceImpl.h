@@ -63,6 +63,12 @@ public:
 
     bool is_smart_routing() const;
 
+    /**
+     * @return true if the invocations complete their futures on the I/O
+     * thread by default
+     */
+    bool is_inline_completion() const;
+
     std::chrono::milliseconds get_invocation_timeout() const;
 
     std::chrono::milliseconds get_invocation_retry_pause() const;
@@ -106,6 +112,7 @@ private:
     bool backup_acks_enabled_;
     bool fail_on_indeterminate_operation_state_;
     std::chrono::milliseconds backup_timeout_;
+    bool inline_completion_;
 
     static void write_to_connection(
       connection::Connection& connection,
@@ -17,6 +17,8 @@
 #pragma once
 
 #include <atomic>
+#include <mutex>
+#include <vector>
 
 #include <boost/smart_ptr/atomic_shared_ptr.hpp>
 
@@ -61,6 +63,23 @@ public:
 
     boost::uuids::uuid get_partition_owner(int partition_id);
 
+    /**
+     * Routes a partition to its owner connection with a single lookup in the
+     * current routing snapshot.
+     *
+     * @return the connection to the owner of the partition, nullptr if the
+     * owner is not known or the client is not connected to it
+     */
+    std::shared_ptr<connection::Connection> get_partition_connection(
+      int32_t partition_id);
+
+    /**
+     * Rebuilds the partition to connection routing snapshot from the current
+     * partition table and the active connections. It should be called
+     * whenever any of them changes.
+     */
+    void refresh_routing_table();
+
     int32_t get_partition_id(const serialization::pimpl::data& key);
 
     int32_t get_partition_count();
@@ -77,7 +96,14 @@ private:
     {
         int32_t connection_id;
         int32_t version;
-        std::unordered_map<int32_t, boost::uuids::uuid> partitions;
+        // owner uuids indexed by partition id
+        std::vector<boost::uuids::uuid> partitions;
+    };
+
+    struct routing_table
+    {
+        // owner connections indexed by partition id
+        std::vector<std::shared_ptr<connection::Connection>> connections;
     };
 
     class PartitionImpl : public client::impl::Partition
@@ -109,7 +135,7 @@ private:
                      const partition_table& current,
                      const std::string& cause);
 
-    std::unordered_map<int32_t, boost::uuids::uuid> convert_to_map(
+    std::vector<boost::uuids::uuid> convert_to_owners(
       const std::vector<std::pair<boost::uuids::uuid, std::vector<int>>>&
         partitions);
 
@@ -117,6 +143,10 @@ private:
     logger& logger_;
     std::atomic<int32_t> partition_count_;
     boost::atomic_shared_ptr<partition_table> partition_table_;
+    // serializes the rebuilds so that the last stored snapshot reflects the
+    // latest partition table and connections
+    std::mutex routing_table_mutex_;
+    boost::atomic_shared_ptr<routing_table> routing_table_;
 };
 } // namespace impl
 } // namespace spi
@@ -102,6 +102,13 @@ private:
       const std::shared_ptr<ClientInvocation> invocation,
       const std::shared_ptr<protocol::ClientMessage> response);
 
+    /**
+     * Handles the queued events of a coalescing handler batch by batch until
+     * its queue is empty.
+     */
+    void process_event_batch(
+      const std::shared_ptr<client::impl::BaseEventHandler> event_handler);
+
     void remove_event_handler(
       int64_t call_id,
       const std::shared_ptr<connection::Connection>& connection);
@@ -15,12 +15,18 @@
  */
 #pragma once
 
+#include <cstdint>
+#include <memory>
+#include <typeinfo>
 #include <vector>
 #include <boost/any.hpp>
 #include <boost/optional.hpp>
 #include <boost/enable_shared_from_this.hpp>
+#include <boost/throw_exception.hpp>
+#include <boost/utility/string_view.hpp>
 
 #include "hazelcast/util/export.h"
+#include "hazelcast/client/hazelcast_json_value.h"
 #include "hazelcast/client/sql/sql_column_type.h"
 #include "hazelcast/client/sql/sql_row_metadata.h"
 #include "hazelcast/client/serialization/serialization.h"
@@ -36,12 +42,64 @@ class sql_page_codec;
 } // namespace protocol
 namespace sql {
 
+/**
+ * A read-only view of the values of a column of an sql_page. The values are
+ * not copied, hence the view is valid as long as the page is alive.
+ *
+ * @see sql_page::column_values
+ */
+template<typename T>
+class sql_column_view
+{
+public:
+    sql_column_view(const T* values,
+                    const std::uint64_t* null_bitmap,
+                    std::size_t size)
+      : values_(values)
+      , null_bitmap_(null_bitmap)
+      , size_(size)
+    {
+    }
+
+    /**
+     * @return the number of the rows
+     */
+    std::size_t size() const { return size_; }
+
+    /**
+     * @return true if the value of the row is SQL NULL
+     */
+    bool is_null(std::size_t row_index) const
+    {
+        return (null_bitmap_[row_index / 64] >> (row_index % 64)) & 1U;
+    }
+
+    /**
+     * @return the value of the row, unspecified if the value is SQL NULL
+     */
+    const T& operator[](std::size_t row_index) const
+    {
+        return values_[row_index];
+    }
+
+    /**
+     * @return the values of the rows which are stored contiguously, null if
+     * all the values of the column are SQL NULL
+     */
+    const T* data() const { return values_; }
+
+private:
+    const T* values_;
+    const std::uint64_t* null_bitmap_;
+    std::size_t size_;
+};
+
 /**
  * A finite set of rows returned to the client.
  */
 class HAZELCAST_API sql_page
 {
-    using column = std::vector<boost::any>;
+    class HAZELCAST_API column;
     struct HAZELCAST_API page_data;
 
 public:
@@ -164,6 +222,32 @@ public:
      */
     const std::vector<sql_row>& rows() const;
 
+    /**
+     * Returns a view of the values of the column without boxing or copying
+     * them.
+     * <p>
+     * \codeT\endcode is the type which sql_row::get_object returns for the
+     * column, except that the values of varchar and json columns are viewed
+     * as boost::string_view.
+     *
+     * @param column_index column index, zero-based.
+     * @return the values of the column
+     *
+     * @throws hazelcast::client::exception::index_out_of_bounds if the
+     * column index is out of bounds
+     * @throws boost::bad_any_cast if the values of the column are not stored
+     * as \codeT\endcode
+     */
+    template<typename T>
+    sql_column_view<T> column_values(std::size_t column_index) const
+    {
+        check_column_index(column_index);
+
+        auto& column = page_data_->columns_[column_index];
+        return sql_column_view<T>(
+          column.values<T>(), column.null_bitmap(), column.size());
+    }
+
 private:
     friend class sql_result;
     friend class protocol::codec::builtin::sql_page_codec;
@@ -186,6 +270,104 @@ private:
 
     void construct_rows();
 
+    void check_column_index(std::size_t column_index) const;
+
+    /**
+     * The values of a column. The values are stored contiguously with their
+     * own type, the strings of the varchar and json columns are copied into
+     * one buffer and the nulls are marked in a bitmap.
+     */
+    class HAZELCAST_API column
+    {
+    public:
+        template<typename T>
+        static column of(std::vector<boost::optional<T>> values)
+        {
+            auto size = values.size();
+            column result(size, typeid(T), typeid(T));
+            auto storage = new T[size];
+            result.values_ =
+              std::shared_ptr<void>(storage, std::default_delete<T[]>());
+            for (std::size_t i = 0; i < size; ++i) {
+                if (values[i]) {
+                    storage[i] = std::move(*values[i]);
+                } else {
+                    result.set_null(i);
+                }
+            }
+            return result;
+        }
+
+        /**
+         * @param value_type std::string or hazelcast_json_value
+         */
+        static column of_strings(
+          const std::type_info& value_type,
+          const std::vector<boost::optional<std::string>>& values);
+
+        static column of_nulls(std::size_t size);
+
+        std::size_t size() const;
+
+        bool is_null(std::size_t row_index) const
+        {
+            return (null_bitmap_[row_index / 64] >> (row_index % 64)) & 1U;
+        }
+
+        const std::uint64_t* null_bitmap() const;
+
+        /**
+         * @return the stored values, null for a column of nulls
+         */
+        template<typename T>
+        const T* values() const
+        {
+            if (!values_) {
+                return nullptr;
+            }
+            if (*storage_type_ != typeid(T)) {
+                boost::throw_exception(boost::bad_any_cast());
+            }
+            return static_cast<const T*>(values_.get());
+        }
+
+        template<typename T>
+        T get(std::size_t row_index) const
+        {
+            if (*value_type_ != typeid(T)) {
+                boost::throw_exception(boost::bad_any_cast());
+            }
+            return value(row_index, static_cast<T*>(nullptr));
+        }
+
+    private:
+        column(std::size_t size,
+               const std::type_info& value_type,
+               const std::type_info& storage_type);
+
+        void set_null(std::size_t row_index);
+
+        template<typename T>
+        T value(std::size_t row_index, T* /* dummy */) const
+        {
+            return static_cast<const T*>(values_.get())[row_index];
+        }
+
+        std::string value(std::size_t row_index, std::string* dummy) const;
+
+        hazelcast_json_value value(std::size_t row_index,
+                                   hazelcast_json_value* dummy) const;
+
+        std::size_t size_;
+        std::vector<std::uint64_t> null_bitmap_;
+        // the type returned by get
+        const std::type_info* value_type_;
+        // the type of the stored values, boost::string_view for the strings
+        const std::type_info* storage_type_;
+        std::shared_ptr<void> values_;
+        std::shared_ptr<char> string_buffer_;
+    };
+
     struct HAZELCAST_API page_data
     {
         std::vector<sql_column_type> column_types_;
@@ -200,19 +382,19 @@ private:
             assert(column_index < column_count());
             assert(row_index < row_count());
 
-            auto& any_value = columns_[column_index][row_index];
-            if (any_value.empty()) {
+            auto& column = columns_[column_index];
+            if (column.is_null(row_index)) {
                 return boost::none;
             }
 
             if (column_types_[column_index] != sql_column_type::object) {
-                return boost::any_cast<T>(any_value);
+                return column.get<T>(row_index);
             }
 
             // this is the object type, hence the value is `data`
             // and we need to de-serialize it
             return serialization_service_->to_object<T>(
-              boost::any_cast<serialization::pimpl::data>(any_value));
+              column.values<serialization::pimpl::data>()[row_index]);
         }
 
         std::size_t column_count() const;
@@ -17,6 +17,8 @@
 
 #include <iterator>
 #include <chrono>
+#include <deque>
+#include <functional>
 
 #include <boost/thread/future.hpp>
 
@@ -297,6 +299,36 @@ public:
      */
     page_iterator iterator();
 
+    /**
+     * Streams the rows of the result to the consumer.
+     * <p>
+     * The consumer is called with the rows one by one in the order of the
+     * result, on the user executor threads. The next page is requested from
+     * the cluster only after the consumer processed all the rows of the
+     * current page, plus sql_statement::prefetch_depth pages ahead. Hence a
+     * slow consumer delays the fetches, and the client keeps at most
+     * 1 + prefetch_depth pages of the result in memory. The storage of a
+     * page is released as soon as its rows are consumed, unless the consumer
+     * keeps a copy of a row.
+     * <p>
+     * When the consumer returns false, no more rows are delivered and the
+     * result is closed, which cancels the query on the cluster. This allows
+     * consuming a part of an unbounded stream.
+     * <p>
+     * The rows can be streamed only if the iterator was not requested.
+     *
+     * @param consumer called with each row, returns true to continue with the
+     * next row, false to stop
+     * @return the future which is completed when all the rows are consumed or
+     * the consumer stopped. It fails if a page cannot be fetched or if the
+     * consumer throws.
+     *
+     * @throws exception::illegal_state if the iterator is already requested
+     * or if this result does not have any rows.
+     */
+    boost::future<void> stream_rows(
+      std::function<bool(const sql_page::sql_row&)> consumer);
+
     page_iterator_sync pbegin(
       std::chrono::milliseconds timeout = std::chrono::milliseconds{ -1 });
     page_iterator_sync pend();
@@ -324,6 +356,13 @@ private:
 
     int32_t cursor_buffer_size_;
 
+    int32_t prefetch_depth_;
+    /** The fetched pages which are not returned by fetch_page yet. */
+    std::deque<boost::shared_future<std::shared_ptr<sql_page>>>
+      prefetched_pages_;
+    /** The last requested page, the next page is requested after it. */
+    boost::shared_future<std::shared_ptr<sql_page>> last_fetch_;
+
     /**
      * This is a PRIVATE API. Do NOT use it.
      *
@@ -335,6 +374,7 @@ private:
      * @param row_metadata The row metadata of the sql result
      * @param first_page The first page of the sql result
      * @param cursor_buffer_size The cursor buffer size of the sql result
+     * @param prefetch_depth The number of the pages fetched ahead
      */
     sql_result(
       spi::ClientContext* client_context,
@@ -344,11 +384,28 @@ private:
       int64_t update_count,
       std::shared_ptr<sql_row_metadata> row_metadata,
       std::shared_ptr<sql_page> first_page,
-      int32_t cursor_buffer_size);
+      int32_t cursor_buffer_size,
+      int32_t prefetch_depth);
 
 private:
+    struct row_stream;
+
     boost::future<std::shared_ptr<sql_page>> fetch_page();
 
+    static void stream_next_page(std::shared_ptr<row_stream> stream);
+
+    /**
+     * Starts fetching the pages after the first page if prefetching is
+     * enabled.
+     */
+    void start_prefetch();
+
+    /**
+     * Requests the pages until prefetch_depth_ pages are prefetched. Must be
+     * called with mtx_ locked.
+     */
+    void prefetch_pages();
+
     template<typename T>
     boost::optional<T> to_object(serialization::pimpl::data data)
     {
@@ -180,6 +180,7 @@ private:
       std::shared_ptr<connection::Connection> connection,
       impl::query_id id,
       int32_t cursor_buffer_size,
+      int32_t prefetch_depth,
       std::weak_ptr<std::atomic<int32_t>> statement_par_arg_index_ptr);
 
     static sql_execute_response_parameters decode_execute_response(
@@ -60,6 +60,9 @@ public:
     /** Default cursor buffer size. */
     static constexpr int32_t DEFAULT_CURSOR_BUFFER_SIZE = 4096;
 
+    /** Default prefetch depth, the pages are fetched when requested. */
+    static constexpr int32_t DEFAULT_PREFETCH_DEPTH = 0;
+
     /**
      * Creates a statement with the given query.
      * @param client The hazelcast client to be used for the statement.
@@ -155,6 +158,34 @@ public:
      */
     sql_statement& cursor_buffer_size(int32_t size);
 
+    /**
+     * Gets the number of the result pages which are fetched ahead.
+     *
+     * @return prefetch depth (measured in the number of pages)
+     */
+    int32_t prefetch_depth() const;
+
+    /**
+     * Sets the number of the result pages which are fetched ahead.
+     * <p>
+     * By default the next page of a sql_result is requested from the member
+     * only when the page is requested from the iterator, hence a client which
+     * processes the rows about as fast as the network delivers them waits for
+     * every page. When the prefetch depth is positive, the following pages are
+     * requested while the current page is processed. The pages are requested
+     * one after another, each of them with at most cursor_buffer_size() rows,
+     * hence at most depth * cursor_buffer_size() rows are buffered by the
+     * client for the result. The prefetched pages are dropped when the result
+     * is closed. <p> Only non-negative values are allowed. <p> Defaults to
+     * sql_statement::DEFAULT_PREFETCH_DEPTH.
+     *
+     * @param depth prefetch depth (measured in the number of pages)
+     * @return this instance for chaining
+     *
+     * @see cursor_buffer_size(int32_t size)
+     */
+    sql_statement& prefetch_depth(int32_t depth);
+
     /**
      * Gets the execution timeout in milliseconds.
      *
@@ -247,6 +278,7 @@ private:
     std::string sql_;
     std::vector<data> serialized_parameters_;
     int32_t cursor_buffer_size_;
+    int32_t prefetch_depth_;
     std::chrono::milliseconds timeout_;
     sql::sql_expected_result_type expected_result_type_;
     boost::optional<std::string> schema_;
@@ -65,8 +65,29 @@ protected:
     std::string object_name_;
 
     void on_destroy();
+
+    /**
+     * Sends the request to the member which is known to answer the
+     * invocations of the Raft group the fastest, which is its leader, or to
+     * any member if there is no such member yet.
+     *
+     * @see internal::raft_group_leader_cache
+     */
+    boost::future<client::protocol::ClientMessage> invoke(
+      client::protocol::ClientMessage& request);
+
+    template<typename T>
+    boost::future<T> invoke_and_get_future(
+      client::protocol::ClientMessage& request)
+    {
+        return decode<T>(invoke(request));
+    }
 };
 
+template<>
+boost::future<boost::optional<client::serialization::pimpl::data>> HAZELCAST_API
+cp_proxy::invoke_and_get_future(client::protocol::ClientMessage& request);
+
 namespace internal {
 namespace session {
 class proxy_session_manager;
@@ -16,8 +16,13 @@
 
 #pragma once
 
+#include <chrono>
+#include <limits>
+#include <mutex>
 #include <unordered_map>
+#include <boost/functional/hash.hpp>
 #include <boost/thread/shared_mutex.hpp>
+#include <boost/uuid/uuid.hpp>
 #include <boost/asio/steady_timer.hpp>
 #include <boost/thread/future.hpp>
 
@@ -36,6 +41,95 @@ class ClientContext;
 } // namespace client
 namespace cp {
 namespace internal {
+/**
+ * Caches the member which answers the invocations of each Raft group the
+ * fastest, so that the CP proxies can send their invocations to it.
+ *
+ * The member which receives a CP invocation forwards it to the leader of the
+ * Raft group, unless it is the leader itself. The client protocol does not
+ * tell the client which member is the leader, but the leader saves the
+ * forwarding hop and answers the fastest, hence the cache learns it from the
+ * response times of the members. The invocations of a group are sent to each
+ * member once and then to the fastest member, except that every
+ * PROBE_INTERVAL-th invocation is sent to the next member, so that a new
+ * leader is found after an election.
+ *
+ * A member is not used until it is probed again when the client cannot reach
+ * it, i.e. an invocation sent to it fails with a connection error or is
+ * answered by another member. A member is forgotten when it leaves the
+ * cluster and a joining member is probed by the next invocation of each group.
+ */
+class HAZELCAST_API raft_group_leader_cache
+{
+public:
+    static constexpr int64_t PROBE_INTERVAL = 64;
+
+    explicit raft_group_leader_cache(client::spi::ClientContext& context);
+
+    /**
+     * Starts following the membership changes of the cluster.
+     */
+    void start();
+
+    /**
+     * @return the member to send the next invocation of the group to, nil if
+     * the invocation can be sent to any member
+     */
+    boost::uuids::uuid get_target(const raft_group_id& group_id);
+
+    /**
+     * Records the response time of an invocation sent to the target.
+     *
+     * @param responder the member which answered the invocation, it is not
+     * the target when the client is not connected to the target
+     */
+    void on_response(const raft_group_id& group_id,
+                     boost::uuids::uuid target,
+                     boost::uuids::uuid responder,
+                     std::chrono::steady_clock::duration response_time);
+
+    /**
+     * Stops using the target after an invocation could not reach it.
+     */
+    void on_failure(const raft_group_id& group_id, boost::uuids::uuid target);
+
+    // for testing
+    boost::uuids::uuid get_leader(const raft_group_id& group_id);
+
+private:
+    // the smoothed response time keeps 1/RESPONSE_TIME_SMOOTHING of each
+    // new response time
+    static constexpr int64_t RESPONSE_TIME_SMOOTHING = 8;
+    static constexpr int64_t UNREACHABLE =
+      (std::numeric_limits<int64_t>::max)();
+
+    struct group_state
+    {
+        boost::uuids::uuid leader{};
+        int64_t invocation_count = 0;
+        size_t member_count = 0;
+        size_t next_probe = 0;
+        std::unordered_map<boost::uuids::uuid,
+                           int64_t,
+                           boost::hash<boost::uuids::uuid>>
+          response_nanos;
+    };
+
+    // the member count of a group whose member list needs to be read again
+    static constexpr size_t UNKNOWN_MEMBER_COUNT =
+      (std::numeric_limits<size_t>::max)();
+
+    static void elect_leader(group_state& state);
+
+    void on_member_left(boost::uuids::uuid member_uuid);
+
+    void on_member_list_changed();
+
+    client::spi::ClientContext& context_;
+    std::mutex lock_;
+    std::unordered_map<raft_group_id, group_state> groups_;
+};
+
 namespace session {
 class HAZELCAST_API proxy_session_manager
 {
@@ -59,6 +153,17 @@ public:
      */
     int64_t acquire_session(const raft_group_id& group_id, int32_t count);
 
+    /**
+     * Increments acquire count of the session.
+     * Creates a new session if there is no session yet. The session creation
+     * does not block the caller, and the concurrent acquisitions for the same
+     * group wait for the same session creation request.
+     *
+     * @return the future of the acquired session id
+     */
+    boost::future<int64_t> acquire_session_async(const raft_group_id& group_id,
+                                                 int32_t count);
+
     /**
      * Decrements acquire count of the session.
      * Returns silently if no session exists for the given id.
@@ -125,16 +230,24 @@ private:
     bool running_ = true;
     std::atomic_bool scheduled_heartbeat_ = { false };
     std::unordered_map<raft_group_id, session_state> sessions_;
+    // the session creations which are in flight, no lock is held while waiting
+    std::unordered_map<raft_group_id, boost::shared_future<session_response>>
+      pending_sessions_;
     typedef std::pair<raft_group_id, int64_t> key_type;
     std::unordered_map<key_type, int64_t, boost::hash<key_type>> thread_ids_;
     std::shared_ptr<boost::asio::steady_timer> heartbeat_timer_;
 
-    session_state& get_or_create_session(const raft_group_id& group_id);
+    void check_running() const;
+
+    void create_new_session(
+      const raft_group_id& group_id,
+      std::shared_ptr<boost::promise<session_response>> creation);
 
-    std::unordered_map<raft_group_id, session_state>::iterator
-    create_new_session(const raft_group_id& group_id);
+    void install_session(const raft_group_id& group_id,
+                         const session_response& response);
 
-    session_response request_new_session(const raft_group_id& group_id);
+    boost::future<session_response> request_new_session(
+      const raft_group_id& group_id);
 
     void schedule_heartbeat_task(int64_t hearbeat_millis);
 
@@ -16,10 +16,20 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "hazelcast/client/exception/protocol_exceptions.h"
 #include "hazelcast/client/internal/eviction/Expirable.h"
-#include "hazelcast/util/SynchronizedMap.h"
 #include "hazelcast/util/Iterator.h"
 #include "hazelcast/util/Iterable.h"
+#include "hazelcast/util/Util.h"
 
 #if defined(WIN32) || defined(_WIN32) || defined(WIN64) || defined(_WIN64)
 #pragma warning(push)
@@ -31,15 +41,211 @@ namespace util {
 /**
  * ConcurrentHashMap to extend iterator capability.
  *
+ * The entries are spread over lock striped segments by the hash of their
+ * keys, so that the operations on the keys of different segments, e.g. the
+ * Near Cache reads of different application threads, do not contend on a
+ * single lock. The number of segments is a power of two which is at least
+ * the concurrency level.
+ *
  * @param <K> Type of the key
  * @param <V> Type of the value
  */
 template<typename K, typename V, typename KS, typename VS>
 class SampleableConcurrentHashMap
-  : public SynchronizedMap<std::shared_ptr<KS>, VS>
 {
 public:
-    SampleableConcurrentHashMap(int32_t /* initial_capacity */) {}
+    typedef std::pair<std::shared_ptr<KS>, std::shared_ptr<VS>> entry;
+
+    /**
+     * Used when no concurrency level is given: four segments per core, at
+     * least 16.
+     */
+    static int32_t default_concurrency_level()
+    {
+        return (std::max)(MIN_CONCURRENCY_LEVEL,
+                          4 * util::get_available_core_count());
+    }
+
+    explicit SampleableConcurrentHashMap(
+      int32_t initial_capacity,
+      int32_t concurrency_level = default_concurrency_level())
+      : segment_count_(segment_count_for(concurrency_level))
+      , segments_(new segment[segment_count_])
+      , size_(0)
+    {
+        if (initial_capacity > 0) {
+            auto segmentCapacity =
+              (static_cast<size_t>(initial_capacity) + segment_count_ - 1) /
+              segment_count_;
+            for (size_t i = 0; i < segment_count_; ++i) {
+                segments_[i].entries.reserve(segmentCapacity);
+            }
+        }
+    }
+
+    virtual ~SampleableConcurrentHashMap() = default;
+
+    bool contains_key(const std::shared_ptr<KS>& key) const
+    {
+        auto& s = segment_for(key);
+        std::lock_guard<std::mutex> guard(s.lock);
+        return s.entries.find(key) != s.entries.end();
+    }
+
+    /**
+     * @return the previous value associated with the specified key,
+     *         or <tt>null</tt> if there was no mapping for the key
+     */
+    std::shared_ptr<VS> put(const std::shared_ptr<KS>& key,
+                            std::shared_ptr<VS> value)
+    {
+        auto& s = segment_for(key);
+        std::lock_guard<std::mutex> guard(s.lock);
+        auto result = s.entries.emplace(key, value);
+        if (result.second) {
+            ++size_;
+            return nullptr;
+        }
+        std::swap(result.first->second, value);
+        return value;
+    }
+
+    /**
+     * @return the previous value associated with the specified key,
+     *         or <tt>null</tt> if there was no mapping for the key
+     */
+    std::shared_ptr<VS> put_if_absent(const std::shared_ptr<KS>& key,
+                                      std::shared_ptr<VS> value)
+    {
+        auto& s = segment_for(key);
+        std::lock_guard<std::mutex> guard(s.lock);
+        auto result = s.entries.emplace(key, std::move(value));
+        if (result.second) {
+            ++size_;
+            return nullptr;
+        }
+        return result.first->second;
+    }
+
+    /**
+     * Returns the value to which the specified key is mapped,
+     * or {@code null} if this map contains no mapping for the key.
+     */
+    std::shared_ptr<VS> get(const std::shared_ptr<KS>& key) const
+    {
+        auto& s = segment_for(key);
+        std::lock_guard<std::mutex> guard(s.lock);
+        auto foundIter = s.entries.find(key);
+        if (foundIter != s.entries.end()) {
+            return foundIter->second;
+        }
+        return nullptr;
+    }
+
+    /**
+     * @return the removed value, or {@code null} if this map contains no
+     * mapping for the key.
+     */
+    std::shared_ptr<VS> remove(const std::shared_ptr<KS>& key)
+    {
+        auto& s = segment_for(key);
+        std::lock_guard<std::mutex> guard(s.lock);
+        auto foundIter = s.entries.find(key);
+        if (foundIter == s.entries.end()) {
+            return nullptr;
+        }
+        auto value = std::move(foundIter->second);
+        s.entries.erase(foundIter);
+        --size_;
+        return value;
+    }
+
+    /**
+     * Removes the keys locking each segment once.
+     *
+     * @return the previous values of the keys in the order of the keys,
+     * {@code null} for a key which is not in the map.
+     */
+    std::vector<std::shared_ptr<VS>> remove_all(
+      const std::vector<std::shared_ptr<KS>>& keys)
+    {
+        std::vector<std::pair<size_t, size_t>> segmentOfKeys;
+        segmentOfKeys.reserve(keys.size());
+        for (size_t i = 0; i < keys.size(); ++i) {
+            segmentOfKeys.emplace_back(segment_index(keys[i]), i);
+        }
+        std::sort(segmentOfKeys.begin(), segmentOfKeys.end());
+
+        std::vector<std::shared_ptr<VS>> removed(keys.size());
+        auto it = segmentOfKeys.begin();
+        while (it != segmentOfKeys.end()) {
+            auto& s = segments_[it->first];
+            auto segmentIndex = it->first;
+            std::lock_guard<std::mutex> guard(s.lock);
+            for (; it != segmentOfKeys.end() && it->first == segmentIndex;
+                 ++it) {
+                auto foundIter = s.entries.find(keys[it->second]);
+                if (foundIter != s.entries.end()) {
+                    removed[it->second] = std::move(foundIter->second);
+                    s.entries.erase(foundIter);
+                    --size_;
+                }
+            }
+        }
+        return removed;
+    }
+
+    /**
+     * @return a copy of the entries, each segment is copied atomically
+     */
+    std::vector<entry> entry_set() const
+    {
+        std::vector<entry> entries;
+        entries.reserve(size());
+        for (size_t i = 0; i < segment_count_; ++i) {
+            auto& s = segments_[i];
+            std::lock_guard<std::mutex> guard(s.lock);
+            entries.insert(entries.end(), s.entries.begin(), s.entries.end());
+        }
+        return entries;
+    }
+
+    /**
+     * @return a copy of the keys, each segment is copied atomically
+     */
+    std::vector<std::shared_ptr<KS>> keys() const
+    {
+        std::vector<std::shared_ptr<KS>> keys;
+        keys.reserve(size());
+        for (size_t i = 0; i < segment_count_; ++i) {
+            auto& s = segments_[i];
+            std::lock_guard<std::mutex> guard(s.lock);
+            for (const auto& e : s.entries) {
+                keys.push_back(e.first);
+            }
+        }
+        return keys;
+    }
+
+    /**
+     * @return the removed entries
+     */
+    std::vector<entry> clear()
+    {
+        std::vector<entry> entries;
+        for (size_t i = 0; i < segment_count_; ++i) {
+            auto& s = segments_[i];
+            std::lock_guard<std::mutex> guard(s.lock);
+            entries.insert(entries.end(), s.entries.begin(), s.entries.end());
+            size_ -= static_cast<int64_t>(s.entries.size());
+            s.entries.clear();
+        }
+        return entries;
+    }
+
+    size_t size() const { return static_cast<size_t>(size_.load()); }
+
+    bool empty() const { return size() == 0; }
 
     /**
      * Entry to define keys and values for sampling.
@@ -185,13 +391,12 @@ public:
             BOOST_THROW_EXCEPTION(client::exception::illegal_argument(
               "Sample count cannot be a negative value."));
         }
-        if (sample_count == 0 ||
-            SynchronizedMap<std::shared_ptr<KS>, VS>::size() == 0) {
+        if (sample_count == 0 || empty()) {
             return std::unique_ptr<util::Iterable<E>>();
         }
 
         return std::unique_ptr<util::Iterable<E>>(
-          new LazySamplingEntryIterableIterator(sample_count, *this));
+          new SamplingEntryIterableIterator(collect_samples(sample_count)));
     }
 
 protected:
@@ -221,89 +426,42 @@ protected:
     }
 
 private:
+    static constexpr int32_t MIN_CONCURRENCY_LEVEL = 16;
+    static constexpr int32_t MAX_SEGMENT_COUNT = 1 << 16;
+
+    struct segment
+    {
+        mutable std::mutex lock;
+        std::unordered_map<std::shared_ptr<KS>, std::shared_ptr<VS>> entries;
+        // keeps the locks of the adjacent segments on different cache lines
+        char padding[64];
+    };
+
     /**
-     * Starts at a random index and iterates through until all the samples can
-     * be collected
+     * Iterates over the samples collected on creation.
      */
-    class LazySamplingEntryIterableIterator
+    class SamplingEntryIterableIterator
       : public util::Iterable<E>
       , public util::Iterator<E>
     {
     public:
-        LazySamplingEntryIterableIterator(
-          int max_count,
-          const SampleableConcurrentHashMap<K, V, KS, VS>& sampleable_map)
-          : max_entry_count_(max_count)
-          , random_number_(std::abs(rand()))
-          , returned_entry_count_(0)
-          , current_index_(-1)
-          , reached_to_end_(false)
-          , internal_map_(sampleable_map)
-        {
-            size_t mapSize = internal_map_.size();
-            start_index_ = (int)(random_number_ % mapSize);
-            if (start_index_ < 0) {
-                start_index_ = 0;
-            }
-        }
+        explicit SamplingEntryIterableIterator(
+          std::vector<std::shared_ptr<E>> samples)
+          : samples_(std::move(samples))
+          , index_(0)
+        {}
 
         util::Iterator<E>* iterator() override { return this; }
 
-        void iterate()
-        {
-            if (returned_entry_count_ >= max_entry_count_ || reached_to_end_) {
-                current_sample_.reset();
-                return;
-            }
-
-            if (current_index_ == -1) {
-                current_index_ = start_index_;
-            }
-            // If current entry is not initialized yet, initialize it
-            if (current_entry_.get() == NULL) {
-                current_entry_ =
-                  internal_map_.get_entry((size_t)current_index_);
-            }
-            do {
-                current_entry_ =
-                  internal_map_.get_entry((size_t)current_index_);
-                // Advance to next entry
-                ++current_index_;
-                if ((size_t)current_index_ >= internal_map_.size()) {
-                    current_index_ = 0;
-                }
-                while (current_entry_.get() != NULL) {
-                    std::shared_ptr<VS> value = current_entry_->second;
-                    std::shared_ptr<KS> key = current_entry_->first;
-                    current_entry_ =
-                      internal_map_.get_entry((size_t)current_index_);
-                    if (internal_map_.is_valid_for_sampling(value)) {
-                        current_sample_ =
-                          internal_map_.create_sampling_entry(key, value);
-                        returned_entry_count_++;
-                        return;
-                    }
-                }
-            } while (current_index_ != start_index_);
-
-            reached_to_end_ = true;
-            current_sample_.reset();
-        }
-
-        bool has_next() override
-        {
-            iterate();
-            return current_sample_.get() != NULL;
-        }
+        bool has_next() override { return index_ < samples_.size(); }
 
         std::shared_ptr<E> next() override
         {
-            if (current_sample_.get() != NULL) {
-                return current_sample_;
-            } else {
+            if (index_ >= samples_.size()) {
                 BOOST_THROW_EXCEPTION(client::exception::no_such_element(
                   "No more elements in the iterated collection"));
             }
+            return samples_[index_++];
         }
 
         void remove() override
@@ -313,18 +471,88 @@ private:
         }
 
     private:
-        const int max_entry_count_;
-        const int random_number_;
-        std::shared_ptr<std::pair<std::shared_ptr<KS>, std::shared_ptr<VS>>>
-          current_entry_;
-        int returned_entry_count_;
-        int current_index_;
-        bool reached_to_end_;
-        std::shared_ptr<E> current_sample_;
-        const SampleableConcurrentHashMap& internal_map_;
-        int start_index_;
+        std::vector<std::shared_ptr<E>> samples_;
+        size_t index_;
     };
+
+    static size_t segment_count_for(int32_t concurrency_level)
+    {
+        size_t count = 1;
+        while (count < static_cast<size_t>(concurrency_level) &&
+               count < static_cast<size_t>(MAX_SEGMENT_COUNT)) {
+            count <<= 1;
+        }
+        return count;
+    }
+
+    size_t segment_index(const std::shared_ptr<KS>& key) const
+    {
+        // the bucket of a key in its segment is selected with the low bits of
+        // the same hash, spread the high bits into the segment index
+        auto h = static_cast<uint64_t>(hasher_(key));
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        return static_cast<size_t>(h) & (segment_count_ - 1);
+    }
+
+    segment& segment_for(const std::shared_ptr<KS>& key) const
+    {
+        return segments_[segment_index(key)];
+    }
+
+    /**
+     * Starts at a random bucket of a random segment and walks the buckets
+     * until the samples are collected or all the segments are visited. Only
+     * one segment is locked at a time.
+     */
+    std::vector<std::shared_ptr<E>> collect_samples(int sample_count) const
+    {
+        std::vector<std::shared_ptr<E>> samples;
+        samples.reserve(sample_count);
+        auto random = static_cast<size_t>(std::abs(rand()));
+        auto startSegment = random & (segment_count_ - 1);
+        for (size_t i = 0;
+             i < segment_count_ && samples.size() < (size_t)sample_count;
+             ++i) {
+            auto& s = segments_[(startSegment + i) & (segment_count_ - 1)];
+            std::lock_guard<std::mutex> guard(s.lock);
+            auto bucketCount = s.entries.bucket_count();
+            if (s.entries.empty() || bucketCount == 0) {
+                continue;
+            }
+            auto startBucket = random % bucketCount;
+            for (size_t b = 0;
+                 b < bucketCount && samples.size() < (size_t)sample_count;
+                 ++b) {
+                auto bucket = (startBucket + b) % bucketCount;
+                for (auto it = s.entries.begin(bucket);
+                     it != s.entries.end(bucket) &&
+                     samples.size() < (size_t)sample_count;
+                     ++it) {
+                    if (is_valid_for_sampling(it->second)) {
+                        auto key = it->first;
+                        auto value = it->second;
+                        samples.push_back(create_sampling_entry(key, value));
+                    }
+                }
+            }
+        }
+        return samples;
+    }
+
+    const size_t segment_count_;
+    std::unique_ptr<segment[]> segments_;
+    std::atomic<int64_t> size_;
+    std::hash<std::shared_ptr<KS>> hasher_;
 };
+
+template<typename K, typename V, typename KS, typename VS>
+constexpr int32_t
+  SampleableConcurrentHashMap<K, V, KS, VS>::MIN_CONCURRENCY_LEVEL;
+
+template<typename K, typename V, typename KS, typename VS>
+constexpr int32_t SampleableConcurrentHashMap<K, V, KS, VS>::MAX_SEGMENT_COUNT;
 } // namespace util
 } // namespace hazelcast
 
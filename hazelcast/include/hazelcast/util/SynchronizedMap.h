@@ -133,6 +133,29 @@ public:
         return nullptr;
     }
 
+    /**
+     * Removes the keys under one lock acquisition.
+     *
+     * @return the previous values of the keys in the order of the keys,
+     * {@code null} for a key which is not in the map.
+     */
+    std::vector<std::shared_ptr<V>> remove_all(const std::vector<K>& keys)
+    {
+        std::vector<std::shared_ptr<V>> removed;
+        removed.reserve(keys.size());
+        std::lock_guard<std::mutex> lg(map_lock_);
+        for (const auto& key : keys) {
+            auto foundIter = internal_map_.find(key);
+            if (foundIter != internal_map_.end()) {
+                removed.push_back(std::move(foundIter->second));
+                internal_map_.erase(foundIter);
+            } else {
+                removed.push_back(nullptr);
+            }
+        }
+        return removed;
+    }
+
     bool remove(const K& key, const std::shared_ptr<V>& value)
     {
         std::lock_guard<std::mutex> lg(map_lock_);
@@ -31,6 +31,7 @@
 #include "hazelcast/client/aws/aws_client.h"
 #include "hazelcast/client/spi/impl/discovery/cloud_discovery.h"
 #include "hazelcast/client/impl/statistics/Statistics.h"
+#include "hazelcast/client/internal/nearcache/impl/invalidation/RepairingTask.h"
 #include "hazelcast/client/impl/hazelcast_client_instance_impl.h"
 #include "hazelcast/client/impl/ClientLockReferenceIdGenerator.h"
 #include "hazelcast/client/spi/impl/ClientInvocationServiceImpl.h"
@@ -179,6 +180,7 @@ hazelcast_client_instance_impl::hazelcast_client_instance_impl(
   , cp_subsystem_(client_context_)
   , sql_service_(client_context_)
   , proxy_session_manager_(client_context_)
+  , raft_group_leader_cache_(client_context_)
 {
     auto& name = client_config_.get_instance_name();
     if (name) {
@@ -233,6 +235,10 @@ hazelcast_client_instance_impl::hazelcast_client_instance_impl(
       new impl::ClientLockReferenceIdGenerator());
 
     statistics_.reset(new statistics::Statistics(client_context_));
+
+    repairing_task_.reset(
+      new internal::nearcache::impl::invalidation::RepairingTask(
+        client_context_));
 }
 
 hazelcast_client_instance_impl::~hazelcast_client_instance_impl()
@@ -255,6 +261,10 @@ hazelcast_client_instance_impl::start()
         lifecycle_service_.shutdown();
         throw;
     }
+
+    if (!client_config_.get_connection_strategy_config().is_async_start()) {
+        preload_near_caches();
+    }
 }
 
 client_config&
@@ -424,6 +434,30 @@ hazelcast_client_instance_impl::initalize_near_cache_manager()
       execution_service_, serialization_service_, *logger_));
 }
 
+void
+hazelcast_client_instance_impl::preload_near_caches()
+{
+    for (const auto& entry : client_config_.get_near_cache_configs()) {
+        const auto& name = entry.first;
+        // the maps of a wildcard or the default config are not known until
+        // they are used, they are pre-loaded when they are created
+        if (!entry.second.get_preloader_config().is_enabled() ||
+            name.find('*') != std::string::npos || name == "default") {
+            continue;
+        }
+
+        try {
+            get_distributed_object<imap>(name).get();
+        } catch (exception::iexception& e) {
+            HZ_LOG(*logger_,
+                   warning,
+                   boost::str(boost::format("Cannot pre-load the Near Cache of "
+                                            "map %1%. %2%") %
+                              name % e.what()));
+        }
+    }
+}
+
 local_endpoint
 hazelcast_client_instance_impl::get_local_endpoint() const
 {
@@ -535,6 +569,49 @@ BaseEventHandler::get_logger() const
 {
     return logger_;
 }
+
+void
+BaseEventHandler::handle_batch(
+  const std::vector<std::shared_ptr<protocol::ClientMessage>>& events,
+  std::chrono::steady_clock::time_point /* first_received_at */)
+{
+    for (const auto& event : events) {
+        handle(*event);
+    }
+}
+
+bool
+BaseEventHandler::enqueue_event(std::shared_ptr<protocol::ClientMessage> event)
+{
+    std::lock_guard<std::mutex> guard(pending_events_lock_);
+    pending_events_.emplace_back(std::chrono::steady_clock::now(),
+                                 std::move(event));
+    if (drain_scheduled_) {
+        return false;
+    }
+    drain_scheduled_ = true;
+    return true;
+}
+
+std::vector<std::shared_ptr<protocol::ClientMessage>>
+BaseEventHandler::drain_events(
+  std::chrono::steady_clock::time_point& first_received_at)
+{
+    std::vector<std::shared_ptr<protocol::ClientMessage>> events;
+    std::lock_guard<std::mutex> guard(pending_events_lock_);
+    if (pending_events_.empty()) {
+        drain_scheduled_ = false;
+        return events;
+    }
+
+    first_received_at = pending_events_.front().first;
+    events.reserve(pending_events_.size());
+    for (auto& event : pending_events_) {
+        events.push_back(std::move(event.second));
+    }
+    pending_events_.clear();
+    return events;
+}
 } // namespace impl
 
 constexpr int address::ID;
@@ -1076,6 +1153,18 @@ client_properties::client_properties(
   , cloud_base_url_(CLOUD_URL_BASE, CLOUD_URL_BASE_DEFAULT)
   , partition_arg_cache_size_(PARTITION_ARGUMENT_CACHE_SIZE,
                               PARTITION_ARGUMENT_CACHE_SIZE_DEFAULT)
+  , io_thread_count_(IO_THREAD_COUNT, IO_THREAD_COUNT_DEFAULT)
+  , io_busy_poll_(IO_BUSY_POLL, IO_BUSY_POLL_DEFAULT)
+  , invocation_inline_completion_(INVOCATION_INLINE_COMPLETION,
+                                  INVOCATION_INLINE_COMPLETION_DEFAULT)
+  , deserialization_chunk_size_(DESERIALIZATION_CHUNK_SIZE,
+                                DESERIALIZATION_CHUNK_SIZE_DEFAULT)
+  , invalidation_max_tolerated_miss_count_(
+      INVALIDATION_MAX_TOLERATED_MISS_COUNT,
+      INVALIDATION_MAX_TOLERATED_MISS_COUNT_DEFAULT)
+  , invalidation_reconciliation_interval_seconds_(
+      INVALIDATION_RECONCILIATION_INTERVAL_SECONDS,
+      INVALIDATION_RECONCILIATION_INTERVAL_SECONDS_DEFAULT)
   , properties_map_(properties)
 {}
 
@@ -1210,6 +1299,42 @@ client_properties::partition_arg_cache_size() const
     return partition_arg_cache_size_;
 }
 
+const client_property&
+client_properties::io_thread_count() const
+{
+    return io_thread_count_;
+}
+
+const client_property&
+client_properties::io_busy_poll() const
+{
+    return io_busy_poll_;
+}
+
+const client_property&
+client_properties::invocation_inline_completion() const
+{
+    return invocation_inline_completion_;
+}
+
+const client_property&
+client_properties::deserialization_chunk_size() const
+{
+    return deserialization_chunk_size_;
+}
+
+const client_property&
+client_properties::invalidation_max_tolerated_miss_count() const
+{
+    return invalidation_max_tolerated_miss_count_;
+}
+
+const client_property&
+client_properties::invalidation_reconciliation_interval_seconds() const
+{
+    return invalidation_reconciliation_interval_seconds_;
+}
+
 namespace exception {
 iexception::iexception(std::string exception_name,
                        std::string source,
@@ -174,6 +174,8 @@ ssl_config::set_cipher_list(const std::string& ciphers)
 
 constexpr int64_t
   client_flake_id_generator_config::DEFAULT_PREFETCH_VALIDITY_MILLIS;
+constexpr int32_t
+  client_flake_id_generator_config::DEFAULT_PREFETCH_LOW_WATER_MARK_PERCENTAGE;
 
 client_flake_id_generator_config::client_flake_id_generator_config(
   const std::string& name)
@@ -181,6 +183,9 @@ client_flake_id_generator_config::client_flake_id_generator_config(
   , prefetch_count_(client_flake_id_generator_config::DEFAULT_PREFETCH_COUNT)
   , prefetch_validity_duration_(
       client_flake_id_generator_config::DEFAULT_PREFETCH_VALIDITY_MILLIS)
+  , prefetch_low_water_mark_percentage_(
+      client_flake_id_generator_config::
+        DEFAULT_PREFETCH_LOW_WATER_MARK_PERCENTAGE)
 {}
 
 const std::string&
@@ -230,6 +235,25 @@ client_flake_id_generator_config::set_prefetch_validity_duration(
     return *this;
 }
 
+int32_t
+client_flake_id_generator_config::get_prefetch_low_water_mark_percentage() const
+{
+    return prefetch_low_water_mark_percentage_;
+}
+
+client_flake_id_generator_config&
+client_flake_id_generator_config::set_prefetch_low_water_mark_percentage(
+  int32_t percentage)
+{
+    std::ostringstream out;
+    out << "prefetch-low-water-mark-percentage must be 0..100, not "
+        << percentage;
+    util::Preconditions::check_true(percentage >= 0 && percentage <= 100,
+                                    out.str());
+    prefetch_low_water_mark_percentage_ = percentage;
+    return *this;
+}
+
 constexpr std::chrono::milliseconds connection_retry_config::INITIAL_BACKOFF;
 constexpr std::chrono::milliseconds connection_retry_config::MAX_BACKOFF;
 constexpr std::chrono::milliseconds
@@ -373,6 +397,23 @@ client_network_config::set_smart_routing(bool smart_routing)
     return *this;
 }
 
+int32_t
+client_network_config::get_connections_per_member() const
+{
+    return connections_per_member_;
+}
+
+client_network_config&
+client_network_config::set_connections_per_member(
+  int32_t connections_per_member)
+{
+    connections_per_member_ = util::Preconditions::check_positive(
+      connections_per_member,
+      "client_network_config::set_connections_per_member: connections per "
+      "member must be positive");
+    return *this;
+}
+
 std::vector<address>
 client_network_config::get_addresses() const
 {
@@ -517,6 +558,8 @@ socket_options::socket_options()
   , reuse_address_(true)
   , linger_seconds_(3)
   , buffer_size_(DEFAULT_BUFFER_SIZE_BYTE)
+  , max_write_batch_size_(DEFAULT_MAX_WRITE_BATCH_SIZE_BYTE)
+  , max_write_batch_buffers_(DEFAULT_MAX_WRITE_BATCH_BUFFERS)
 {}
 
 bool
@@ -584,6 +627,32 @@ socket_options::set_buffer_size_in_bytes(int buffer_size)
     return *this;
 }
 
+int
+socket_options::get_max_write_batch_size_in_bytes() const
+{
+    return max_write_batch_size_;
+}
+
+socket_options&
+socket_options::set_max_write_batch_size_in_bytes(int max_write_batch_size)
+{
+    socket_options::max_write_batch_size_ = max_write_batch_size;
+    return *this;
+}
+
+int
+socket_options::get_max_write_batch_buffers() const
+{
+    return max_write_batch_buffers_;
+}
+
+socket_options&
+socket_options::set_max_write_batch_buffers(int max_write_batch_buffers)
+{
+    socket_options::max_write_batch_buffers_ = max_write_batch_buffers;
+    return *this;
+}
+
 client_aws_config::client_aws_config()
   : enabled_(false)
   , region_("us-east-1")
@@ -823,6 +892,8 @@ eviction_config::eviction_config()
   : size_(DEFAULT_MAX_ENTRY_COUNT)
   , max_size_policy_(DEFAULT_MAX_SIZE_POLICY)
   , eviction_policy_(DEFAULT_EVICTION_POLICY)
+  , admission_policy_(DEFAULT_ADMISSION_POLICY)
+  , heap_budget_megabytes_(0)
 {}
 
 int32_t
@@ -866,6 +937,33 @@ eviction_config::set_eviction_policy(eviction_policy policy)
     return *this;
 }
 
+eviction_config::admission_policy
+eviction_config::get_admission_policy() const
+{
+    return admission_policy_;
+}
+
+eviction_config&
+eviction_config::set_admission_policy(admission_policy policy)
+{
+    this->admission_policy_ = policy;
+    return *this;
+}
+
+int32_t
+eviction_config::get_heap_budget_megabytes() const
+{
+    return heap_budget_megabytes_;
+}
+
+eviction_config&
+eviction_config::set_heap_budget_megabytes(int32_t heap_budget_megabytes)
+{
+    this->heap_budget_megabytes_ = util::Preconditions::check_positive(
+      heap_budget_megabytes, "Heap budget must be positive number!");
+    return *this;
+}
+
 eviction_strategy_type
 eviction_config::get_eviction_strategy_type() const
 {
@@ -879,7 +977,92 @@ operator<<(std::ostream& out, const eviction_config& config)
     out << "EvictionConfig{"
         << "size=" << config.get_size()
         << ", maxSizePolicy=" << config.get_maximum_size_policy()
-        << ", evictionPolicy=" << config.get_eviction_policy() << '}';
+        << ", evictionPolicy=" << config.get_eviction_policy()
+        << ", admissionPolicy=" << config.get_admission_policy()
+        << ", heapBudgetMegabytes=" << config.get_heap_budget_megabytes()
+        << '}';
+
+    return out;
+}
+
+near_cache_preloader_config::near_cache_preloader_config()
+  : enabled_(false)
+  , store_initial_delay_seconds_(DEFAULT_STORE_INITIAL_DELAY_SECONDS)
+  , store_interval_seconds_(DEFAULT_STORE_INTERVAL_SECONDS)
+{}
+
+near_cache_preloader_config::near_cache_preloader_config(
+  const std::string& directory)
+  : near_cache_preloader_config()
+{
+    enabled_ = true;
+    directory_ = directory;
+}
+
+bool
+near_cache_preloader_config::is_enabled() const
+{
+    return enabled_;
+}
+
+near_cache_preloader_config&
+near_cache_preloader_config::set_enabled(bool enabled)
+{
+    this->enabled_ = enabled;
+    return *this;
+}
+
+const std::string&
+near_cache_preloader_config::get_directory() const
+{
+    return directory_;
+}
+
+near_cache_preloader_config&
+near_cache_preloader_config::set_directory(const std::string& directory)
+{
+    this->directory_ = directory;
+    return *this;
+}
+
+int32_t
+near_cache_preloader_config::get_store_initial_delay_seconds() const
+{
+    return store_initial_delay_seconds_;
+}
+
+near_cache_preloader_config&
+near_cache_preloader_config::set_store_initial_delay_seconds(
+  int32_t store_initial_delay_seconds)
+{
+    this->store_initial_delay_seconds_ = util::Preconditions::check_positive(
+      store_initial_delay_seconds,
+      "storeInitialDelaySeconds must be a positive number!");
+    return *this;
+}
+
+int32_t
+near_cache_preloader_config::get_store_interval_seconds() const
+{
+    return store_interval_seconds_;
+}
+
+near_cache_preloader_config&
+near_cache_preloader_config::set_store_interval_seconds(
+  int32_t store_interval_seconds)
+{
+    this->store_interval_seconds_ = util::Preconditions::check_positive(
+      store_interval_seconds, "storeIntervalSeconds must be a positive number!");
+    return *this;
+}
+
+std::ostream&
+operator<<(std::ostream& out, const near_cache_preloader_config& config)
+{
+    out << "NearCachePreloaderConfig{"
+        << "enabled=" << config.enabled_ << ", directory=" << config.directory_
+        << ", storeInitialDelaySeconds=" << config.store_initial_delay_seconds_
+        << ", storeIntervalSeconds=" << config.store_interval_seconds_ << '}';
 
     return out;
 }
@@ -1028,6 +1211,26 @@ near_cache_config::set_eviction_config(const eviction_config& eviction_config)
     return *this;
 }
 
+near_cache_preloader_config&
+near_cache_config::get_preloader_config()
+{
+    return preloader_config_;
+}
+
+const near_cache_preloader_config&
+near_cache_config::get_preloader_config() const
+{
+    return preloader_config_;
+}
+
+near_cache_config&
+near_cache_config::set_preloader_config(
+  const near_cache_preloader_config& preloader_config)
+{
+    this->preloader_config_ = preloader_config;
+    return *this;
+}
+
 std::ostream&
 operator<<(std::ostream& out, const near_cache_config& config)
 {
@@ -1038,7 +1241,7 @@ operator<<(std::ostream& out, const near_cache_config& config)
         << ", inMemoryFormat=" << config.in_memory_format_
         << ", cacheLocalEntries=" << config.cache_local_entries_
         << ", localUpdatePolicy=" << config.local_update_policy_
-        << config.eviction_config_;
+        << config.eviction_config_ << ", " << config.preloader_config_;
     out << '}';
 
     return out;
@@ -1233,6 +1436,12 @@ client_config::get_near_cache_config(const std::string& name) const
     return nullptr;
 }
 
+const std::unordered_map<std::string, config::near_cache_config>&
+client_config::get_near_cache_configs() const
+{
+    return near_cache_config_map_;
+}
+
 client_config&
 client_config::set_network_config(
   const config::client_network_config& network_config)
@@ -14,10 +14,37 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#include <boost/endian/conversion.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/uuid/nil_generator.hpp>
+
 #include "hazelcast/client/internal/nearcache/impl/KeyStateMarkerImpl.h"
+#include "hazelcast/client/internal/nearcache/impl/invalidation/MetaDataContainer.h"
+#include "hazelcast/client/internal/nearcache/impl/invalidation/RepairingHandler.h"
+#include "hazelcast/client/internal/nearcache/impl/invalidation/RepairingTask.h"
+#include "hazelcast/client/internal/nearcache/impl/maxsize/UsedHeapNearCacheMaxSizeChecker.h"
+#include "hazelcast/client/internal/nearcache/impl/preloader/NearCachePreloader.h"
 #include "hazelcast/client/internal/nearcache/NearCacheManager.h"
 #include "hazelcast/util/HashUtil.h"
+#include "hazelcast/util/Preconditions.h"
+#include "hazelcast/client/client_properties.h"
 #include "hazelcast/client/internal/eviction/EvictionChecker.h"
+#include "hazelcast/client/internal/eviction/impl/admission/FrequencySketch.h"
+#include "hazelcast/client/protocol/codec/codecs.h"
+#include "hazelcast/client/spi/ClientContext.h"
+#include "hazelcast/client/spi/impl/ClientClusterServiceImpl.h"
+#include "hazelcast/client/spi/impl/ClientInvocation.h"
+#include "hazelcast/client/spi/impl/ClientPartitionServiceImpl.h"
+#include "hazelcast/client/spi/lifecycle_service.h"
+#include "hazelcast/client/monitor/impl/NearCacheStatsImpl.h"
+#include "hazelcast/client/serialization/pimpl/data.h"
+#include "hazelcast/logger.h"
 
 namespace hazelcast {
 namespace client {
@@ -160,6 +187,717 @@ KeyStateMarkerImpl::get_slot(const serialization::pimpl::data& key)
     return util::HashUtil::hash_to_index(key.get_partition_hash(), mark_count_);
 }
 
+namespace invalidation {
+MetaDataContainer::MetaDataContainer()
+  : uuid_(boost::uuids::nil_uuid())
+  , sequence_(0)
+  , stale_sequence_(0)
+  , missed_sequence_count_(0)
+{}
+
+boost::uuids::uuid
+MetaDataContainer::get_uuid() const
+{
+    std::lock_guard<std::mutex> guard(uuid_lock_);
+    return uuid_;
+}
+
+void
+MetaDataContainer::set_uuid(boost::uuids::uuid uuid)
+{
+    std::lock_guard<std::mutex> guard(uuid_lock_);
+    uuid_ = uuid;
+}
+
+bool
+MetaDataContainer::cas_uuid(boost::uuids::uuid expected,
+                            boost::uuids::uuid uuid)
+{
+    std::lock_guard<std::mutex> guard(uuid_lock_);
+    if (uuid_ != expected) {
+        return false;
+    }
+    uuid_ = uuid;
+    return true;
+}
+
+int64_t
+MetaDataContainer::get_sequence() const
+{
+    return sequence_;
+}
+
+void
+MetaDataContainer::set_sequence(int64_t sequence)
+{
+    sequence_ = sequence;
+}
+
+bool
+MetaDataContainer::cas_sequence(int64_t expected, int64_t sequence)
+{
+    return sequence_.compare_exchange_strong(expected, sequence);
+}
+
+void
+MetaDataContainer::reset_sequence()
+{
+    sequence_ = 0;
+}
+
+int64_t
+MetaDataContainer::get_stale_sequence() const
+{
+    return stale_sequence_;
+}
+
+bool
+MetaDataContainer::cas_stale_sequence(int64_t expected, int64_t stale_sequence)
+{
+    return stale_sequence_.compare_exchange_strong(expected, stale_sequence);
+}
+
+void
+MetaDataContainer::reset_stale_sequence()
+{
+    stale_sequence_ = 0;
+}
+
+int64_t
+MetaDataContainer::get_missed_sequence_count() const
+{
+    return missed_sequence_count_;
+}
+
+int64_t
+MetaDataContainer::add_and_get_missed_sequence_count(
+  int64_t missed_sequence_count)
+{
+    return missed_sequence_count_ += missed_sequence_count;
+}
+
+RepairingHandler::RepairingHandler(std::string name,
+                                   int32_t partition_count,
+                                   int32_t name_partition_id)
+  : name_(std::move(name))
+  , partition_count_(partition_count)
+  , name_partition_id_(name_partition_id)
+  , meta_data_containers_(new MetaDataContainer[partition_count])
+{}
+
+const std::string&
+RepairingHandler::get_name() const
+{
+    return name_;
+}
+
+int32_t
+RepairingHandler::get_partition_count() const
+{
+    return partition_count_;
+}
+
+void
+RepairingHandler::handle(const boost::optional<serialization::pimpl::data>& key,
+                         boost::uuids::uuid partition_uuid,
+                         int64_t sequence)
+{
+    // map wide invalidations are sequenced on the partition of the map name
+    auto partition_id = key ? get_partition_id(*key) : name_partition_id_;
+    check_or_repair_uuid(partition_id, partition_uuid);
+    check_or_repair_sequence(partition_id, sequence);
+}
+
+void
+RepairingHandler::check_or_repair_uuid(int32_t partition_id,
+                                       boost::uuids::uuid uuid)
+{
+    auto& meta_data = get_meta_data_container(partition_id);
+    while (true) {
+        auto previous = meta_data.get_uuid();
+        if (previous == uuid) {
+            break;
+        }
+        if (meta_data.cas_uuid(previous, uuid)) {
+            // the records stamped with the previous uuid are stale now
+            meta_data.reset_sequence();
+            meta_data.reset_stale_sequence();
+            break;
+        }
+    }
+}
+
+void
+RepairingHandler::check_or_repair_sequence(int32_t partition_id,
+                                           int64_t next_sequence,
+                                           bool via_anti_entropy)
+{
+    auto& meta_data = get_meta_data_container(partition_id);
+    while (true) {
+        auto current_sequence = meta_data.get_sequence();
+        if (current_sequence >= next_sequence) {
+            break;
+        }
+        if (meta_data.cas_sequence(current_sequence, next_sequence)) {
+            auto sequence_diff = next_sequence - current_sequence;
+            // an event carries the next sequence itself, hence only the
+            // sequences in between are missed
+            auto missed = via_anti_entropy ? sequence_diff : sequence_diff - 1;
+            if (missed > 0) {
+                meta_data.add_and_get_missed_sequence_count(missed);
+            }
+            break;
+        }
+    }
+}
+
+void
+RepairingHandler::update_last_known_stale_sequence(MetaDataContainer& meta_data)
+{
+    while (true) {
+        auto last_received_sequence = meta_data.get_sequence();
+        auto last_known_stale_sequence = meta_data.get_stale_sequence();
+        if (last_known_stale_sequence >= last_received_sequence ||
+            meta_data.cas_stale_sequence(last_known_stale_sequence,
+                                         last_received_sequence)) {
+            break;
+        }
+    }
+}
+
+void
+RepairingHandler::init_uuid(int32_t partition_id, boost::uuids::uuid uuid)
+{
+    get_meta_data_container(partition_id).set_uuid(uuid);
+}
+
+void
+RepairingHandler::init_sequence(int32_t partition_id, int64_t sequence)
+{
+    get_meta_data_container(partition_id).set_sequence(sequence);
+}
+
+int32_t
+RepairingHandler::get_partition_id(const serialization::pimpl::data& key)
+{
+    return util::HashUtil::hash_to_index(key.get_partition_hash(),
+                                         partition_count_);
+}
+
+MetaDataContainer&
+RepairingHandler::get_meta_data_container(int32_t partition_id)
+{
+    return meta_data_containers_[partition_id];
+}
+
+constexpr std::chrono::seconds RepairingTask::RUN_PERIOD;
+
+RepairingTask::RepairingTask(spi::ClientContext& client_context)
+  : client_context_(client_context)
+  , logger_(client_context.get_logger())
+{
+    auto& properties = client_context.get_client_properties();
+    max_tolerated_miss_count_ = util::Preconditions::check_not_negative(
+      properties.get_long(properties.invalidation_max_tolerated_miss_count()),
+      "max tolerated miss count cannot be < 0");
+    reconciliation_interval_ =
+      std::chrono::seconds(util::Preconditions::check_not_negative(
+        properties.get_long(
+          properties.invalidation_reconciliation_interval_seconds()),
+        "reconciliation interval seconds cannot be < 0"));
+}
+
+std::shared_ptr<RepairingHandler>
+RepairingTask::register_and_get_handler(const std::string& name)
+{
+    auto handler = handlers_.get(name);
+    if (handler) {
+        return handler;
+    }
+
+    auto& partition_service = client_context_.get_partition_service();
+    handler = std::make_shared<RepairingHandler>(
+      name,
+      partition_service.get_partition_count(),
+      partition_service.get_partition_id(
+        client_context_.get_serialization_service().to_data(name)));
+    auto existing = handlers_.put_if_absent(name, handler);
+    if (existing) {
+        return existing;
+    }
+
+    try {
+        fetch_metadata({ handler }, true).get();
+    } catch (exception::iexception& e) {
+        HZ_LOG(logger_,
+               warning,
+               boost::str(boost::format("Cannot fetch the initial invalidation "
+                                        "metadata of Near Cache %1%. %2%") %
+                          name % e.what()));
+    }
+
+    bool expected = false;
+    if (started_.compare_exchange_strong(expected, true)) {
+        last_anti_entropy_run_ = std::chrono::steady_clock::now();
+        timer_ =
+          client_context_.get_client_execution_service()
+            .schedule_with_repetition([this]() { run(); }, RUN_PERIOD, RUN_PERIOD);
+    }
+
+    return handler;
+}
+
+void
+RepairingTask::deregister_handler(const std::string& name)
+{
+    handlers_.remove(name);
+}
+
+void
+RepairingTask::shutdown()
+{
+    if (timer_) {
+        boost::system::error_code ignored;
+        timer_->cancel(ignored);
+    }
+}
+
+int64_t
+RepairingTask::get_max_tolerated_miss_count() const
+{
+    return max_tolerated_miss_count_;
+}
+
+std::chrono::seconds
+RepairingTask::get_reconciliation_interval() const
+{
+    return reconciliation_interval_;
+}
+
+void
+RepairingTask::run()
+{
+    if (!client_context_.get_lifecycle_service().is_running()) {
+        return;
+    }
+
+    try {
+        fix_sequence_gaps();
+        if (is_anti_entropy_needed()) {
+            run_anti_entropy();
+        }
+    } catch (std::exception& e) {
+        HZ_LOG(logger_,
+               finest,
+               boost::str(boost::format("Near Cache repairing failed. %1%") %
+                          e.what()));
+    }
+}
+
+void
+RepairingTask::fix_sequence_gaps()
+{
+    for (auto& handler : handlers_.values()) {
+        if (is_above_max_tolerated_miss_count(*handler)) {
+            update_last_known_stale_sequences(*handler);
+        }
+    }
+}
+
+bool
+RepairingTask::is_above_max_tolerated_miss_count(
+  RepairingHandler& handler) const
+{
+    int64_t total_miss_count = 0;
+    for (int32_t partition = 0; partition < handler.get_partition_count();
+         ++partition) {
+        total_miss_count += handler.get_meta_data_container(partition)
+                              .get_missed_sequence_count();
+        if (total_miss_count > max_tolerated_miss_count_) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void
+RepairingTask::update_last_known_stale_sequences(RepairingHandler& handler)
+{
+    // only the partitions with missed sequences are invalidated
+    for (int32_t partition = 0; partition < handler.get_partition_count();
+         ++partition) {
+        auto& meta_data = handler.get_meta_data_container(partition);
+        auto miss_count = meta_data.get_missed_sequence_count();
+        if (miss_count != 0) {
+            meta_data.add_and_get_missed_sequence_count(-miss_count);
+            handler.update_last_known_stale_sequence(meta_data);
+        }
+    }
+}
+
+bool
+RepairingTask::is_anti_entropy_needed()
+{
+    if (reconciliation_interval_.count() == 0) {
+        return false;
+    }
+
+    return std::chrono::steady_clock::now() - last_anti_entropy_run_ >=
+           reconciliation_interval_;
+}
+
+void
+RepairingTask::run_anti_entropy()
+{
+    bool expected = false;
+    if (!anti_entropy_in_progress_.compare_exchange_strong(expected, true)) {
+        return;
+    }
+
+    last_anti_entropy_run_ = std::chrono::steady_clock::now();
+    auto handlers = handlers_.values();
+    if (handlers.empty()) {
+        anti_entropy_in_progress_ = false;
+        return;
+    }
+
+    fetch_metadata(handlers, false)
+      .then(boost::launch::sync, [this](boost::future<void> f) {
+          try {
+              f.get();
+          } catch (std::exception& e) {
+              HZ_LOG(logger_,
+                     finest,
+                     boost::str(boost::format("Cannot fetch the invalidation "
+                                              "metadata. %1%") %
+                                e.what()));
+          }
+          anti_entropy_in_progress_ = false;
+      });
+}
+
+boost::future<void>
+RepairingTask::fetch_metadata(
+  const std::vector<std::shared_ptr<RepairingHandler>>& handlers,
+  bool init)
+{
+    std::vector<std::string> names;
+    names.reserve(handlers.size());
+    for (auto& handler : handlers) {
+        names.push_back(handler->get_name());
+    }
+
+    std::vector<boost::future<void>> futures;
+    for (auto& m :
+         client_context_.get_client_cluster_service().get_member_list()) {
+        if (m.is_lite_member()) {
+            continue;
+        }
+
+        auto request =
+          protocol::codec::map_fetchnearcacheinvalidationmetadata_encode(
+            names, m.get_uuid());
+        futures.push_back(
+          spi::impl::ClientInvocation::create(
+            client_context_, request, "", m.get_uuid())
+            ->invoke()
+            .then(boost::launch::sync,
+                  [handlers, init](boost::future<protocol::ClientMessage> f) {
+                      auto response = f.get();
+                      apply_metadata(response, handlers, init);
+                  }));
+    }
+
+    return boost::when_all(futures.begin(), futures.end())
+      .then(boost::launch::sync,
+            [](boost::future<std::vector<boost::future<void>>> f) {
+                for (auto& result : f.get()) {
+                    result.get();
+                }
+            });
+}
+
+void
+RepairingTask::apply_metadata(
+  protocol::ClientMessage& response,
+  const std::vector<std::shared_ptr<RepairingHandler>>& handlers,
+  bool init)
+{
+    auto name_partition_sequences = response.get_first_var_sized_field<
+      std::unordered_map<std::string,
+                         std::vector<std::pair<int32_t, int64_t>>>>();
+    auto partition_uuids =
+      response.get<std::vector<std::pair<int32_t, boost::uuids::uuid>>>();
+
+    for (auto& handler : handlers) {
+        auto partition_count = handler->get_partition_count();
+        // a member returns the metadata of the partitions it owns
+        for (auto& partition_uuid : partition_uuids) {
+            if (partition_uuid.first < 0 ||
+                partition_uuid.first >= partition_count) {
+                continue;
+            }
+            if (init) {
+                handler->init_uuid(partition_uuid.first, partition_uuid.second);
+            } else {
+                handler->check_or_repair_uuid(partition_uuid.first,
+                                              partition_uuid.second);
+            }
+        }
+
+        auto sequences = name_partition_sequences->find(handler->get_name());
+        if (sequences == name_partition_sequences->end()) {
+            continue;
+        }
+        for (auto& partition_sequence : sequences->second) {
+            if (partition_sequence.first < 0 ||
+                partition_sequence.first >= partition_count) {
+                continue;
+            }
+            if (init) {
+                handler->init_sequence(partition_sequence.first,
+                                       partition_sequence.second);
+            } else {
+                handler->check_or_repair_sequence(
+                  partition_sequence.first, partition_sequence.second, true);
+            }
+        }
+    }
+}
+} // namespace invalidation
+
+namespace maxsize {
+constexpr int64_t UsedHeapNearCacheMaxSizeChecker::ONE_MEGABYTE;
+
+UsedHeapNearCacheMaxSizeChecker::UsedHeapNearCacheMaxSizeChecker(
+  int64_t max_size_in_bytes,
+  std::shared_ptr<monitor::impl::NearCacheStatsImpl> near_cache_stats)
+  : max_size_in_bytes_(max_size_in_bytes)
+  , near_cache_stats_(std::move(near_cache_stats))
+{}
+
+bool
+UsedHeapNearCacheMaxSizeChecker::is_reached_to_max_size() const
+{
+    return near_cache_stats_->get_owned_entry_memory_cost() >=
+           max_size_in_bytes_;
+}
+
+int64_t
+UsedHeapNearCacheMaxSizeChecker::get_max_size_in_bytes() const
+{
+    return max_size_in_bytes_;
+}
+} // namespace maxsize
+
+namespace preloader {
+constexpr int32_t NearCachePreloader::MAGIC;
+constexpr int32_t NearCachePreloader::FILE_FORMAT_VERSION;
+
+namespace {
+void
+write_int32(std::ostream& out, int32_t value)
+{
+    int32_t little_endian_value = boost::endian::native_to_little(value);
+    out.write(reinterpret_cast<const char*>(&little_endian_value),
+              sizeof(little_endian_value));
+}
+
+int32_t
+read_int32(const byte* bytes)
+{
+    int32_t value;
+    std::memcpy(&value, bytes, sizeof(value));
+    return boost::endian::little_to_native(value);
+}
+} // namespace
+
+NearCachePreloader::NearCachePreloader(
+  const std::string& near_cache_name,
+  const client::config::near_cache_preloader_config& preloader_config,
+  std::shared_ptr<monitor::impl::NearCacheStatsImpl> near_cache_stats,
+  logger& lg)
+  : near_cache_name_(near_cache_name)
+  , store_file_(preloader_config.get_directory().empty()
+                  ? get_store_file_name(near_cache_name)
+                  : preloader_config.get_directory() + "/" +
+                      get_store_file_name(near_cache_name))
+  , tmp_store_file_(store_file_ + ".tmp")
+  , near_cache_stats_(std::move(near_cache_stats))
+  , logger_(lg)
+{}
+
+void
+NearCachePreloader::store_keys(
+  const std::vector<std::shared_ptr<serialization::pimpl::data>>& keys)
+{
+    std::lock_guard<std::mutex> guard(store_lock_);
+    auto start = std::chrono::steady_clock::now();
+    int64_t written_bytes = 0;
+    int32_t key_count = 0;
+    try {
+        write_keys(keys, written_bytes, key_count);
+        if (std::rename(tmp_store_file_.c_str(), store_file_.c_str()) != 0) {
+            // rename does not replace an existing file on all the platforms
+            std::remove(store_file_.c_str());
+            if (std::rename(tmp_store_file_.c_str(), store_file_.c_str()) !=
+                0) {
+                BOOST_THROW_EXCEPTION(exception::io(
+                  "NearCachePreloader::store_keys",
+                  (boost::format("Cannot rename %1% to %2%") %
+                   tmp_store_file_ % store_file_)
+                    .str()));
+            }
+        }
+    } catch (std::exception& e) {
+        std::remove(tmp_store_file_.c_str());
+        near_cache_stats_->add_persistence_failure(e.what());
+        HZ_LOG(logger_,
+               warning,
+               boost::str(boost::format("Cannot store the keys of Near Cache "
+                                        "%1% to %2%. %3%") %
+                          near_cache_name_ % store_file_ % e.what()));
+        return;
+    }
+
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+                      std::chrono::steady_clock::now() - start)
+                      .count();
+    near_cache_stats_->add_persistence(
+      duration, static_cast<int32_t>(written_bytes), key_count);
+    HZ_LOG(logger_,
+           finest,
+           boost::str(boost::format("Stored %1% keys of Near Cache %2% to %3% "
+                                    "in %4% ms") %
+                      key_count % near_cache_name_ % store_file_ % duration));
+}
+
+void
+NearCachePreloader::write_keys(
+  const std::vector<std::shared_ptr<serialization::pimpl::data>>& keys,
+  int64_t& written_bytes,
+  int32_t& key_count)
+{
+    std::ofstream out(tmp_store_file_, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        BOOST_THROW_EXCEPTION(
+          exception::io("NearCachePreloader::write_keys",
+                        "Cannot open " + tmp_store_file_ + " for writing"));
+    }
+
+    write_int32(out, MAGIC);
+    write_int32(out, FILE_FORMAT_VERSION);
+    written_bytes = 2 * sizeof(int32_t);
+    for (const auto& key : keys) {
+        if (!key) {
+            continue;
+        }
+        const auto& bytes = key->to_byte_array();
+        write_int32(out, static_cast<int32_t>(bytes.size()));
+        out.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+        written_bytes += sizeof(int32_t) + bytes.size();
+        ++key_count;
+    }
+
+    out.flush();
+    if (!out) {
+        BOOST_THROW_EXCEPTION(
+          exception::io("NearCachePreloader::write_keys",
+                        "Cannot write the keys to " + tmp_store_file_));
+    }
+}
+
+std::vector<serialization::pimpl::data>
+NearCachePreloader::load_keys()
+{
+    std::vector<serialization::pimpl::data> keys;
+    if (!std::ifstream(store_file_).good()) {
+        HZ_LOG(logger_,
+               finest,
+               boost::str(boost::format("No keys to pre-load for Near Cache "
+                                        "%1%, %2% does not exist") %
+                          near_cache_name_ % store_file_));
+        return keys;
+    }
+
+    try {
+        boost::interprocess::file_mapping mapping(
+          store_file_.c_str(), boost::interprocess::read_only);
+        boost::interprocess::mapped_region region(
+          mapping, boost::interprocess::read_only);
+        auto begin = static_cast<const byte*>(region.get_address());
+        auto size = region.get_size();
+        if (size < 2 * sizeof(int32_t) || read_int32(begin) != MAGIC ||
+            read_int32(begin + sizeof(int32_t)) != FILE_FORMAT_VERSION) {
+            HZ_LOG(logger_,
+                   warning,
+                   boost::str(boost::format("Cannot pre-load Near Cache %1%, "
+                                            "%2% is not a valid key file") %
+                              near_cache_name_ % store_file_));
+            return keys;
+        }
+
+        size_t offset = 2 * sizeof(int32_t);
+        while (offset + sizeof(int32_t) <= size) {
+            int32_t length = read_int32(begin + offset);
+            offset += sizeof(int32_t);
+            if (length < static_cast<int32_t>(
+                           serialization::pimpl::data::DATA_OVERHEAD) ||
+                offset + length > size) {
+                HZ_LOG(logger_,
+                       warning,
+                       boost::str(boost::format("The key file %1% of Near "
+                                                "Cache %2% is truncated, %3% "
+                                                "keys are loaded") %
+                                  store_file_ % near_cache_name_ %
+                                  keys.size()));
+                break;
+            }
+            keys.emplace_back(
+              std::vector<byte>(begin + offset, begin + offset + length));
+            offset += length;
+        }
+    } catch (std::exception& e) {
+        HZ_LOG(logger_,
+               warning,
+               boost::str(boost::format("Cannot load the keys of Near Cache "
+                                        "%1% from %2%. %3%") %
+                          near_cache_name_ % store_file_ % e.what()));
+    }
+    return keys;
+}
+
+const std::string&
+NearCachePreloader::get_store_file() const
+{
+    return store_file_;
+}
+
+std::string
+NearCachePreloader::get_store_file_name(const std::string& near_cache_name)
+{
+    std::string file_name = "nearCache-" + near_cache_name + ".store";
+    for (auto& c : file_name) {
+        switch (c) {
+            case ':':
+            case '*':
+            case '"':
+            case '?':
+            case '<':
+            case '>':
+            case '|':
+            case '/':
+            case '\\':
+                c = '_';
+                break;
+            default:
+                break;
+        }
+    }
+    return file_name;
+}
+} // namespace preloader
+
 } // namespace impl
 } // namespace nearcache
 
@@ -173,6 +911,117 @@ EvictAlways::is_eviction_required() const
 
 const std::unique_ptr<EvictionChecker> EvictionChecker::EVICT_ALWAYS =
   std::unique_ptr<EvictionChecker>(new EvictAlways());
+
+namespace impl {
+namespace admission {
+constexpr int32_t FrequencySketch::MAX_FREQUENCY;
+constexpr int FrequencySketch::DEPTH;
+constexpr size_t FrequencySketch::MIN_WIDTH;
+constexpr size_t FrequencySketch::MAX_WIDTH;
+constexpr int FrequencySketch::COUNTERS_PER_WORD;
+const uint64_t FrequencySketch::SEEDS[DEPTH] = { 0xc3a5c85c97cb3127ULL,
+                                                 0xb492b66fbe98f273ULL,
+                                                 0x9ae16a3b2f90404fULL,
+                                                 0xcbf29ce484222325ULL };
+
+FrequencySketch::FrequencySketch(int64_t expected_size)
+  : width_(width_for(expected_size))
+  , words_per_row_(width_ / COUNTERS_PER_WORD)
+  , sample_size_(10 * static_cast<int64_t>(width_))
+  , table_(new std::atomic<uint64_t>[DEPTH * words_per_row_])
+  , additions_(0)
+{
+    for (size_t i = 0; i < DEPTH * words_per_row_; ++i) {
+        table_[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+void
+FrequencySketch::increment(int32_t hash)
+{
+    uint64_t spread_hash =
+      static_cast<uint32_t>(hash) * 0x9e3779b97f4a7c15ULL;
+    bool added = false;
+    for (int row = 0; row < DEPTH; ++row) {
+        int shift;
+        auto& word = word_of(spread_hash, row, shift);
+        uint64_t current = word.load(std::memory_order_relaxed);
+        while (((current >> shift) & 0xfULL) <
+               static_cast<uint64_t>(MAX_FREQUENCY)) {
+            if (word.compare_exchange_weak(current,
+                                           current + (1ULL << shift),
+                                           std::memory_order_relaxed)) {
+                added = true;
+                break;
+            }
+        }
+    }
+
+    // only the thread which reaches the sample size ages the counters
+    if (added && additions_.fetch_add(1, std::memory_order_relaxed) + 1 ==
+                   sample_size_) {
+        reset();
+    }
+}
+
+int32_t
+FrequencySketch::frequency(int32_t hash) const
+{
+    uint64_t spread_hash =
+      static_cast<uint32_t>(hash) * 0x9e3779b97f4a7c15ULL;
+    int32_t frequency = MAX_FREQUENCY;
+    for (int row = 0; row < DEPTH; ++row) {
+        int shift;
+        auto& word = word_of(spread_hash, row, shift);
+        int32_t count = static_cast<int32_t>(
+          (word.load(std::memory_order_relaxed) >> shift) & 0xfULL);
+        frequency = (std::min)(frequency, count);
+    }
+    return frequency;
+}
+
+size_t
+FrequencySketch::get_width() const
+{
+    return width_;
+}
+
+size_t
+FrequencySketch::width_for(int64_t expected_size)
+{
+    size_t width = MIN_WIDTH;
+    while (width < MAX_WIDTH && static_cast<int64_t>(width) < expected_size) {
+        width <<= 1;
+    }
+    return width;
+}
+
+std::atomic<uint64_t>&
+FrequencySketch::word_of(uint64_t spread_hash, int row, int& shift) const
+{
+    uint64_t h = (spread_hash + SEEDS[row]) * SEEDS[row];
+    h += h >> 32;
+    size_t index = static_cast<size_t>(h) & (width_ - 1);
+    shift = static_cast<int>(index % COUNTERS_PER_WORD) * 4;
+    return table_[row * words_per_row_ + index / COUNTERS_PER_WORD];
+}
+
+void
+FrequencySketch::reset()
+{
+    for (size_t i = 0; i < DEPTH * words_per_row_; ++i) {
+        // halves each of the 16 counters of the word
+        uint64_t current = table_[i].load(std::memory_order_relaxed);
+        while (!table_[i].compare_exchange_weak(
+          current,
+          (current >> 1) & 0x7777777777777777ULL,
+          std::memory_order_relaxed)) {
+        }
+    }
+    additions_.fetch_sub(sample_size_ / 2, std::memory_order_relaxed);
+}
+} // namespace admission
+} // namespace impl
 } // namespace eviction
 } // namespace internal
 
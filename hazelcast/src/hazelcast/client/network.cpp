@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <cstdlib>
 #include <unordered_set>
 
@@ -27,6 +28,7 @@
 #include "hazelcast/client/connection/ClientConnectionManagerImpl.h"
 #include "hazelcast/client/connection/ConnectionListener.h"
 #include "hazelcast/client/connection/Connection.h"
+#include "hazelcast/client/connection/correlation_table.h"
 #include "hazelcast/client/spi/ClientContext.h"
 #include "hazelcast/client/spi/impl/ClientExecutionServiceImpl.h"
 #include "hazelcast/client/serialization/serialization.h"
@@ -78,6 +80,11 @@ ClientConnectionManagerImpl::ClientConnectionManagerImpl(
                       .get_reconnect_mode())
   , smart_routing_enabled_(
       client.get_client_config().get_network_config().is_smart_routing())
+  , connections_per_member_(smart_routing_enabled_
+                              ? client.get_client_config()
+                                  .get_network_config()
+                                  .get_connections_per_member()
+                              : 1)
   , client_uuid_(client.random_uuid())
   , authentication_timeout_(
       boost::chrono::milliseconds(heartbeat_.get_heartbeat_timeout().count()))
@@ -114,12 +121,23 @@ ClientConnectionManagerImpl::start()
         return false;
     }
 
-    io_context_.reset(new boost::asio::io_context);
+    auto& properties = client_.get_client_properties();
+    auto io_thread_count = (std::max)(
+      properties.get_integer(properties.io_thread_count()), 1);
+    auto busy_poll = properties.get_boolean(properties.io_busy_poll());
+
+    // each io_context is run by a single thread
+    std::vector<boost::asio::io_context*> io_contexts;
+    for (int i = 0; i < io_thread_count; ++i) {
+        io_contexts_.emplace_back(new boost::asio::io_context(1));
+        io_guards_.emplace_back(
+          new boost::asio::io_context::work(*io_contexts_.back()));
+        io_contexts.push_back(io_contexts_.back().get());
+    }
     io_resolver_.reset(
-      new boost::asio::ip::tcp::resolver(io_context_->get_executor()));
+      new boost::asio::ip::tcp::resolver(io_contexts_[0]->get_executor()));
     socket_factory_.reset(new internal::socket::SocketFactory(
-      client_, *io_context_, *io_resolver_));
-    io_guard_.reset(new boost::asio::io_context::work(*io_context_));
+      client_, std::move(io_contexts), *io_resolver_));
 
     if (!socket_factory_->start()) {
         return false;
@@ -127,7 +145,20 @@ ClientConnectionManagerImpl::start()
 
     socket_interceptor_ = client_.get_client_config().get_socket_interceptor();
 
-    io_thread_ = std::thread([=]() { io_context_->run(); });
+    for (auto& io : io_contexts_) {
+        auto io_context = io.get();
+        io_threads_.emplace_back([io_context, busy_poll]() {
+            if (!busy_poll) {
+                io_context->run();
+                return;
+            }
+
+            // poll stops the io_context once it runs out of work
+            while (!io_context->stopped()) {
+                io_context->poll();
+            }
+        });
+    }
 
     executor_.reset(
       new hazelcast::util::hz_thread_pool(EXECUTOR_CORE_POOL_SIZE));
@@ -180,7 +211,7 @@ ClientConnectionManagerImpl::shutdown()
     heartbeat_.shutdown();
 
     // close connections
-    for (auto& connection : active_connections_.values()) {
+    for (auto& connection : get_all_connections()) {
         // prevent any exceptions
         util::IOUtil::close_resource(connection.get(),
                                      "Hazelcast client is shutting down");
@@ -189,13 +220,21 @@ ClientConnectionManagerImpl::shutdown()
     spi::impl::ClientExecutionServiceImpl::shutdown_thread_pool(
       executor_.get());
 
-    // release the guard so that the io thread can stop gracefully
-    io_guard_.reset();
-    io_thread_.join();
+    // release the guards so that the io threads can stop gracefully
+    io_guards_.clear();
+    for (auto& io_thread : io_threads_) {
+        io_thread.join();
+    }
+    io_threads_.clear();
 
     connection_listeners_.clear();
     active_connections_.clear();
     active_connection_ids_.clear();
+    {
+        std::lock_guard<std::mutex> guard(extra_connections_mutex_);
+        extra_connections_.clear();
+    }
+    client_.get_partition_service().refresh_routing_table();
 }
 
 std::shared_ptr<Connection>
@@ -223,6 +262,108 @@ ClientConnectionManagerImpl::get_connection(boost::uuids::uuid uuid)
     return active_connections_.get(uuid);
 }
 
+std::vector<std::shared_ptr<Connection>>
+ClientConnectionManagerImpl::get_member_connections(boost::uuids::uuid uuid)
+{
+    std::vector<std::shared_ptr<Connection>> connections;
+    auto connection = active_connections_.get(uuid);
+    if (!connection) {
+        return connections;
+    }
+
+    connections.emplace_back(std::move(connection));
+    if (connections_per_member_ > 1) {
+        std::lock_guard<std::mutex> guard(extra_connections_mutex_);
+        auto it = extra_connections_.find(uuid);
+        if (it != extra_connections_.end()) {
+            connections.insert(
+              connections.end(), it->second.begin(), it->second.end());
+        }
+    }
+    return connections;
+}
+
+std::shared_ptr<Connection>
+ClientConnectionManagerImpl::next_member_connection(
+  const std::shared_ptr<Connection>& connection)
+{
+    if (connections_per_member_ == 1) {
+        return connection;
+    }
+
+    std::lock_guard<std::mutex> guard(extra_connections_mutex_);
+    auto it = extra_connections_.find(connection->get_remote_uuid());
+    if (it == extra_connections_.end() || it->second.empty()) {
+        return connection;
+    }
+
+    auto index = round_robin_index_++ % (it->second.size() + 1);
+    if (index == 0) {
+        return connection;
+    }
+    return it->second[index - 1];
+}
+
+std::vector<std::shared_ptr<Connection>>
+ClientConnectionManagerImpl::get_all_connections()
+{
+    return active_connection_ids_.values();
+}
+
+void
+ClientConnectionManagerImpl::connect_to_member(const member& m)
+{
+    auto connection = get_or_connect(m);
+    // bounded, the translated address may lead to another member
+    for (int32_t i = 1; i < connections_per_member_ &&
+                        client_.get_lifecycle_service().is_running() &&
+                        !has_all_connections(m.get_uuid());
+         ++i) {
+        connect(translate(m));
+    }
+}
+
+bool
+ClientConnectionManagerImpl::has_all_connections(boost::uuids::uuid member_uuid)
+{
+    if (!active_connections_.get(member_uuid)) {
+        return false;
+    }
+    if (connections_per_member_ == 1) {
+        return true;
+    }
+
+    std::lock_guard<std::mutex> guard(extra_connections_mutex_);
+    auto it = extra_connections_.find(member_uuid);
+    return it != extra_connections_.end() &&
+           static_cast<int32_t>(it->second.size()) + 1 >=
+             connections_per_member_;
+}
+
+bool
+ClientConnectionManagerImpl::add_extra_connection(
+  boost::uuids::uuid member_uuid,
+  const std::shared_ptr<Connection>& connection)
+{
+    if (connections_per_member_ == 1) {
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(extra_connections_mutex_);
+        auto& connections = extra_connections_[member_uuid];
+        if (static_cast<int32_t>(connections.size()) + 1 >=
+            connections_per_member_) {
+            return false;
+        }
+        connections.push_back(connection);
+    }
+
+    active_connection_ids_.put(connection->get_connection_id(), connection);
+    client_.get_partition_service().refresh_routing_table();
+    return true;
+}
+
 ClientConnectionManagerImpl::auth_response
 ClientConnectionManagerImpl::authenticate_on_cluster(
   std::shared_ptr<Connection>& connection)
@@ -486,7 +627,7 @@ ClientConnectionManagerImpl::connect_to_all_members()
         }
 
         if (client_.get_lifecycle_service().is_running() &&
-            !get_connection(m.get_uuid()) &&
+            !has_all_connections(m.get_uuid()) &&
             connecting_members_.get_or_put_if_absent(m, nullptr).second) {
             // submit a task for this address only if there is no other pending
             // connection attempt for it
@@ -497,8 +638,8 @@ ClientConnectionManagerImpl::connect_to_all_members()
                       if (!client_.get_lifecycle_service().is_running()) {
                           return;
                       }
-                      if (!get_connection(member_to_connect.get_uuid())) {
-                          get_or_connect(member_to_connect);
+                      if (!has_all_connections(member_to_connect.get_uuid())) {
+                          connect_to_member(member_to_connect);
                       }
                       connecting_members_.remove(member_to_connect);
                   } catch (std::exception&) {
@@ -629,8 +770,50 @@ ClientConnectionManagerImpl::on_connection_close(
     {
         std::lock_guard<std::recursive_mutex> guard(client_state_mutex_);
 
+        bool is_extra_connection = false;
+        std::vector<std::shared_ptr<Connection>> member_extra_connections;
+        if (connections_per_member_ > 1) {
+            std::lock_guard<std::mutex> extra_guard(extra_connections_mutex_);
+            auto it = extra_connections_.find(member_uuid);
+            if (it != extra_connections_.end()) {
+                auto& connections = it->second;
+                auto extra_it =
+                  std::find(connections.begin(), connections.end(), connection);
+                if (extra_it != connections.end()) {
+                    is_extra_connection = true;
+                    connections.erase(extra_it);
+                } else if (active_connections_.get(member_uuid) ==
+                           connection) {
+                    // the extra connections go away with the member connection
+                    member_extra_connections.swap(connections);
+                }
+                if (connections.empty()) {
+                    extra_connections_.erase(it);
+                }
+            }
+        }
+
+        if (is_extra_connection) {
+            active_connection_ids_.remove(connection->get_connection_id());
+            client_.get_partition_service().refresh_routing_table();
+            HZ_LOG(logger_,
+                   finest,
+                   boost::str(boost::format("Removed extra connection to "
+                                            "endpoint: %1%, connection: %2%") %
+                              *endpoint % *connection));
+            return;
+        }
+        for (const auto& extra_connection : member_extra_connections) {
+            active_connection_ids_.remove(extra_connection->get_connection_id());
+        }
+
         if (active_connections_.remove(member_uuid, connection)) {
             active_connection_ids_.remove(connection->get_connection_id());
+            client_.get_partition_service().refresh_routing_table();
+            for (const auto& extra_connection : member_extra_connections) {
+                extra_connection->close(
+                  "The connection to the member is closed");
+            }
 
             HZ_LOG(logger_,
                    info,
@@ -780,6 +963,16 @@ ClientConnectionManagerImpl::on_authenticated(
 
         auto existing_connection =
           active_connections_.get(response.member_uuid);
+        if (existing_connection &&
+            add_extra_connection(response.member_uuid, connection)) {
+            HZ_LOG(logger_,
+                   info,
+                   boost::str(boost::format("Opened extra connection to "
+                                            "server %1%:%2%. %3%") %
+                              response.server_address % response.member_uuid %
+                              *connection));
+            return check_authenticated_connection(connection);
+        }
         if (existing_connection) {
             connection->close(
               (boost::format(
@@ -814,6 +1007,7 @@ ClientConnectionManagerImpl::on_authenticated(
         auto connections_empty = active_connections_.empty();
         active_connection_ids_.put(connection->get_connection_id(), connection);
         active_connections_.put(response.member_uuid, connection);
+        client_.get_partition_service().refresh_routing_table();
         if (connections_empty) {
             // The first connection that opens a connection to the new cluster
             // should set `clusterId`. This one will initiate
@@ -874,9 +1068,16 @@ ClientConnectionManagerImpl::on_authenticated(
         fire_connection_added_event(connection);
     }
 
+    return check_authenticated_connection(connection);
+}
+
+std::shared_ptr<Connection>
+ClientConnectionManagerImpl::check_authenticated_connection(
+  const std::shared_ptr<Connection>& connection)
+{
     // It could happen that this connection is already closed and
-    // on_connection_close() is called even before the synchronized block
-    // above is executed. In this case, now we have a closed but registered
+    // on_connection_close() is called even before the connection is
+    // registered. In this case, now we have a closed but registered
     // connection. We do a final check here to remove this connection
     // if needed.
     if (!connection->is_alive()) {
@@ -1012,7 +1213,7 @@ ClientConnectionManagerImpl::connect_to_all_cluster_members()
          client_.get_client_cluster_service().get_member_list()) {
 
         try {
-            get_or_connect(member);
+            connect_to_member(member);
         } catch (std::exception&) {
             // ignore
         }
@@ -1038,10 +1239,20 @@ ClientConnectionManagerImpl::notify_backup(int64_t call_id)
     if (!connection) {
         return;
     }
-    boost::asio::post(connection->get_socket().get_executor(), [=]() {
-        auto invocation_it = connection->invocations.find(call_id);
-        if (invocation_it != connection->invocations.end()) {
-            invocation_it->second->notify_backup();
+    auto& executor = connection->get_socket().get_executor();
+    if (executor.running_in_this_thread()) {
+        // the ack is received on the connection of the invocation
+        auto invocation = connection->invocations.find(call_id);
+        if (invocation) {
+            (*invocation)->notify_backup();
+        }
+        return;
+    }
+
+    boost::asio::post(executor, [=]() {
+        auto invocation = connection->invocations.find(call_id);
+        if (invocation) {
+            (*invocation)->notify_backup();
         }
     });
 }
@@ -1141,45 +1352,110 @@ ClientConnectionManagerImpl::connection_for_sql(
     return first_connection;
 }
 
-ReadHandler::ReadHandler(Connection& connection, size_t buffer_size)
-  : buffer(new char[buffer_size])
-  , byte_buffer(buffer, buffer_size)
-  , builder_(connection)
-  , last_read_time_(std::chrono::steady_clock::now().time_since_epoch())
-{}
+constexpr size_t correlation_table::DEFAULT_CAPACITY;
 
-ReadHandler::~ReadHandler()
+correlation_table::correlation_table(size_t initial_capacity)
 {
-    delete[] buffer;
+    size_t capacity = 1;
+    while (capacity < initial_capacity) {
+        capacity <<= 1;
+    }
+    slots_.resize(capacity);
+    mask_ = capacity - 1;
 }
 
-void
-ReadHandler::handle()
+bool
+correlation_table::insert(
+  int64_t correlation_id,
+  std::shared_ptr<spi::impl::ClientInvocation> invocation)
 {
-    last_read_time_ = std::chrono::steady_clock::now().time_since_epoch();
+    if (size_ + 1 > slots_.size() - slots_.size() / 4) {
+        grow();
+    }
 
-    if (byte_buffer.position() == 0)
-        return;
+    auto& s = slots_[index_of(correlation_id)];
+    if (s.invocation) {
+        return false;
+    }
 
-    byte_buffer.flip();
+    s.correlation_id = correlation_id;
+    s.invocation = std::move(invocation);
+    ++size_;
+    return true;
+}
 
-    // it is important to check the on_data return value since there may be left
-    // data less than a message header size, and this may cause an infinite
-    // loop.
-    while (byte_buffer.has_remaining() && builder_.on_data(byte_buffer)) {
+const std::shared_ptr<spi::impl::ClientInvocation>*
+correlation_table::find(int64_t correlation_id) const
+{
+    auto& s = slots_[index_of(correlation_id)];
+    if (!s.invocation || s.correlation_id != correlation_id) {
+        return nullptr;
     }
 
-    if (byte_buffer.has_remaining()) {
-        byte_buffer.compact();
-    } else {
-        byte_buffer.clear();
+    return &s.invocation;
+}
+
+bool
+correlation_table::erase(int64_t correlation_id)
+{
+    auto& s = slots_[index_of(correlation_id)];
+    if (!s.invocation || s.correlation_id != correlation_id) {
+        return false;
     }
+
+    s.invocation.reset();
+    --size_;
+    return true;
 }
 
-std::chrono::steady_clock::time_point
-ReadHandler::get_last_read_time() const
+size_t
+correlation_table::size() const
 {
-    return std::chrono::steady_clock::time_point{ last_read_time_ };
+    return size_;
+}
+
+size_t
+correlation_table::capacity() const
+{
+    return slots_.size();
+}
+
+int32_t
+correlation_table::call_id_of(int64_t correlation_id)
+{
+    struct correlation_id_type
+    {
+        int32_t connnection_id;
+        int32_t call_id;
+    };
+    union
+    {
+        int64_t id;
+        correlation_id_type composed_id;
+    } c_id_union;
+    c_id_union.id = correlation_id;
+    return c_id_union.composed_id.call_id;
+}
+
+size_t
+correlation_table::index_of(int64_t correlation_id) const
+{
+    return static_cast<uint32_t>(call_id_of(correlation_id)) & mask_;
+}
+
+void
+correlation_table::grow()
+{
+    // the call ids in the table have distinct low bits for the current mask,
+    // hence they also have distinct slots with the wider mask
+    std::vector<slot> old_slots(slots_.size() * 2);
+    old_slots.swap(slots_);
+    mask_ = slots_.size() - 1;
+    for (auto& s : old_slots) {
+        if (s.invocation) {
+            slots_[index_of(s.correlation_id)] = std::move(s);
+        }
+    }
 }
 
 bool
@@ -1240,9 +1516,10 @@ Connection::schedule_periodic_backup_cleanup(
           if (ec) {
               return;
           }
-          for (const auto& it : this_connection->invocations) {
-              it.second->detect_and_handle_backup_timeout(backup_timeout);
-          }
+          this_connection->invocations.for_each(
+            [&](const std::shared_ptr<spi::impl::ClientInvocation>& invocation) {
+                invocation->detect_and_handle_backup_timeout(backup_timeout);
+            });
 
           schedule_periodic_backup_cleanup(backup_timeout, this_connection);
       }));
@@ -1297,11 +1574,12 @@ Connection::close(const std::string& reason, std::exception_ptr cause)
       thisConnection);
 
     boost::asio::post(socket_->get_executor(), [=]() {
-        for (auto& invocationEntry : thisConnection->invocations) {
-            invocationEntry.second->notify_exception(std::make_exception_ptr(
-              boost::enable_current_exception(exception::target_disconnected(
-                "Connection::close", thisConnection->get_close_reason()))));
-        }
+        thisConnection->invocations.for_each(
+          [&](const std::shared_ptr<spi::impl::ClientInvocation>& invocation) {
+              invocation->notify_exception(std::make_exception_ptr(
+                boost::enable_current_exception(exception::target_disconnected(
+                  "Connection::close", thisConnection->get_close_reason()))));
+          });
     });
 }
 
@@ -1329,8 +1607,8 @@ Connection::handle_client_message(
   const std::shared_ptr<protocol::ClientMessage>& message)
 {
     auto correlationId = message->get_correlation_id();
-    auto invocationIterator = invocations.find(correlationId);
-    if (invocationIterator == invocations.end()) {
+    auto registered_invocation = invocations.find(correlationId);
+    if (!registered_invocation) {
         HZ_LOG(logger_,
                warning,
                boost::str(boost::format("No invocation for callId:  %1%. "
@@ -1338,7 +1616,7 @@ Connection::handle_client_message(
                           correlationId % *message));
         return;
     }
-    auto invocation = invocationIterator->second;
+    auto invocation = *registered_invocation;
     auto flags = message->get_header_flags();
     if (message->is_flag_set(flags,
                              protocol::ClientMessage::BACKUP_EVENT_FLAG)) {
@@ -1578,7 +1856,7 @@ HeartbeatManager::start()
           }
 
           for (auto& connection :
-               client_connection_manager_.get_active_connections()) {
+               client_connection_manager_.get_all_connections()) {
               check_connection(connection);
           }
       },
@@ -1721,10 +1999,10 @@ wait_strategy::sleep()
 namespace internal {
 namespace socket {
 SocketFactory::SocketFactory(spi::ClientContext& client_context,
-                             boost::asio::io_context& io,
+                             std::vector<boost::asio::io_context*> io_contexts,
                              boost::asio::ip::tcp::resolver& resolver)
   : client_context_(client_context)
-  , io_(io)
+  , io_contexts_(std::move(io_contexts))
   , io_resolver_(resolver)
 {}
 
@@ -1800,10 +2078,12 @@ std::unique_ptr<hazelcast::client::socket>
 SocketFactory::create(const address& address,
                       std::chrono::milliseconds& connect_timeout_in_millis)
 {
+    auto& io = *io_contexts_[next_io_context_++ % io_contexts_.size()];
+
 #ifdef HZ_BUILD_WITH_SSL
     if (ssl_context_.get()) {
         return std::unique_ptr<hazelcast::client::socket>(
-          new internal::socket::SSLSocket(io_,
+          new internal::socket::SSLSocket(io,
                                           *ssl_context_,
                                           address,
                                           client_context_.get_client_config()
@@ -1815,7 +2095,7 @@ SocketFactory::create(const address& address,
 #endif
 
     return std::unique_ptr<hazelcast::client::socket>(
-      new internal::socket::TcpSocket(io_,
+      new internal::socket::TcpSocket(io,
                                       address,
                                       client_context_.get_client_config()
                                         .get_network_config()
@@ -19,6 +19,7 @@
 #include <boost/uuid/uuid_io.hpp>
 
 #include "hazelcast/client/protocol/ClientMessage.h"
+#include "hazelcast/client/protocol/frame_buffer_pool.h"
 #include <hazelcast/client/protocol/ClientProtocolErrorCodes.h>
 #include "hazelcast/util/ByteBuffer.h"
 #include "hazelcast/util/Util.h"
@@ -54,11 +55,120 @@ const ClientMessage::frame_header_type ClientMessage::END_FRAME{
     ClientMessage::END_DATA_STRUCTURE_FLAG
 };
 
+constexpr size_t frame_buffer_pool::SIZE_CLASS_COUNT;
+
+frame_buffer_pool&
+frame_buffer_pool::instance()
+{
+    // never destroyed, messages may outlive the static objects at exit
+    static frame_buffer_pool* pool = new frame_buffer_pool();
+    return *pool;
+}
+
+frame_buffer_pool::frame_buffer_pool()
+{
+    size_t buffer_size = ClientMessage::EXPECTED_DATA_BLOCK_SIZE;
+    size_t max_pooled = 4096;
+    for (auto& c : classes_) {
+        c.buffer_size = buffer_size;
+        c.max_pooled = max_pooled;
+        buffer_size *= 4;
+        max_pooled /= 8;
+    }
+}
+
+std::vector<byte>
+frame_buffer_pool::acquire(size_t min_capacity)
+{
+    std::vector<byte> buffer;
+    for (auto& c : classes_) {
+        if (c.buffer_size < min_capacity) {
+            continue;
+        }
+
+        {
+            std::lock_guard<std::mutex> guard(c.mutex);
+            if (!c.free_buffers.empty()) {
+                buffer = std::move(c.free_buffers.back());
+                c.free_buffers.pop_back();
+            }
+        }
+
+        if (buffer.capacity() >= min_capacity) {
+            ++hits_;
+            return buffer;
+        }
+
+        ++misses_;
+        buffer.reserve(c.buffer_size);
+        return buffer;
+    }
+
+    ++misses_;
+    buffer.reserve(min_capacity);
+    return buffer;
+}
+
+void
+frame_buffer_pool::release(std::vector<byte>&& buffer)
+{
+    auto capacity = buffer.capacity();
+    if (capacity > 4 * classes_[SIZE_CLASS_COUNT - 1].buffer_size) {
+        return;
+    }
+
+    // the largest class that the block can serve
+    for (size_t i = SIZE_CLASS_COUNT; i > 0; --i) {
+        auto& c = classes_[i - 1];
+        if (c.buffer_size > capacity) {
+            continue;
+        }
+
+        buffer.clear();
+        std::lock_guard<std::mutex> guard(c.mutex);
+        if (c.free_buffers.size() < c.max_pooled) {
+            c.free_buffers.emplace_back(std::move(buffer));
+        }
+        return;
+    }
+}
+
+int64_t
+frame_buffer_pool::hits() const
+{
+    return hits_;
+}
+
+int64_t
+frame_buffer_pool::misses() const
+{
+    return misses_;
+}
+
+int64_t
+frame_buffer_pool::pooled_count() const
+{
+    int64_t count = 0;
+    for (auto& c : classes_) {
+        std::lock_guard<std::mutex> guard(c.mutex);
+        count += static_cast<int64_t>(c.free_buffers.size());
+    }
+    return count;
+}
+
 ClientMessage::ClientMessage()
   : retryable_(false)
   , contains_serialized_data_in_request_(false)
 {}
 
+ClientMessage::~ClientMessage()
+{
+    auto& pool = frame_buffer_pool::instance();
+    for (auto& block : data_buffer_) {
+        pool.release(std::move(block));
+    }
+}
+
 ClientMessage::ClientMessage(size_t initial_frame_size, bool is_fingle_frame)
   : retryable_(false)
   , contains_serialized_data_in_request_(false)
@@ -122,6 +232,22 @@ ClientMessage::set(
     }
 }
 
+template<>
+void
+ClientMessage::set(const std::vector<std::pair<int32_t, int32_t>>& values,
+                   bool is_final)
+{
+    auto* f =
+      reinterpret_cast<frame_header_type*>(wr_ptr(SIZE_OF_FRAME_LENGTH_AND_FLAGS));
+    f->frame_len =
+      values.size() * (INT32_SIZE + INT32_SIZE) + SIZE_OF_FRAME_LENGTH_AND_FLAGS;
+    f->flags = is_final ? IS_FINAL_FLAG : DEFAULT_FLAGS;
+    for (auto& p : values) {
+        set(p.first);
+        set(p.second);
+    }
+}
+
 template<>
 void
 ClientMessage::set(const std::vector<boost::uuids::uuid>& values, bool is_final)
@@ -290,8 +416,11 @@ ClientMessage::append(std::shared_ptr<ClientMessage> msg)
     // no need to double check if correlation ids match here,
     // since we make sure that this is guaranteed at the caller that they are
     // matching !
-    data_buffer_.insert(
-      data_buffer_.end(), msg->data_buffer_.begin(), msg->data_buffer_.end());
+    // the fragment is not used after it is appended, take over its blocks
+    data_buffer_.insert(data_buffer_.end(),
+                        std::make_move_iterator(msg->data_buffer_.begin()),
+                        std::make_move_iterator(msg->data_buffer_.end()));
+    msg->data_buffer_.clear();
 }
 
 bool
@@ -851,18 +980,20 @@ sql_page_codec::decode(ClientMessage& msg,
 
     auto column_type_ids = msg.get<std::vector<int32_t>>();
 
-    using column = std::vector<boost::any>;
+    using column = sql::sql_page::column;
 
     using namespace sql;
 
     auto number_of_columns = column_type_ids.size();
-    std::vector<column> columns(number_of_columns);
+    std::vector<column> columns;
+    columns.reserve(number_of_columns);
     std::vector<sql_column_type> column_types(number_of_columns);
 
     for (std::size_t i = 0; i < number_of_columns; ++i) {
         auto column_type = static_cast<sql_column_type>(column_type_ids[i]);
         column_types[i] = column_type;
-        columns[i] = sql_page_codec::decode_column_values(msg, column_type);
+        columns.push_back(
+          sql_page_codec::decode_column_values(msg, column_type));
     }
 
     msg.fast_forward_to_end_frame();
@@ -873,69 +1004,76 @@ sql_page_codec::decode(ClientMessage& msg,
     page->construct_rows();
     return page;
 }
-std::vector<boost::any>
+sql::sql_page::column
 sql_page_codec::decode_column_values(ClientMessage& msg,
                                      sql::sql_column_type column_type)
 {
+    using column = sql::sql_page::column;
+
     switch (column_type) {
         case sql::sql_column_type::varchar:
-            return to_vector_of_any(
+            return column::of_strings(
+              typeid(std::string),
               msg.get<std::vector<boost::optional<std::string>>>());
         case sql::sql_column_type::boolean:
-            return to_vector_of_any(
+            return column::of(
               builtin::list_cn_fixed_size_codec::decode<bool>(msg));
         case sql::sql_column_type::tinyint:
-            return to_vector_of_any(
+            return column::of(
               builtin::list_cn_fixed_size_codec::decode<byte>(msg));
         case sql::sql_column_type::smallint:
-            return to_vector_of_any(
+            return column::of(
               builtin::list_cn_fixed_size_codec::decode<int16_t>(msg));
         case sql::sql_column_type::integer:
-            return to_vector_of_any(
+            return column::of(
               builtin::list_cn_fixed_size_codec::decode<int32_t>(msg));
         case sql::sql_column_type::bigint:
-            return to_vector_of_any(
+            return column::of(
               builtin::list_cn_fixed_size_codec::decode<int64_t>(msg));
         case sql::sql_column_type::real:
-            return to_vector_of_any(
+            return column::of(
               builtin::list_cn_fixed_size_codec::decode<float>(msg));
         case sql::sql_column_type::double_:
-            return to_vector_of_any(
+            return column::of(
               builtin::list_cn_fixed_size_codec::decode<double>(msg));
         case sql::sql_column_type::date:
-            return to_vector_of_any(
-              builtin::list_cn_fixed_size_codec::decode<local_date>(
-                msg));
+            return column::of(
+              builtin::list_cn_fixed_size_codec::decode<local_date>(msg));
         case sql::sql_column_type::time:
-            return to_vector_of_any(
-              builtin::list_cn_fixed_size_codec::decode<local_time>(
-                msg));
+            return column::of(
+              builtin::list_cn_fixed_size_codec::decode<local_time>(msg));
         case sql::sql_column_type::timestamp:
-            return to_vector_of_any(
-              builtin::list_cn_fixed_size_codec::decode<
-                local_date_time>(msg));
+            return column::of(
+              builtin::list_cn_fixed_size_codec::decode<local_date_time>(
+                msg));
         case sql::sql_column_type::timestamp_with_timezone:
-            return to_vector_of_any(
-              builtin::list_cn_fixed_size_codec::decode<
-                offset_date_time>(msg));
-        case sql::sql_column_type::decimal:
-            return to_vector_of_any(
-              builtin::list_cn_fixed_size_codec::decode<big_decimal>(
+            return column::of(
+              builtin::list_cn_fixed_size_codec::decode<offset_date_time>(
                 msg));
+        case sql::sql_column_type::decimal:
+            return column::of(
+              builtin::list_cn_fixed_size_codec::decode<big_decimal>(msg));
         case sql::sql_column_type::null: {
             msg.skip_frame_header_bytes();
 
             auto size = msg.get<int32_t>();
-            return
-              std::vector<boost::any>(static_cast<size_t>(size));
+            return column::of_nulls(static_cast<size_t>(size));
         }
         case sql::sql_column_type::object:
-            return to_vector_of_any(
+            return column::of(
               msg.get<std::vector<
                 boost::optional<serialization::pimpl::data>>>());
-        case sql::sql_column_type::json:
-            return to_vector_of_any(
-              msg.get<std::vector<boost::optional<hazelcast_json_value>>>());
+        case sql::sql_column_type::json: {
+            auto values =
+              msg.get<std::vector<boost::optional<hazelcast_json_value>>>();
+            std::vector<boost::optional<std::string>> strings(values.size());
+            for (std::size_t i = 0; i < values.size(); ++i) {
+                if (values[i]) {
+                    strings[i] = values[i]->to_string();
+                }
+            }
+            return column::of_strings(typeid(hazelcast_json_value), strings);
+        }
         default:
             throw exception::illegal_state(
               "ClientMessage::get<sql::sql_page>",
@@ -943,7 +1081,6 @@ sql_page_codec::decode_column_values(ClientMessage& msg,
                static_cast<int32_t>(column_type))
                 .str());
     }
-
 }
 
 } // namespace builtin
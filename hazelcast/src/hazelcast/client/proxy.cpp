@@ -16,6 +16,9 @@
 
 #include <unordered_set>
 #include <atomic>
+#include <mutex>
+
+#include <boost/asio/post.hpp>
 
 #include "hazelcast/client/impl/ClientLockReferenceIdGenerator.h"
 #include "hazelcast/client/proxy/PNCounterImpl.h"
@@ -23,6 +26,9 @@
 #include "hazelcast/client/impl/hazelcast_client_instance_impl.h"
 #include "hazelcast/client/proxy/flake_id_generator_impl.h"
 #include "hazelcast/client/spi/impl/listener/listener_service_impl.h"
+#include "hazelcast/client/spi/impl/ClientInvocationServiceImpl.h"
+#include "hazelcast/client/spi/impl/ClientExecutionServiceImpl.h"
+#include "hazelcast/util/hz_thread_pool.h"
 #include "hazelcast/client/topic/impl/TopicEventHandlerImpl.h"
 #include "hazelcast/client/client_config.h"
 #include "hazelcast/client/map/data_entry_view.h"
@@ -30,6 +36,7 @@
 #include "hazelcast/client/impl/vector_clock.h"
 #include "hazelcast/client/internal/partition/strategy/StringPartitioningStrategy.h"
 #include "hazelcast/util/Util.h"
+#include "hazelcast/util/Preconditions.h"
 #include "hazelcast/client/topic/reliable_listener.h"
 #include "hazelcast/client/proxy/ITopicImpl.h"
 #include "hazelcast/client/proxy/ReplicatedMapImpl.h"
@@ -1002,27 +1009,53 @@ IListImpl::ListListenerMessageCodec::encode_remove_request(
 }
 
 flake_id_generator_impl::Block::Block(IdBatch&& id_batch,
-                                      std::chrono::milliseconds validity)
+                                      std::chrono::milliseconds validity,
+                                      int32_t low_water_mark)
   : id_batch_(id_batch)
-  , invalid_since_(std::chrono::steady_clock::now() + validity)
+  , invalid_since_(validity.count() > 0
+                     ? std::chrono::steady_clock::now() + validity
+                     : std::chrono::steady_clock::time_point::max())
   , num_returned_(0)
+  , prefetch_index_(
+      low_water_mark > 0
+        ? (std::max)(id_batch_.get_batch_size() - low_water_mark, 0)
+        : -1)
 {}
 
-int64_t
-flake_id_generator_impl::Block::next()
+bool
+flake_id_generator_impl::Block::reserve(int32_t count,
+                                        int64_t& base,
+                                        bool& low_water_reached)
 {
+    low_water_reached = false;
     if (invalid_since_ <= std::chrono::steady_clock::now()) {
-        return INT64_MIN;
+        return false;
     }
     int32_t index;
     do {
         index = num_returned_;
-        if (index == id_batch_.get_batch_size()) {
-            return INT64_MIN;
+        if (count > id_batch_.get_batch_size() - index) {
+            return false;
         }
-    } while (!num_returned_.compare_exchange_strong(index, index + 1));
+    } while (!num_returned_.compare_exchange_strong(index, index + count));
 
-    return id_batch_.get_base() + index * id_batch_.get_increment();
+    base = id_batch_.get_base() + index * id_batch_.get_increment();
+    low_water_reached =
+      index <= prefetch_index_ && prefetch_index_ < index + count;
+    return true;
+}
+
+bool
+flake_id_generator_impl::Block::has_remaining(int32_t count) const
+{
+    return invalid_since_ > std::chrono::steady_clock::now() &&
+           count <= id_batch_.get_batch_size() - num_returned_;
+}
+
+int64_t
+flake_id_generator_impl::Block::get_increment() const
+{
+    return id_batch_.get_increment();
 }
 
 flake_id_generator_impl::IdBatch::IdIterator
@@ -1063,6 +1096,9 @@ flake_id_generator_impl::IdBatch::end()
 flake_id_generator_impl::IdBatch::IdIterator
 flake_id_generator_impl::IdBatch::iterator()
 {
+    if (batch_size_ <= 0) {
+        return end();
+    }
     return flake_id_generator_impl::IdBatch::IdIterator(
       base_, increment_, batch_size_);
 }
@@ -1100,12 +1136,11 @@ flake_id_generator_impl::IdBatch::IdIterator::IdIterator()
 flake_id_generator_impl::IdBatch::IdIterator&
 flake_id_generator_impl::IdBatch::IdIterator::operator++()
 {
-    if (remaining_ == 0) {
-        return flake_id_generator_impl::IdBatch::end();
+    if (--remaining_ <= 0) {
+        *this = flake_id_generator_impl::IdBatch::end();
+        return *this;
     }
 
-    --remaining_;
-
     base2_ += increment_;
 
     return *this;
@@ -1122,39 +1157,168 @@ flake_id_generator_impl::flake_id_generator_impl(
       context->get_client_config().find_flake_id_generator_config(object_name);
     batch_size_ = config->get_prefetch_count();
     validity_ = config->get_prefetch_validity_duration();
+    low_water_mark_ = static_cast<int32_t>(
+      static_cast<int64_t>(batch_size_) *
+      config->get_prefetch_low_water_mark_percentage() / 100);
+    if (low_water_mark_ == 0 &&
+        config->get_prefetch_low_water_mark_percentage() > 0) {
+        low_water_mark_ = 1;
+    }
 }
 
-int64_t
-flake_id_generator_impl::new_id_internal()
+boost::future<int64_t>
+flake_id_generator_impl::new_id()
+{
+    int64_t id, increment;
+    if (try_reserve(1, id, increment)) {
+        return boost::make_ready_future(id);
+    }
+
+    return next_block(1)
+      .then(boost::launch::sync,
+            [=](boost::future<void> f) {
+                f.get();
+                return new_id();
+            })
+      .unwrap();
+}
+
+boost::future<flake_id_generator_impl::IdBatch>
+flake_id_generator_impl::new_ids(int32_t count)
+{
+    std::ostringstream out;
+    out << "count must be 1.."
+        << config::client_flake_id_generator_config::MAXIMUM_PREFETCH_COUNT
+        << ", not " << count;
+    util::Preconditions::check_true(
+      count > 0 &&
+        count <=
+          config::client_flake_id_generator_config::MAXIMUM_PREFETCH_COUNT,
+      out.str());
+
+    if (count > batch_size_) {
+        // would never fit into a prefetched block
+        return new_id_batch(count);
+    }
+
+    int64_t base, increment;
+    if (try_reserve(count, base, increment)) {
+        return boost::make_ready_future(IdBatch(base, increment, count));
+    }
+
+    return next_block(count)
+      .then(boost::launch::sync,
+            [=](boost::future<void> f) {
+                f.get();
+                return new_ids(count);
+            })
+      .unwrap();
+}
+
+bool
+flake_id_generator_impl::try_reserve(int32_t count,
+                                     int64_t& base,
+                                     int64_t& increment)
 {
     auto b = block_.load();
-    if (b) {
-        int64_t res = b->next();
-        if (res != INT64_MIN) {
-            return res;
-        }
+    bool low_water_reached;
+    if (!b || !b->reserve(count, base, low_water_reached)) {
+        return false;
     }
 
-    throw std::overflow_error("");
+    increment = b->get_increment();
+    if (low_water_reached) {
+        prefetch();
+    }
+    return true;
 }
 
-boost::future<int64_t>
-flake_id_generator_impl::new_id()
+boost::future<void>
+flake_id_generator_impl::next_block(int32_t count)
+{
+    std::unique_lock<std::mutex> guard(lock_);
+    auto current = block_.load();
+    if (current && current->has_remaining(count)) {
+        // another caller already moved on to a new block
+        return boost::make_ready_future();
+    }
+
+    if (next_block_ && next_block_->has_remaining(count)) {
+        block_.store(std::move(next_block_));
+        next_block_.reset();
+        return boost::make_ready_future();
+    }
+
+    // the prefetched block, if any, is expired
+    next_block_.reset();
+    return refill(guard).then(boost::launch::sync,
+                              [](boost::shared_future<void> f) { f.get(); });
+}
+
+void
+flake_id_generator_impl::prefetch()
+{
+    std::unique_lock<std::mutex> guard(lock_);
+    if (next_block_) {
+        return;
+    }
+
+    refill(guard);
+}
+
+boost::shared_future<void>
+flake_id_generator_impl::refill(std::unique_lock<std::mutex>& guard)
 {
+    if (refill_) {
+        // single flight, join the request in progress
+        return *refill_;
+    }
+
+    auto promise = std::make_shared<boost::promise<void>>();
+    refill_ = promise->get_future().share();
+    auto result = *refill_;
+
+    // the request is sent without the lock, its continuation may run inline
+    guard.unlock();
     try {
-        return boost::make_ready_future(new_id_internal());
-    } catch (std::overflow_error&) {
-        return new_id_batch(batch_size_)
+        new_id_batch(batch_size_)
           .then(boost::launch::sync,
                 [=](boost::future<flake_id_generator_impl::IdBatch> f) {
-                    auto newBlock =
-                      boost::make_shared<Block>(f.get(), validity_);
-                    auto value = newBlock->next();
-                    auto b = block_.load();
-                    block_.compare_exchange_strong(b, newBlock);
-                    return value;
+                    complete_refill(*promise, std::move(f));
                 });
+    } catch (...) {
+        complete_refill(
+          *promise,
+          boost::make_exceptional_future<flake_id_generator_impl::IdBatch>(
+            boost::current_exception()));
     }
+
+    return result;
+}
+
+void
+flake_id_generator_impl::complete_refill(
+  boost::promise<void>& promise,
+  boost::future<flake_id_generator_impl::IdBatch> batch)
+{
+    boost::shared_ptr<Block> block;
+    try {
+        block = boost::make_shared<Block>(batch.get(), validity_, low_water_mark_);
+    } catch (...) {
+        {
+            std::lock_guard<std::mutex> guard(lock_);
+            refill_.reset();
+        }
+        promise.set_exception(boost::current_exception());
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        next_block_ = std::move(block);
+        refill_.reset();
+    }
+    promise.set_value();
 }
 
 boost::future<flake_id_generator_impl::IdBatch>
@@ -1382,8 +1546,93 @@ SerializingProxy::SerializingProxy(spi::ClientContext& context,
   , partition_service_(context.get_partition_service())
   , object_name_(object_name)
   , client_context_(context)
+  , inline_completion_(context.get_invocation_service().is_inline_completion())
+  , deserialization_chunk_size_(static_cast<size_t>((std::max)(
+      context.get_client_properties().get_integer(
+        context.get_client_properties().deserialization_chunk_size()),
+      0)))
 {}
 
+size_t
+SerializingProxy::deserialization_chunk_count(size_t count) const
+{
+    if (deserialization_chunk_size_ == 0 || count <= deserialization_chunk_size_) {
+        return 1;
+    }
+    return (count + deserialization_chunk_size_ - 1) /
+           deserialization_chunk_size_;
+}
+
+boost::future<void>
+SerializingProxy::run_chunked(
+  size_t count,
+  std::function<void(size_t, size_t, size_t)> convert_chunk)
+{
+    struct chunked_state
+    {
+        explicit chunked_state(size_t chunk_count)
+          : remaining(chunk_count)
+        {}
+
+        std::atomic<size_t> remaining;
+        std::mutex error_mutex;
+        std::exception_ptr error;
+        boost::promise<void> promise;
+    };
+
+    auto chunk_count = deserialization_chunk_count(count);
+    auto state = std::make_shared<chunked_state>(chunk_count);
+    auto result = state->promise.get_future();
+    auto chunk_size = deserialization_chunk_size_ == 0
+                        ? count
+                        : deserialization_chunk_size_;
+    auto run_chunk = [state, convert_chunk, chunk_size, count](size_t chunk) {
+        try {
+            auto begin = chunk * chunk_size;
+            convert_chunk(chunk, begin, (std::min)(begin + chunk_size, count));
+        } catch (...) {
+            std::lock_guard<std::mutex> guard(state->error_mutex);
+            if (!state->error) {
+                state->error = std::current_exception();
+            }
+        }
+        if (--state->remaining == 0) {
+            if (state->error) {
+                state->promise.set_exception(state->error);
+            } else {
+                state->promise.set_value();
+            }
+        }
+    };
+
+    auto& user_executor =
+      client_context_.get_client_execution_service().get_user_executor();
+    for (size_t chunk = 0; chunk + 1 < chunk_count; ++chunk) {
+        if (user_executor.closed()) {
+            run_chunk(chunk);
+        } else {
+            boost::asio::post(user_executor.get_executor(),
+                              [run_chunk, chunk]() { run_chunk(chunk); });
+        }
+    }
+    // the calling thread takes its share as well
+    run_chunk(chunk_count - 1);
+
+    return result;
+}
+
+void
+SerializingProxy::set_inline_completion(bool inline_completion)
+{
+    inline_completion_ = inline_completion;
+}
+
+bool
+SerializingProxy::is_inline_completion() const
+{
+    return inline_completion_;
+}
+
 int
 SerializingProxy::get_partition_id(const serialization::pimpl::data& key)
 {
@@ -1395,12 +1644,13 @@ SerializingProxy::invoke_on_partition(protocol::ClientMessage& request,
                                       int partition_id)
 {
     try {
-        return spi::impl::ClientInvocation::create(
-                 client_context_,
-                 std::make_shared<protocol::ClientMessage>(std::move(request)),
-                 object_name_,
-                 partition_id)
-          ->invoke();
+        auto invocation = spi::impl::ClientInvocation::create(
+          client_context_,
+          std::make_shared<protocol::ClientMessage>(std::move(request)),
+          object_name_,
+          partition_id);
+        invocation->set_inline_completion(inline_completion_);
+        return invocation->invoke();
     } catch (exception::iexception&) {
         util::exception_util::rethrow(std::current_exception());
         return boost::make_ready_future(protocol::ClientMessage(0));
@@ -1411,11 +1661,12 @@ boost::future<protocol::ClientMessage>
 SerializingProxy::invoke(protocol::ClientMessage& request)
 {
     try {
-        return spi::impl::ClientInvocation::create(
-                 client_context_,
-                 std::make_shared<protocol::ClientMessage>(std::move(request)),
-                 object_name_)
-          ->invoke();
+        auto invocation = spi::impl::ClientInvocation::create(
+          client_context_,
+          std::make_shared<protocol::ClientMessage>(std::move(request)),
+          object_name_);
+        invocation->set_inline_completion(inline_completion_);
+        return invocation->invoke();
     } catch (exception::iexception&) {
         util::exception_util::rethrow(std::current_exception());
         return boost::make_ready_future(protocol::ClientMessage(0));
@@ -1428,12 +1679,13 @@ SerializingProxy::invoke_on_connection(
   std::shared_ptr<connection::Connection> connection)
 {
     try {
-        return spi::impl::ClientInvocation::create(
-                 client_context_,
-                 std::make_shared<protocol::ClientMessage>(std::move(request)),
-                 object_name_,
-                 connection)
-          ->invoke();
+        auto invocation = spi::impl::ClientInvocation::create(
+          client_context_,
+          std::make_shared<protocol::ClientMessage>(std::move(request)),
+          object_name_,
+          connection);
+        invocation->set_inline_completion(inline_completion_);
+        return invocation->invoke();
     } catch (exception::iexception&) {
         util::exception_util::rethrow(std::current_exception());
         return boost::make_ready_future(protocol::ClientMessage(0));
@@ -1463,6 +1715,7 @@ SerializingProxy::invoke_on_member(protocol::ClientMessage& request,
           std::make_shared<protocol::ClientMessage>(std::move(request)),
           object_name_,
           uuid);
+        invocation->set_inline_completion(inline_completion_);
         return invocation->invoke();
     } catch (exception::iexception&) {
         util::exception_util::rethrow(std::current_exception());
@@ -1635,6 +1888,21 @@ IMapImpl::put_data(const serialization::pimpl::data& key,
       request, key);
 }
 
+boost::future<boost::optional<serialization::pimpl::data>>
+IMapImpl::put_data(const serialization::pimpl::data& key,
+                   serialization::pimpl::data&& value,
+                   std::chrono::milliseconds ttl)
+{
+    auto request = protocol::codec::map_put_encode(
+      get_name(),
+      key,
+      std::move(value),
+      util::get_current_thread_id(),
+      std::chrono::duration_cast<std::chrono::milliseconds>(ttl).count());
+    return invoke_and_get_future<boost::optional<serialization::pimpl::data>>(
+      request, key);
+}
+
 boost::future<protocol::ClientMessage>
 IMapImpl::put_transient(const serialization::pimpl::data& key,
                         const serialization::pimpl::data& value,
@@ -1700,6 +1968,20 @@ IMapImpl::set(const serialization::pimpl::data& key,
     return invoke_on_partition(request, get_partition_id(key));
 }
 
+boost::future<protocol::ClientMessage>
+IMapImpl::set(const serialization::pimpl::data& key,
+              serialization::pimpl::data&& value,
+              std::chrono::milliseconds ttl)
+{
+    auto request = protocol::codec::map_set_encode(
+      get_name(),
+      key,
+      std::move(value),
+      util::get_current_thread_id(),
+      std::chrono::duration_cast<std::chrono::milliseconds>(ttl).count());
+    return invoke_on_partition(request, get_partition_id(key));
+}
+
 boost::future<protocol::ClientMessage>
 IMapImpl::lock(const serialization::pimpl::data& key)
 {
@@ -1884,6 +2166,61 @@ IMapImpl::key_set_for_paging_predicate_data(
       });
 }
 
+std::shared_ptr<map::impl::partition_fetcher<EntryVector>>
+IMapImpl::entry_fetcher(int32_t fetch_size)
+{
+    util::Preconditions::check_positive(fetch_size,
+                                        "fetch_size must be positive");
+    return std::make_shared<map::impl::partition_fetcher<EntryVector>>(
+      partition_service_.get_partition_count(),
+      fetch_size,
+      [this](int32_t partition_id,
+             const map::impl::iteration_pointers& pointers,
+             int32_t batch) {
+          auto request =
+            protocol::codec::map_fetchentries_encode(get_name(), pointers, batch);
+          return invoke_on_partition(request, partition_id)
+            .then(boost::launch::sync,
+                  [](boost::future<protocol::ClientMessage> f) {
+                      auto msg = f.get();
+                      auto next_pointers = msg.get_first_var_sized_field<
+                        map::impl::iteration_pointers>();
+                      auto entries = msg.get<EntryVector>();
+                      return std::make_pair(std::move(next_pointers.value()),
+                                            std::move(entries));
+                  });
+      });
+}
+
+std::shared_ptr<
+  map::impl::partition_fetcher<std::vector<serialization::pimpl::data>>>
+IMapImpl::key_fetcher(int32_t fetch_size)
+{
+    util::Preconditions::check_positive(fetch_size,
+                                        "fetch_size must be positive");
+    return std::make_shared<
+      map::impl::partition_fetcher<std::vector<serialization::pimpl::data>>>(
+      partition_service_.get_partition_count(),
+      fetch_size,
+      [this](int32_t partition_id,
+             const map::impl::iteration_pointers& pointers,
+             int32_t batch) {
+          auto request =
+            protocol::codec::map_fetchkeys_encode(get_name(), pointers, batch);
+          return invoke_on_partition(request, partition_id)
+            .then(boost::launch::sync,
+                  [](boost::future<protocol::ClientMessage> f) {
+                      auto msg = f.get();
+                      auto next_pointers = msg.get_first_var_sized_field<
+                        map::impl::iteration_pointers>();
+                      auto keys =
+                        msg.get<std::vector<serialization::pimpl::data>>();
+                      return std::make_pair(std::move(next_pointers.value()),
+                                            std::move(keys));
+                  });
+      });
+}
+
 boost::future<EntryVector>
 IMapImpl::entry_set_data()
 {
@@ -1239,6 +1239,15 @@ data::to_byte_array() const
     return data_;
 }
 
+std::vector<byte>
+data::release_byte_array()
+{
+    std::vector<byte> bytes;
+    bytes.swap(data_);
+    cached_hash_value_ = -1;
+    return bytes;
+}
+
 int32_t
 data::get_type() const
 {
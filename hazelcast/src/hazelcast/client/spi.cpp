@@ -42,6 +42,7 @@
 #include "hazelcast/client/spi/impl/ClientInvocationServiceImpl.h"
 #include "hazelcast/client/impl/hazelcast_client_instance_impl.h"
 #include "hazelcast/client/impl/statistics/Statistics.h"
+#include "hazelcast/client/internal/nearcache/impl/invalidation/RepairingTask.h"
 #include "hazelcast/client/spi/impl/ClientPartitionServiceImpl.h"
 #include "hazelcast/client/spi/impl/DefaultAddressProvider.h"
 #include "hazelcast/client/spi/impl/sequence/CallIdSequenceWithBackpressure.h"
@@ -308,6 +309,12 @@ ClientContext::get_clientstatistics()
     return *hazelcast_client_.statistics_;
 }
 
+internal::nearcache::impl::invalidation::RepairingTask&
+ClientContext::get_repairing_task()
+{
+    return *hazelcast_client_.repairing_task_;
+}
+
 spi::impl::listener::cluster_view_listener&
 ClientContext::get_cluster_view_listener()
 {
@@ -326,6 +333,12 @@ ClientContext::get_proxy_session_manager()
     return hazelcast_client_.proxy_session_manager_;
 }
 
+cp::internal::raft_group_leader_cache&
+ClientContext::get_raft_group_leader_cache()
+{
+    return hazelcast_client_.raft_group_leader_cache_;
+}
+
 serialization::pimpl::default_schema_service&
 ClientContext::get_schema_service()
 {
@@ -362,6 +375,8 @@ lifecycle_service::start()
 
     client_context_.get_client_cluster_service().start();
 
+    client_context_.get_raft_group_leader_cache().start();
+
     client_context_.get_cluster_view_listener().start();
 
     if (!client_context_.get_connection_manager().start()) {
@@ -397,6 +412,7 @@ lifecycle_service::shutdown()
         fire_lifecycle_event(lifecycle_event::SHUTTING_DOWN);
         client_context_.get_proxy_session_manager().shutdown();
         client_context_.get_clientstatistics().shutdown();
+        client_context_.get_repairing_task().shutdown();
         client_context_.get_proxy_manager().destroy();
         client_context_.get_connection_manager().shutdown();
         client_context_.get_client_cluster_service().shutdown();
@@ -707,6 +723,8 @@ ClientInvocationServiceImpl::ClientInvocationServiceImpl(ClientContext& client)
   , backup_timeout_(
       std::chrono::milliseconds(client.get_client_properties().get_integer(
         client.get_client_properties().backup_timeout_millis())))
+  , inline_completion_(client.get_client_properties().get_boolean(
+      client.get_client_properties().invocation_inline_completion()))
 {}
 
 void
@@ -850,12 +868,14 @@ bool
 ClientInvocationServiceImpl::invoke(
   std::shared_ptr<ClientInvocation> invocation)
 {
-    auto connection = client_.get_connection_manager().get_random_connection();
+    auto& connection_manager = client_.get_connection_manager();
+    auto connection = connection_manager.get_random_connection();
     if (!connection) {
         HZ_LOG(logger_, finest, "No connection found to invoke");
         return false;
     }
-    return send(invocation, connection);
+    return send(invocation,
+                connection_manager.next_member_connection(connection));
 }
 
 DefaultAddressProvider::DefaultAddressProvider(
@@ -1283,8 +1303,14 @@ ClientInvocationServiceImpl::invoke_on_partition_owner(
   const std::shared_ptr<ClientInvocation>& invocation,
   int partition_id)
 {
-    auto partition_owner =
-      client_.get_partition_service().get_partition_owner(partition_id);
+    auto& partition_service = client_.get_partition_service();
+    auto connection = partition_service.get_partition_connection(partition_id);
+    if (connection && connection->is_alive()) {
+        return send(invocation, connection);
+    }
+
+    // the routing snapshot is stale or the owner is not connected yet
+    auto partition_owner = partition_service.get_partition_owner(partition_id);
     if (partition_owner.is_nil()) {
         HZ_LOG(logger_,
                finest,
@@ -1303,7 +1329,8 @@ ClientInvocationServiceImpl::invoke_on_target(
   boost::uuids::uuid uuid)
 {
     assert(!uuid.is_nil());
-    auto connection = client_.get_connection_manager().get_connection(uuid);
+    auto& connection_manager = client_.get_connection_manager();
+    auto connection = connection_manager.get_connection(uuid);
     if (!connection) {
         HZ_LOG(
           logger_,
@@ -1312,7 +1339,8 @@ ClientInvocationServiceImpl::invoke_on_target(
                      uuid));
         return false;
     }
-    return send(invocation, connection);
+    return send(invocation,
+                connection_manager.next_member_connection(connection));
 }
 
 bool
@@ -1321,6 +1349,12 @@ ClientInvocationServiceImpl::is_smart_routing() const
     return smart_routing_;
 }
 
+bool
+ClientInvocationServiceImpl::is_inline_completion() const
+{
+    return inline_completion_;
+}
+
 const std::chrono::milliseconds&
 ClientInvocationServiceImpl::get_backup_timeout() const
 {
@@ -1425,6 +1459,7 @@ ClientInvocation::ClientInvocation(
   , invoke_count_(0)
   , urgent_(false)
   , smart_routing_(invocation_service_.is_smart_routing())
+  , inline_completion_(invocation_service_.is_inline_completion())
 {
     message->set_partition_id(partition_id_);
     client_message_ =
@@ -1442,18 +1477,9 @@ ClientInvocation::invoke()
     auto actual_work = [this]() {
         // for back pressure
         call_id_sequence_->next();
+        call_id_sequence_pending_ = inline_completion_;
         invoke_on_selection();
-        if (!lifecycle_service_.is_running()) {
-            return invocation_promise_.get_future().then(
-              [](boost::future<protocol::ClientMessage> f) { return f.get(); });
-        }
-        auto id_seq = call_id_sequence_;
-        return invocation_promise_.get_future().then(
-          execution_service_->get_user_executor(),
-          [=](boost::future<protocol::ClientMessage> f) {
-              id_seq->complete();
-              return f.get();
-          });
+        return completion_future();
     };
 
     const auto& schemas =
@@ -1483,7 +1509,26 @@ ClientInvocation::invoke_urgent()
 
     // for back pressure
     call_id_sequence_->force_next();
+    call_id_sequence_pending_ = inline_completion_;
     invoke_on_selection();
+    return completion_future();
+}
+
+void
+ClientInvocation::set_inline_completion(bool inline_completion)
+{
+    inline_completion_ = inline_completion;
+}
+
+boost::future<protocol::ClientMessage>
+ClientInvocation::completion_future()
+{
+    if (inline_completion_) {
+        // the future is completed by whoever sets the response, typically
+        // the I/O thread, without any continuation
+        return invocation_promise_.get_future();
+    }
+
     if (!lifecycle_service_.is_running()) {
         return invocation_promise_.get_future().then(
           [](boost::future<protocol::ClientMessage> f) { return f.get(); });
@@ -1497,6 +1542,14 @@ ClientInvocation::invoke_urgent()
       });
 }
 
+void
+ClientInvocation::complete_call_id_sequence()
+{
+    if (call_id_sequence_pending_.exchange(false)) {
+        call_id_sequence_->complete();
+    }
+}
+
 boost::future<void>
 ClientInvocation::replicate_schemas(
   std::vector<serialization::pimpl::schema> schemas)
@@ -1627,6 +1680,7 @@ ClientInvocation::set_exception(const std::exception& e,
                   [=]() { connection->deregister_invocation(call_id); });
             }
         }
+        complete_call_id_sequence();
         invocation_promise_.set_exception(std::move(exception_ptr));
     } catch (boost::promise_already_satisfied& se) {
         if (!event_handler_) {
@@ -1720,13 +1774,20 @@ ClientInvocation::erase_invocation() const
     if (!this->event_handler_) {
         auto sent_connection = get_send_connection();
         if (sent_connection) {
+            auto& executor = sent_connection->get_socket().get_executor();
+            if (executor.running_in_this_thread()) {
+                // responses are completed from within the socket strand, no
+                // need for another strand hop in that case
+                sent_connection->deregister_invocation(
+                  get_client_message()->get_correlation_id());
+                return;
+            }
+
             auto this_invocation = shared_from_this();
-            boost::asio::post(sent_connection->get_socket().get_executor(),
-                              [=]() {
-                                  sent_connection->invocations.erase(
-                                    this_invocation->get_client_message()
-                                      ->get_correlation_id());
-                              });
+            boost::asio::post(executor, [=]() {
+                sent_connection->deregister_invocation(
+                  this_invocation->get_client_message()->get_correlation_id());
+            });
         }
     }
 }
@@ -1948,11 +2009,14 @@ ClientInvocation::notify(const std::shared_ptr<protocol::ClientMessage>& msg)
 }
 
 void
-ClientInvocation::complete(const std::shared_ptr<protocol::ClientMessage>& msg)
+ClientInvocation::complete(std::shared_ptr<protocol::ClientMessage> msg)
 {
     try {
-        // TODO: move msg content here?
-        this->invocation_promise_.set_value(*msg);
+        // The frame blocks are moved into the future, the response is not
+        // copied. The promise is checked for a previous value before the move,
+        // hence msg is still intact when the logging below is done.
+        complete_call_id_sequence();
+        this->invocation_promise_.set_value(std::move(*msg));
     } catch (std::exception& e) {
         HZ_LOG(logger_,
                warning,
@@ -2112,7 +2176,8 @@ ClientInvocation::detect_and_handle_backup_timeout(
 void
 ClientInvocation::complete_with_pending_response()
 {
-    complete(pending_response_);
+    // the pending response is emptied by the completion, do not keep it
+    complete(std::move(pending_response_));
 }
 
 ClientContext&
@@ -2236,7 +2301,8 @@ ClientPartitionServiceImpl::ClientPartitionServiceImpl(ClientContext& client)
   , logger_(client.get_logger())
   , partition_count_(0)
   , partition_table_(
-      boost::shared_ptr<partition_table>(new partition_table{ 0, -1 }))
+      boost::shared_ptr<partition_table>(new partition_table{ 0, -1, {} }))
+  , routing_table_(boost::shared_ptr<routing_table>(new routing_table()))
 {}
 
 void
@@ -2261,7 +2327,8 @@ ClientPartitionServiceImpl::handle_event(
         if (partition_table_.compare_exchange_strong(
               current,
               boost::shared_ptr<partition_table>(new partition_table{
-                connection_id, version, convert_to_map(partitions) }))) {
+                connection_id, version, convert_to_owners(partitions) }))) {
+            refresh_routing_table();
             HZ_LOG(
               logger_,
               finest,
@@ -2278,13 +2345,63 @@ boost::uuids::uuid
 ClientPartitionServiceImpl::get_partition_owner(int32_t partition_id)
 {
     auto table_ptr = partition_table_.load();
-    auto it = table_ptr->partitions.find(partition_id);
-    if (it != table_ptr->partitions.end()) {
-        return it->second;
+    if (partition_id >= 0 &&
+        static_cast<size_t>(partition_id) < table_ptr->partitions.size()) {
+        return table_ptr->partitions[partition_id];
     }
     return boost::uuids::nil_uuid();
 }
 
+std::shared_ptr<connection::Connection>
+ClientPartitionServiceImpl::get_partition_connection(int32_t partition_id)
+{
+    auto routing = routing_table_.load();
+    if (partition_id >= 0 &&
+        static_cast<size_t>(partition_id) < routing->connections.size()) {
+        return routing->connections[partition_id];
+    }
+    return nullptr;
+}
+
+void
+ClientPartitionServiceImpl::refresh_routing_table()
+{
+    std::lock_guard<std::mutex> guard(routing_table_mutex_);
+
+    auto table_ptr = partition_table_.load();
+    auto& connection_manager = client_.get_connection_manager();
+    boost::shared_ptr<routing_table> routing(new routing_table());
+    routing->connections.resize(table_ptr->partitions.size());
+    // there are only a few members, resolve each owner once
+    std::unordered_map<boost::uuids::uuid,
+                       std::vector<std::shared_ptr<connection::Connection>>,
+                       boost::hash<boost::uuids::uuid>>
+      owner_connections;
+    for (size_t partition_id = 0; partition_id < routing->connections.size();
+         ++partition_id) {
+        const auto& owner = table_ptr->partitions[partition_id];
+        if (owner.is_nil()) {
+            continue;
+        }
+        auto it = owner_connections.find(owner);
+        if (it == owner_connections.end()) {
+            it = owner_connections
+                   .emplace(owner,
+                            connection_manager.get_member_connections(owner))
+                   .first;
+        }
+        if (it->second.empty()) {
+            continue;
+        }
+        // a partition sticks to one of the member connections to keep the
+        // order of its invocations
+        routing->connections[partition_id] =
+          it->second[partition_id % it->second.size()];
+    }
+
+    routing_table_.store(routing);
+}
+
 int32_t
 ClientPartitionServiceImpl::get_partition_id(
   const serialization::pimpl::data& key)
@@ -2392,18 +2509,30 @@ ClientPartitionServiceImpl::log_failure(
 void
 ClientPartitionServiceImpl::reset()
 {
-    partition_table_.store(nullptr);
+    partition_table_.store(
+      boost::shared_ptr<partition_table>(new partition_table{ 0, -1, {} }));
+    refresh_routing_table();
 }
 
-std::unordered_map<int32_t, boost::uuids::uuid>
-ClientPartitionServiceImpl::convert_to_map(
+std::vector<boost::uuids::uuid>
+ClientPartitionServiceImpl::convert_to_owners(
   const std::vector<std::pair<boost::uuids::uuid, std::vector<int>>>&
     partitions)
 {
-    std::unordered_map<int32_t, boost::uuids::uuid> new_partitions;
+    size_t partition_count = static_cast<size_t>(
+      (std::max)(get_partition_count(), 0));
+    for (auto const& e : partitions) {
+        for (auto pid : e.second) {
+            partition_count =
+              (std::max)(partition_count, static_cast<size_t>(pid) + 1);
+        }
+    }
+
+    std::vector<boost::uuids::uuid> new_partitions(partition_count,
+                                                   boost::uuids::nil_uuid());
     for (auto const& e : partitions) {
         for (auto pid : e.second) {
-            new_partitions.insert({ pid, e.first });
+            new_partitions[pid] = e.first;
         }
     }
     return new_partitions;
@@ -2709,6 +2838,21 @@ listener_service_impl::handle_client_message(
   const std::shared_ptr<protocol::ClientMessage> response)
 {
     try {
+        // the listener invocations are created with a BaseEventHandler, see
+        // invoke
+        auto eventHandler =
+          std::static_pointer_cast<client::impl::BaseEventHandler>(
+            invocation->get_event_handler());
+        if (eventHandler && eventHandler->coalesce_events()) {
+            // the queue keeps the order of the events, one drain at a time
+            if (eventHandler->enqueue_event(response)) {
+                boost::asio::post(event_executor_->get_executor(), [=]() {
+                    process_event_batch(eventHandler);
+                });
+            }
+            return;
+        }
+
         auto partitionId = response->get_partition_id();
         if (partitionId == -1) {
             // execute on random thread on the thread pool
@@ -2943,6 +3087,29 @@ listener_service_impl::process_event_message(
     }
 }
 
+void
+listener_service_impl::process_event_batch(
+  const std::shared_ptr<client::impl::BaseEventHandler> event_handler)
+{
+    std::chrono::steady_clock::time_point firstReceivedAt;
+    for (auto events = event_handler->drain_events(firstReceivedAt);
+         !events.empty();
+         events = event_handler->drain_events(firstReceivedAt)) {
+        try {
+            event_handler->handle_batch(events, firstReceivedAt);
+        } catch (std::exception& e) {
+            if (client_context_.get_lifecycle_service().is_running()) {
+                HZ_LOG(logger_,
+                       warning,
+                       boost::str(boost::format(
+                                    "Delivery of a batch of %1% event "
+                                    "messages to event handler failed. %2%") %
+                                  events.size() % e.what()));
+            }
+        }
+    }
+}
+
 listener_service_impl::~listener_service_impl() = default;
 
 void
@@ -14,12 +14,15 @@
  * limitations under the License.
  */
 
+#include <cstring>
+
 #include <boost/uuid/random_generator.hpp>
 
 #include "hazelcast/client/connection/ClientConnectionManagerImpl.h"
 #include "hazelcast/client/protocol/codec/codecs.h"
 #include "hazelcast/client/protocol/codec/builtin/sql_page_codec.h"
 #include "hazelcast/client/spi/ClientContext.h"
+#include "hazelcast/client/spi/impl/ClientExecutionServiceImpl.h"
 #include "hazelcast/client/spi/impl/ClientInvocation.h"
 #include "hazelcast/client/sql/impl/query_id.h"
 #include "hazelcast/client/sql/sql_column_metadata.h"
@@ -101,6 +104,7 @@ sql_service::execute(const sql_statement& statement)
       client_context_, request, "", query_conn);
 
     auto cursor_buffer_size = statement.cursor_buffer_size();
+    auto prefetch_depth = statement.prefetch_depth();
 
     std::weak_ptr<std::atomic<int32_t>> statement_par_arg_index_weak_ptr =
       statement_par_arg_index_ptr;
@@ -112,6 +116,7 @@ sql_service::execute(const sql_statement& statement)
        query_conn,
        qid,
        cursor_buffer_size,
+       prefetch_depth,
        sql_query,
        arg_index,
        statement_par_arg_index_weak_ptr](
@@ -124,6 +129,7 @@ sql_service::execute(const sql_statement& statement)
                                              query_conn,
                                              qid,
                                              cursor_buffer_size,
+                                             prefetch_depth,
                                              statement_par_arg_index_weak_ptr);
           } catch (const std::exception& e) {
               rethrow(e, query_conn);
@@ -244,6 +250,7 @@ sql_service::handle_execute_response(
   std::shared_ptr<connection::Connection> connection,
   impl::query_id id,
   int32_t cursor_buffer_size,
+  int32_t prefetch_depth,
   std::weak_ptr<std::atomic<int32_t>> statement_par_arg_index_ptr)
 {
     auto response = decode_execute_response(msg);
@@ -278,7 +285,8 @@ sql_service::handle_execute_response(
                      response.update_count,
                      std::move(response.row_metadata),
                      std::move(response.first_page),
-                     cursor_buffer_size));
+                     cursor_buffer_size,
+                     prefetch_depth));
 }
 
 std::shared_ptr<connection::Connection>
@@ -318,18 +326,11 @@ sql_service::query_connection(int32_t partition_id)
 {
     std::shared_ptr<connection::Connection> connection;
     try {
-        const auto node_id =
-          client_context_.get_partition_service().get_partition_owner(
-            partition_id);
-
-        if (node_id.is_nil()) {
-            return query_connection();
-        }
-
         connection =
-          client_context_.get_connection_manager().get_connection(node_id);
+          client_context_.get_partition_service().get_partition_connection(
+            partition_id);
 
-        if (connection == nullptr) {
+        if (connection == nullptr || !connection->is_alive()) {
             return query_connection();
         }
     } catch (const std::exception& e) {
@@ -457,10 +458,12 @@ constexpr std::chrono::milliseconds sql_statement::TIMEOUT_NOT_SET;
 constexpr std::chrono::milliseconds sql_statement::TIMEOUT_DISABLED;
 constexpr std::chrono::milliseconds sql_statement::DEFAULT_TIMEOUT;
 constexpr int32_t sql_statement::DEFAULT_CURSOR_BUFFER_SIZE;
+constexpr int32_t sql_statement::DEFAULT_PREFETCH_DEPTH;
 
 sql_statement::sql_statement(hazelcast_client& client, std::string query)
   : serialized_parameters_{}
   , cursor_buffer_size_{ DEFAULT_CURSOR_BUFFER_SIZE }
+  , prefetch_depth_{ DEFAULT_PREFETCH_DEPTH }
   , timeout_{ TIMEOUT_NOT_SET }
   , expected_result_type_{ sql_expected_result_type::any }
   , schema_{}
@@ -475,6 +478,7 @@ sql_statement::sql_statement(spi::ClientContext& client_context,
                              std::string query)
   : serialized_parameters_{}
   , cursor_buffer_size_{ DEFAULT_CURSOR_BUFFER_SIZE }
+  , prefetch_depth_{ DEFAULT_PREFETCH_DEPTH }
   , timeout_{ TIMEOUT_NOT_SET }
   , expected_result_type_{ sql_expected_result_type::any }
   , schema_{}
@@ -525,6 +529,24 @@ sql_statement::cursor_buffer_size(int32_t size)
     return *this;
 }
 
+int32_t
+sql_statement::prefetch_depth() const
+{
+    return prefetch_depth_;
+}
+
+sql_statement&
+sql_statement::prefetch_depth(int32_t depth)
+{
+    util::Preconditions::check_not_negative(
+      depth,
+      (boost::format("Prefetch depth must not be negative: %s") % depth)
+        .str());
+    prefetch_depth_ = depth;
+
+    return *this;
+}
+
 std::chrono::milliseconds
 sql_statement::timeout() const
 {
@@ -744,7 +766,8 @@ sql_result::sql_result(spi::ClientContext* client_context,
                        int64_t update_count,
                        std::shared_ptr<sql_row_metadata> row_metadata,
                        std::shared_ptr<sql_page> first_page,
-                       int32_t cursor_buffer_size)
+                       int32_t cursor_buffer_size,
+                       int32_t prefetch_depth)
   : client_context_(client_context)
   , service_(service)
   , connection_(std::move(connection))
@@ -755,6 +778,7 @@ sql_result::sql_result(spi::ClientContext* client_context,
   , iterator_requested_(false)
   , closed_(false)
   , cursor_buffer_size_(cursor_buffer_size)
+  , prefetch_depth_(prefetch_depth)
 {
     if (row_metadata_) {
         assert(first_page_);
@@ -784,14 +808,15 @@ sql_result::iterator()
 {
     check_closed();
 
-    if (!first_page_) {
+    // stream_rows releases the first page, hence this is checked first
+    if (iterator_requested_) {
         BOOST_THROW_EXCEPTION(exception::illegal_state(
-          "sql_result::iterator", "This result contains only update count"));
+          "sql_result::page_iterator", "Iterator can be requested only once"));
     }
 
-    if (iterator_requested_) {
+    if (!first_page_) {
         BOOST_THROW_EXCEPTION(exception::illegal_state(
-          "sql_result::page_iterator", "Iterator can be requested only once"));
+          "sql_result::iterator", "This result contains only update count"));
     }
 
     iterator_requested_ = true;
@@ -799,6 +824,91 @@ sql_result::iterator()
     return { shared_from_this(), first_page_ };
 }
 
+struct sql_result::row_stream
+{
+    row_stream(page_iterator&& iter,
+               std::shared_ptr<sql_result> res,
+               std::function<bool(const sql_page::sql_row&)> row_consumer,
+               util::hz_thread_pool& user_executor)
+      : iterator(std::move(iter))
+      , result(std::move(res))
+      , consumer(std::move(row_consumer))
+      , executor(user_executor)
+    {
+    }
+
+    page_iterator iterator;
+    std::shared_ptr<sql_result> result;
+    std::function<bool(const sql_page::sql_row&)> consumer;
+    util::hz_thread_pool& executor;
+    boost::promise<void> done;
+};
+
+boost::future<void>
+sql_result::stream_rows(std::function<bool(const sql_page::sql_row&)> consumer)
+{
+    auto stream = std::make_shared<row_stream>(
+      iterator(),
+      shared_from_this(),
+      std::move(consumer),
+      client_context_->get_client_execution_service().get_user_executor());
+    // the iterator owns the first page now, so that it is released when its
+    // rows are consumed
+    first_page_.reset();
+
+    auto done = stream->done.get_future();
+    stream_next_page(std::move(stream));
+    return done;
+}
+
+void
+sql_result::stream_next_page(std::shared_ptr<row_stream> stream)
+{
+    boost::future<std::shared_ptr<sql_page>> page_future;
+    try {
+        page_future = stream->iterator.next();
+    } catch (...) {
+        stream->done.set_exception(boost::current_exception());
+        return;
+    }
+
+    page_future.then(
+      stream->executor,
+      [stream](boost::future<std::shared_ptr<sql_page>> page_f) {
+          try {
+              auto page = page_f.get();
+              for (const auto& row : page->rows()) {
+                  if (!stream->consumer(row)) {
+                      page.reset();
+                      stream->result->close().then(
+                        boost::launch::sync,
+                        [stream](boost::future<void> close_f) {
+                            try {
+                                close_f.get();
+                                stream->done.set_value();
+                            } catch (...) {
+                                stream->done.set_exception(
+                                  boost::current_exception());
+                            }
+                        });
+                      return;
+                  }
+              }
+
+              // the storage of the page is released before the next page is
+              // requested
+              page.reset();
+              if (stream->iterator.has_next()) {
+                  stream_next_page(stream);
+              } else {
+                  stream->done.set_value();
+              }
+          } catch (...) {
+              stream->done.set_exception(boost::current_exception());
+          }
+      });
+}
+
 sql_result::page_iterator_sync
 sql_result::pbegin(std::chrono::milliseconds timeout)
 {
@@ -910,6 +1020,9 @@ sql_result::close()
             closed_ = true;
 
             connection_.reset();
+            // the pending prefetches see closed_ and do not fetch further
+            prefetched_pages_.clear();
+            last_fetch_ = boost::shared_future<std::shared_ptr<sql_page>>();
         }
 
         row_metadata_.reset();
@@ -938,7 +1051,79 @@ sql_result::fetch_page()
     std::lock_guard<std::mutex> guard{ mtx_ };
 
     check_closed();
-    return service_->fetch_page(query_id_, cursor_buffer_size_, connection_);
+    if (prefetch_depth_ == 0) {
+        return service_->fetch_page(
+          query_id_, cursor_buffer_size_, connection_);
+    }
+
+    if (prefetched_pages_.empty()) {
+        prefetch_pages();
+    }
+    auto page = std::move(prefetched_pages_.front());
+    prefetched_pages_.pop_front();
+    prefetch_pages();
+
+    return page.then(
+      boost::launch::sync,
+      [](boost::shared_future<std::shared_ptr<sql_page>> page_f) {
+          return page_f.get();
+      });
+}
+
+void
+sql_result::start_prefetch()
+{
+    std::lock_guard<std::mutex> guard{ mtx_ };
+
+    if (prefetch_depth_ > 0 && !closed_) {
+        prefetch_pages();
+    }
+}
+
+void
+sql_result::prefetch_pages()
+{
+    std::weak_ptr<sql_result> weak_self = shared_from_this();
+    auto service = service_;
+    auto query_id = query_id_;
+    auto cursor_buffer_size = cursor_buffer_size_;
+    auto connection = connection_;
+
+    while (prefetched_pages_.size() < static_cast<size_t>(prefetch_depth_)) {
+        if (!last_fetch_.valid()) {
+            // the first page came with the execute response
+            last_fetch_ =
+              service->fetch_page(query_id, cursor_buffer_size, connection)
+                .share();
+        } else {
+            // the next page is requested when the previous one is received,
+            // so that the pages are received in order and no page is
+            // requested after the last one
+            last_fetch_ =
+              last_fetch_
+                .then(boost::launch::sync,
+                      [weak_self,
+                       service,
+                       query_id,
+                       cursor_buffer_size,
+                       connection](
+                        boost::shared_future<std::shared_ptr<sql_page>>
+                          previous_f) {
+                          auto previous = previous_f.get();
+                          auto self = weak_self.lock();
+                          if (!previous || previous->last() || !self ||
+                              self->closed_) {
+                              return boost::make_ready_future(
+                                std::shared_ptr<sql_page>());
+                          }
+                          return service->fetch_page(
+                            query_id, cursor_buffer_size, connection);
+                      })
+                .unwrap()
+                .share();
+        }
+        prefetched_pages_.push_back(last_fetch_);
+    }
 }
 
 const sql_row_metadata&
@@ -989,6 +1174,9 @@ sql_result::page_iterator::next()
         page->serialization_service(serialization_);
         page->row_metadata(row_metadata_);
         *last_ = page->last();
+        if (!*last_) {
+            result_->start_prefetch();
+        }
 
         return boost::make_ready_future<std::shared_ptr<sql_page>>(page);
     }
@@ -1150,6 +1338,93 @@ sql_result::page_iterator_sync::operator->() const
     return operator*();
 }
 
+sql_page::column::column(std::size_t size,
+                         const std::type_info& value_type,
+                         const std::type_info& storage_type)
+  : size_(size)
+  , null_bitmap_((size + 63) / 64)
+  , value_type_(&value_type)
+  , storage_type_(&storage_type)
+{
+}
+
+sql_page::column
+sql_page::column::of_strings(
+  const std::type_info& value_type,
+  const std::vector<boost::optional<std::string>>& values)
+{
+    auto size = values.size();
+    column result(size, value_type, typeid(boost::string_view));
+
+    std::size_t buffer_size = 0;
+    for (const auto& value : values) {
+        if (value) {
+            buffer_size += value->size();
+        }
+    }
+    result.string_buffer_ = std::shared_ptr<char>(
+      new char[buffer_size], std::default_delete<char[]>());
+
+    auto views = new boost::string_view[size];
+    result.values_ =
+      std::shared_ptr<void>(views, std::default_delete<boost::string_view[]>());
+    auto position = result.string_buffer_.get();
+    for (std::size_t i = 0; i < size; ++i) {
+        if (values[i]) {
+            std::memcpy(position, values[i]->data(), values[i]->size());
+            views[i] = boost::string_view(position, values[i]->size());
+            position += values[i]->size();
+        } else {
+            result.set_null(i);
+        }
+    }
+    return result;
+}
+
+sql_page::column
+sql_page::column::of_nulls(std::size_t size)
+{
+    column result(size, typeid(void), typeid(void));
+    for (std::size_t i = 0; i < size; ++i) {
+        result.set_null(i);
+    }
+    return result;
+}
+
+std::size_t
+sql_page::column::size() const
+{
+    return size_;
+}
+
+const std::uint64_t*
+sql_page::column::null_bitmap() const
+{
+    return null_bitmap_.data();
+}
+
+void
+sql_page::column::set_null(std::size_t row_index)
+{
+    null_bitmap_[row_index / 64] |= std::uint64_t(1) << (row_index % 64);
+}
+
+std::string
+sql_page::column::value(std::size_t row_index, std::string* /* dummy */) const
+{
+    auto view =
+      static_cast<const boost::string_view*>(values_.get())[row_index];
+    return std::string(view.data(), view.size());
+}
+
+hazelcast_json_value
+sql_page::column::value(std::size_t row_index,
+                        hazelcast_json_value* /* dummy */) const
+{
+    return hazelcast_json_value(
+      value(row_index, static_cast<std::string*>(nullptr)));
+}
+
 std::size_t
 sql_page::page_data::column_count() const
 {
@@ -1249,6 +1524,17 @@ sql_page::rows() const
     return rows_;
 }
 
+void
+sql_page::check_column_index(std::size_t column_index) const
+{
+    if (column_index >= column_count()) {
+        throw exception::index_out_of_bounds(
+          "sql_page::column_values",
+          (boost::format("Column index is out of range: %1%") % column_index)
+            .str());
+    }
+}
+
 void
 sql_page::row_metadata(std::shared_ptr<sql_row_metadata> row_meta)
 {
@@ -34,6 +34,7 @@
 #include "hazelcast/client/monitor/impl/NearCacheStatsImpl.h"
 #include "hazelcast/client/protocol/codec/codecs.h"
 #include "hazelcast/client/protocol/codec/codecs.h"
+#include "hazelcast/client/protocol/frame_buffer_pool.h"
 #include "hazelcast/client/spi/ClientContext.h"
 #include "hazelcast/client/spi/impl/ClientExecutionServiceImpl.h"
 #include "hazelcast/client/spi/impl/ClientInvocation.h"
@@ -208,6 +209,21 @@ Statistics::PeriodicStatistics::fill_metrics(
       { "runtime", "availableProcessors", metrics::probe_unit::COUNT },
       hw_concurrency);
 
+    auto& frame_pool = protocol::frame_buffer_pool::instance();
+    auto frame_pool_hits = frame_pool.hits();
+    auto frame_pool_misses = frame_pool.misses();
+    auto frame_pool_pooled = frame_pool.pooled_count();
+    add_stat(stats, "framePool.hits", frame_pool_hits);
+    add_stat(stats, "framePool.misses", frame_pool_misses);
+    add_stat(stats, "framePool.pooledCount", frame_pool_pooled);
+    compressor.add_long({ "framePool", "hits", metrics::probe_unit::COUNT },
+                        frame_pool_hits);
+    compressor.add_long({ "framePool", "misses", metrics::probe_unit::COUNT },
+                        frame_pool_misses);
+    compressor.add_long(
+      { "framePool", "pooledCount", metrics::probe_unit::COUNT },
+      frame_pool_pooled);
+
     // more gauges can be added here
 }
 
@@ -245,6 +261,14 @@ Statistics::PeriodicStatistics::add_near_cache_stats(
                               nc_stats->get_evictions(),
                               metrics::probe_unit::COUNT);
 
+        add_near_cache_metric(stats,
+                              compressor,
+                              "admissionRejections",
+                              nc_name,
+                              nc_name_with_prefix,
+                              nc_stats->get_admission_rejections(),
+                              metrics::probe_unit::COUNT);
+
         add_near_cache_metric(stats,
                               compressor,
                               "hits",
@@ -325,6 +349,46 @@ Statistics::PeriodicStatistics::add_near_cache_stats(
                               nc_stats->get_invalidation_requests(),
                               metrics::probe_unit::COUNT);
 
+        add_near_cache_metric(stats,
+                              compressor,
+                              "invalidationBatches",
+                              nc_name,
+                              nc_name_with_prefix,
+                              nc_stats->get_invalidation_batches(),
+                              metrics::probe_unit::COUNT);
+
+        add_near_cache_metric(stats,
+                              compressor,
+                              "invalidationBatchKeys",
+                              nc_name,
+                              nc_name_with_prefix,
+                              nc_stats->get_invalidation_batch_keys(),
+                              metrics::probe_unit::COUNT);
+
+        add_near_cache_metric(stats,
+                              compressor,
+                              "maxInvalidationBatchSize",
+                              nc_name,
+                              nc_name_with_prefix,
+                              nc_stats->get_max_invalidation_batch_size(),
+                              metrics::probe_unit::COUNT);
+
+        add_near_cache_metric(stats,
+                              compressor,
+                              "totalInvalidationLag",
+                              nc_name,
+                              nc_name_with_prefix,
+                              nc_stats->get_total_invalidation_lag(),
+                              metrics::probe_unit::MS);
+
+        add_near_cache_metric(stats,
+                              compressor,
+                              "maxInvalidationLag",
+                              nc_name,
+                              nc_name_with_prefix,
+                              nc_stats->get_max_invalidation_lag(),
+                              metrics::probe_unit::MS);
+
         add_near_cache_metric(stats,
                               compressor,
                               "ownedEntryMemoryCost",
@@ -414,9 +478,15 @@ NearCacheStatsImpl::NearCacheStatsImpl()
   , hits_(0)
   , misses_(0)
   , evictions_(0)
+  , admission_rejections_(0)
   , expirations_(0)
   , invalidations_(0)
   , invalidation_requests_(0)
+  , invalidation_batches_(0)
+  , invalidation_batch_keys_(0)
+  , max_invalidation_batch_size_(0)
+  , total_invalidation_lag_(0)
+  , max_invalidation_lag_(0)
   , persistence_count_(0)
   , last_persistence_time_(0)
   , last_persistence_duration_(0)
@@ -545,6 +615,18 @@ NearCacheStatsImpl::increment_evictions()
     ++evictions_;
 }
 
+int64_t
+NearCacheStatsImpl::get_admission_rejections()
+{
+    return admission_rejections_.load();
+}
+
+void
+NearCacheStatsImpl::increment_admission_rejections()
+{
+    ++admission_rejections_;
+}
+
 int64_t
 NearCacheStatsImpl::get_expirations()
 {
@@ -587,6 +669,54 @@ NearCacheStatsImpl::reset_invalidation_events()
     invalidation_requests_ = 0;
 }
 
+void
+NearCacheStatsImpl::add_invalidation_batch(int64_t key_count, int64_t lag)
+{
+    ++invalidation_batches_;
+    invalidation_batch_keys_ += key_count;
+    total_invalidation_lag_ += lag;
+    update_max(max_invalidation_batch_size_, key_count);
+    update_max(max_invalidation_lag_, lag);
+}
+
+int64_t
+NearCacheStatsImpl::get_invalidation_batches()
+{
+    return invalidation_batches_.load();
+}
+
+int64_t
+NearCacheStatsImpl::get_invalidation_batch_keys()
+{
+    return invalidation_batch_keys_.load();
+}
+
+int64_t
+NearCacheStatsImpl::get_max_invalidation_batch_size()
+{
+    return max_invalidation_batch_size_.load();
+}
+
+int64_t
+NearCacheStatsImpl::get_total_invalidation_lag()
+{
+    return total_invalidation_lag_.load();
+}
+
+int64_t
+NearCacheStatsImpl::get_max_invalidation_lag()
+{
+    return max_invalidation_lag_.load();
+}
+
+void
+NearCacheStatsImpl::update_max(std::atomic<int64_t>& max, int64_t value)
+{
+    int64_t current = max.load();
+    while (value > current && !max.compare_exchange_weak(current, value)) {
+    }
+}
+
 int64_t
 NearCacheStatsImpl::get_persistence_count()
 {
@@ -606,6 +736,13 @@ NearCacheStatsImpl::add_persistence(int64_t duration,
     last_persistence_failure_ = "";
 }
 
+void
+NearCacheStatsImpl::add_persistence_failure(const std::string& failure)
+{
+    last_persistence_time_ = util::current_time_millis();
+    last_persistence_failure_ = failure;
+}
+
 int64_t
 NearCacheStatsImpl::get_last_persistence_time()
 {
@@ -647,9 +784,15 @@ NearCacheStatsImpl::to_string()
         << ", creationTime=" << creation_time_ << ", hits=" << hits_
         << ", misses=" << misses_ << ", ratio=" << std::setprecision(1)
         << get_ratio() << ", evictions=" << evictions_
+        << ", admissionRejections=" << admission_rejections_.load()
         << ", expirations=" << expirations_
         << ", invalidations=" << invalidations_.load()
         << ", invalidationRequests=" << invalidation_requests_.load()
+        << ", invalidationBatches=" << invalidation_batches_.load()
+        << ", invalidationBatchKeys=" << invalidation_batch_keys_.load()
+        << ", maxInvalidationBatchSize=" << max_invalidation_batch_size_.load()
+        << ", totalInvalidationLag=" << total_invalidation_lag_.load()
+        << ", maxInvalidationLag=" << max_invalidation_lag_.load()
         << ", lastPersistenceTime=" << last_persistence_time_
         << ", persistenceCount=" << persistence_count_
         << ", lastPersistenceDuration=" << last_persistence_duration_
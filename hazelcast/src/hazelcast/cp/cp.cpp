@@ -23,10 +23,28 @@
 #include "hazelcast/client/protocol/codec/codecs.h"
 #include "hazelcast/client/protocol/ClientMessage.h"
 #include "hazelcast/client/spi/impl/ClientInvocation.h"
+#include "hazelcast/client/connection/Connection.h"
 #include "hazelcast/client/impl/hazelcast_client_instance_impl.h"
 
 namespace hazelcast {
 namespace cp {
+namespace {
+// the errors of the invocations which did not reach their target member
+bool
+is_connection_error(const client::exception::iexception& e)
+{
+    switch (e.get_error_code()) {
+        case client::protocol::IO:
+        case client::protocol::TARGET_DISCONNECTED:
+        case client::protocol::TARGET_NOT_MEMBER:
+        case client::protocol::HAZELCAST_INSTANCE_NOT_ACTIVE:
+            return true;
+        default:
+            return false;
+    }
+}
+} // namespace
+
 using namespace hazelcast::client::protocol;
 using namespace hazelcast::client::protocol::codec;
 using namespace hazelcast::util;
@@ -208,6 +226,63 @@ cp_proxy::get_group_id() const
     return group_id_;
 }
 
+boost::future<client::protocol::ClientMessage>
+cp_proxy::invoke(client::protocol::ClientMessage& request)
+{
+    auto& leader_cache = get_context().get_raft_group_leader_cache();
+    auto group_id = group_id_;
+    auto target = leader_cache.get_target(group_id);
+    auto invocation = client::spi::impl::ClientInvocation::create(
+      get_context(),
+      std::make_shared<client::protocol::ClientMessage>(std::move(request)),
+      object_name_,
+      target);
+    invocation->set_inline_completion(is_inline_completion());
+    std::weak_ptr<client::spi::impl::ClientInvocation> weak_invocation =
+      invocation;
+    auto start = std::chrono::steady_clock::now();
+    return invocation->invoke().then(
+      boost::launch::sync,
+      [=, &leader_cache](boost::future<client::protocol::ClientMessage> f) {
+          auto on_response = [&]() {
+              boost::uuids::uuid responder{};
+              auto sent_invocation = weak_invocation.lock();
+              auto connection = sent_invocation
+                                  ? sent_invocation->get_send_connection()
+                                  : nullptr;
+              if (connection) {
+                  responder = connection->get_remote_uuid();
+              }
+              leader_cache.on_response(group_id,
+                                       target,
+                                       responder,
+                                       std::chrono::steady_clock::now() -
+                                         start);
+          };
+          try {
+              auto response = f.get();
+              on_response();
+              return response;
+          } catch (client::exception::iexception& e) {
+              if (is_connection_error(e)) {
+                  leader_cache.on_failure(group_id, target);
+              } else {
+                  // the target answered, e.g. with an error of the Raft group
+                  on_response();
+              }
+              throw;
+          }
+      });
+}
+
+template<>
+boost::future<boost::optional<client::serialization::pimpl::data>>
+cp_proxy::invoke_and_get_future(client::protocol::ClientMessage& request)
+{
+    return decode_optional_var_sized<client::serialization::pimpl::data>(
+      invoke(request));
+}
+
 atomic_long::atomic_long(const std::string& name,
                          client::spi::ClientContext& context,
                          const raft_group_id& group_id,
@@ -535,8 +610,7 @@ fenced_lock::lock_and_get_fence()
     auto thread_id = util::get_current_thread_id();
     auto invocation_uid = get_context().random_uuid();
 
-    auto do_lock_once = [=]() {
-        auto session_id = session_manager_.acquire_session(group_id_);
+    auto do_lock_in_session = [=](int64_t session_id) {
         verify_locked_session_id_if_present(thread_id, session_id, true);
         return do_lock(session_id, thread_id, invocation_uid)
           .then(boost::launch::sync, [=](boost::future<int64_t> f) {
@@ -576,6 +650,15 @@ fenced_lock::lock_and_get_fence()
           });
     };
 
+    auto do_lock_once = [=]() {
+        return session_manager_.acquire_session_async(group_id_, 1)
+          .then(boost::launch::sync,
+                [=](boost::future<int64_t> session_id) {
+                    return do_lock_in_session(session_id.get());
+                })
+          .unwrap();
+    };
+
     return do_lock_once().then(
       boost::launch::sync, [=](boost::future<int64_t> f) {
           auto result = f.get();
@@ -724,10 +807,9 @@ fenced_lock::try_lock_and_get_fence(std::chrono::milliseconds timeout)
     auto thread_id = util::get_current_thread_id();
     auto invocation_uid = get_context().random_uuid();
 
-    auto do_try_lock_once = [=]() {
+    auto do_try_lock_in_session =
+      [=](std::chrono::steady_clock::time_point start, int64_t session_id) {
         using namespace std::chrono;
-        auto start = steady_clock::now();
-        auto session_id = session_manager_.acquire_session(group_id_);
         verify_locked_session_id_if_present(thread_id, session_id, true);
         return do_try_lock(session_id, thread_id, invocation_uid, timeout)
           .then(boost::launch::sync, [=](boost::future<int64_t> f) {
@@ -759,6 +841,16 @@ fenced_lock::try_lock_and_get_fence(std::chrono::milliseconds timeout)
           });
     };
 
+    auto do_try_lock_once = [=]() {
+        auto start = std::chrono::steady_clock::now();
+        return session_manager_.acquire_session_async(group_id_, 1)
+          .then(boost::launch::sync,
+                [=](boost::future<int64_t> session_id) {
+                    return do_try_lock_in_session(start, session_id.get());
+                })
+          .unwrap();
+    };
+
     return do_try_lock_once().then(
       boost::launch::sync, [=](boost::future<std::pair<int64_t, bool>> f) {
           auto result = f.get();
@@ -976,9 +1068,7 @@ counting_semaphore::init(int32_t permits)
 
     auto request = client::protocol::codec::semaphore_init_encode(
       group_id_, object_name_, permits);
-    return client::spi::impl::ClientInvocation::create(
-             context_, request, object_name_)
-      ->invoke()
+    return invoke(request)
       .then(boost::launch::sync,
             [](boost::future<client::protocol::ClientMessage> f) {
                 return f.get().get_first_fixed_sized_field<bool>();
@@ -1010,9 +1100,7 @@ counting_semaphore::do_release(int32_t permits,
       get_context().get_hazelcast_client_implementation()->random_uuid();
     auto request = codec::semaphore_release_encode(
       group_id_, object_name_, session_id, thread_id, invocation_uid, permits);
-    return to_void_future(client::spi::impl::ClientInvocation::create(
-                            context_, request, object_name_)
-                            ->invoke());
+    return to_void_future(invoke(request));
 }
 
 boost::future<int32_t>
@@ -1020,9 +1108,7 @@ counting_semaphore::available_permits()
 {
     auto request =
       codec::semaphore_availablepermits_encode(group_id_, object_name_);
-    return decode<int32_t>(client::spi::impl::ClientInvocation::create(
-                             context_, request, object_name_)
-                             ->invoke());
+    return decode<int32_t>(invoke(request));
 }
 
 boost::future<void>
@@ -1085,9 +1171,7 @@ sessionless_semaphore::do_try_acquire(int32_t permits,
       invocation_uid,
       permits,
       timeout_ms.count());
-    return client::spi::impl::ClientInvocation::create(
-             context_, request, object_name_)
-      ->invoke()
+    return invoke(request)
       .then(
         boost::launch::sync,
         [=](boost::future<client::protocol::ClientMessage> f) {
@@ -1146,9 +1230,7 @@ sessionless_semaphore::drain_permits()
       internal::session::proxy_session_manager::NO_SESSION_ID,
       cluster_wide_threadId,
       invocation_uid);
-    return decode<int32_t>(client::spi::impl::ClientInvocation::create(
-                             context_, request, object_name_)
-                             ->invoke());
+    return decode<int32_t>(invoke(request));
 }
 
 boost::future<void>
@@ -1164,9 +1246,7 @@ sessionless_semaphore::do_change_permits(int32_t delta)
       cluster_wide_threadId,
       invocation_uid,
       delta);
-    return to_void_future(client::spi::impl::ClientInvocation::create(
-                            context_, request, object_name_)
-                            ->invoke());
+    return to_void_future(invoke(request));
 }
 
 session_semaphore::session_semaphore(
@@ -1200,10 +1280,9 @@ session_semaphore::try_acquire_for_millis(int32_t permits,
     auto invocation_uid =
       get_context().get_hazelcast_client_implementation()->random_uuid();
 
-    auto do_try_acquire_once = ([=]() {
-        auto start = std::chrono::steady_clock::now();
+    auto do_try_acquire_in_session =
+      [=](std::chrono::steady_clock::time_point start, int64_t session_id) {
         auto use_timeout = timeout >= std::chrono::milliseconds::zero();
-        auto session_id = session_manager_.acquire_session(group_id_, permits);
         auto request =
           client::protocol::codec::semaphore_acquire_encode(group_id_,
                                                             object_name_,
@@ -1212,9 +1291,7 @@ session_semaphore::try_acquire_for_millis(int32_t permits,
                                                             invocation_uid,
                                                             permits,
                                                             timeout.count());
-        return client::spi::impl::ClientInvocation::create(
-                 context_, request, object_name_)
-          ->invoke()
+        return invoke(request)
           .then(
             boost::launch::sync,
             [=](boost::future<client::protocol::ClientMessage> f) {
@@ -1251,7 +1328,17 @@ session_semaphore::try_acquire_for_millis(int32_t permits,
                     return std::make_pair(false, false);
                 }
             });
-    });
+    };
+
+    auto do_try_acquire_once = [=]() {
+        auto start = std::chrono::steady_clock::now();
+        return session_manager_.acquire_session_async(group_id_, permits)
+          .then(boost::launch::sync,
+                [=](boost::future<int64_t> session_id) {
+                    return do_try_acquire_in_session(start, session_id.get());
+                })
+          .unwrap();
+    };
 
     return do_try_acquire_once().then(
       boost::launch::sync, [=](boost::future<std::pair<bool, bool>> f) {
@@ -1316,14 +1403,10 @@ session_semaphore::drain_permits()
     auto invocation_uid =
       get_context().get_hazelcast_client_implementation()->random_uuid();
 
-    auto do_drain_once = ([=]() {
-        auto session_id =
-          session_manager_.acquire_session(group_id_, DRAIN_SESSION_ACQ_COUNT);
+    auto do_drain_in_session = [=](int64_t session_id) {
         auto request = client::protocol::codec::semaphore_drain_encode(
           group_id_, object_name_, session_id, thread_id, invocation_uid);
-        return client::spi::impl::ClientInvocation::create(
-                 context_, request, object_name_)
-          ->invoke()
+        return invoke(request)
           .then(
             boost::launch::sync,
             [=](boost::future<client::protocol::ClientMessage> f) {
@@ -1337,7 +1420,17 @@ session_semaphore::drain_permits()
                     return -1;
                 }
             });
-    });
+    };
+
+    auto do_drain_once = [=]() {
+        return session_manager_
+          .acquire_session_async(group_id_, DRAIN_SESSION_ACQ_COUNT)
+          .then(boost::launch::sync,
+                [=](boost::future<int64_t> session_id) {
+                    return do_drain_in_session(session_id.get());
+                })
+          .unwrap();
+    };
 
     return do_drain_once().then(
       boost::launch::sync, [=](boost::future<int32_t> f) {
@@ -1354,27 +1447,41 @@ session_semaphore::drain_permits()
 boost::future<void>
 session_semaphore::do_change_permits(int32_t delta)
 {
-    auto session_id =
-      session_manager_.acquire_session(group_id_, DRAIN_SESSION_ACQ_COUNT);
     auto thread_id = get_thread_id();
     auto invocation_uid =
       get_context().get_hazelcast_client_implementation()->random_uuid();
 
-    auto request = client::protocol::codec::semaphore_change_encode(
-      group_id_, object_name_, session_id, thread_id, invocation_uid, delta);
-    return client::spi::impl::ClientInvocation::create(
-             context_, request, object_name_)
-      ->invoke()
+    auto do_change_in_session = [=](int64_t session_id) {
+        auto request =
+          client::protocol::codec::semaphore_change_encode(group_id_,
+                                                           object_name_,
+                                                           session_id,
+                                                           thread_id,
+                                                           invocation_uid,
+                                                           delta);
+        return invoke(request)
+          .then(boost::launch::sync,
+                [=](boost::future<client::protocol::ClientMessage> f) {
+                    try {
+                        f.get();
+                        session_manager_.release_session(group_id_,
+                                                         session_id);
+                    } catch (client::exception::session_expired&) {
+                        session_manager_.invalidate_session(group_id_,
+                                                            session_id);
+                        throw_illegal_state_exception(
+                          std::current_exception());
+                    }
+                });
+    };
+
+    return session_manager_
+      .acquire_session_async(group_id_, DRAIN_SESSION_ACQ_COUNT)
       .then(boost::launch::sync,
-            [=](boost::future<client::protocol::ClientMessage> f) {
-                try {
-                    f.get();
-                    session_manager_.release_session(group_id_, session_id);
-                } catch (client::exception::session_expired&) {
-                    session_manager_.invalidate_session(group_id_, session_id);
-                    throw_illegal_state_exception(std::current_exception());
-                }
-            });
+            [=](boost::future<int64_t> session_id) {
+                return do_change_in_session(session_id.get());
+            })
+      .unwrap();
 }
 } // namespace cp
 } // namespace hazelcast
@@ -14,21 +14,187 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+
 #include <boost/thread/shared_lock_guard.hpp>
 #include <boost/container_hash/hash.hpp>
 
 #include "hazelcast/cp/cp_impl.h"
 #include "hazelcast/cp/cp.h"
 #include "hazelcast/client/exception/protocol_exceptions.h"
+#include "hazelcast/client/initial_membership_event.h"
+#include "hazelcast/client/membership_event.h"
+#include "hazelcast/client/membership_listener.h"
 #include "hazelcast/client/protocol/codec/codecs.h"
 #include "hazelcast/client/spi/ClientContext.h"
 #include "hazelcast/client/spi/impl/ClientInvocation.h"
 #include "hazelcast/client/spi/impl/ClientExecutionServiceImpl.h"
+#include "hazelcast/client/spi/impl/ClientClusterServiceImpl.h"
 #include "hazelcast/client/proxy/SerializingProxy.h"
 
 namespace hazelcast {
 namespace cp {
 namespace internal {
+constexpr int64_t raft_group_leader_cache::PROBE_INTERVAL;
+constexpr int64_t raft_group_leader_cache::RESPONSE_TIME_SMOOTHING;
+constexpr int64_t raft_group_leader_cache::UNREACHABLE;
+constexpr size_t raft_group_leader_cache::UNKNOWN_MEMBER_COUNT;
+
+raft_group_leader_cache::raft_group_leader_cache(
+  client::spi::ClientContext& context)
+  : context_(context)
+{}
+
+void
+raft_group_leader_cache::start()
+{
+    context_.get_client_cluster_service().add_membership_listener(
+      client::membership_listener()
+        .on_init([this](const client::initial_membership_event&) {
+            on_member_list_changed();
+        })
+        .on_joined([this](const client::membership_event&) {
+            on_member_list_changed();
+        })
+        .on_left([this](const client::membership_event& event) {
+            on_member_left(event.get_member().get_uuid());
+        }));
+}
+
+void
+raft_group_leader_cache::on_member_left(boost::uuids::uuid member_uuid)
+{
+    std::lock_guard<std::mutex> guard(lock_);
+    for (auto& group : groups_) {
+        auto& state = group.second;
+        state.response_nanos.erase(member_uuid);
+        elect_leader(state);
+        state.member_count = UNKNOWN_MEMBER_COUNT;
+    }
+}
+
+void
+raft_group_leader_cache::on_member_list_changed()
+{
+    // the next invocation of each group reads the member list again and
+    // probes the new members
+    std::lock_guard<std::mutex> guard(lock_);
+    for (auto& group : groups_) {
+        group.second.member_count = UNKNOWN_MEMBER_COUNT;
+    }
+}
+
+boost::uuids::uuid
+raft_group_leader_cache::get_target(const raft_group_id& group_id)
+{
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        auto& state = groups_[group_id];
+        if (!state.leader.is_nil() &&
+            state.response_nanos.size() >= state.member_count &&
+            ++state.invocation_count % PROBE_INTERVAL != 0) {
+            return state.leader;
+        }
+    }
+
+    std::vector<boost::uuids::uuid> members;
+    for (const auto& m :
+         context_.get_client_cluster_service().get_member_list()) {
+        if (!m.is_lite_member()) {
+            members.push_back(m.get_uuid());
+        }
+    }
+
+    std::lock_guard<std::mutex> guard(lock_);
+    auto& state = groups_[group_id];
+    // forget the members which left the cluster
+    for (auto it = state.response_nanos.begin();
+         it != state.response_nanos.end();) {
+        if (std::find(members.begin(), members.end(), it->first) ==
+            members.end()) {
+            it = state.response_nanos.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    elect_leader(state);
+    state.member_count = members.size();
+
+    if (members.empty()) {
+        return boost::uuids::uuid{};
+    }
+    for (const auto& m : members) {
+        if (state.response_nanos.find(m) == state.response_nanos.end()) {
+            return m;
+        }
+    }
+    return members[state.next_probe++ % members.size()];
+}
+
+void
+raft_group_leader_cache::on_response(
+  const raft_group_id& group_id,
+  boost::uuids::uuid target,
+  boost::uuids::uuid responder,
+  std::chrono::steady_clock::duration response_time)
+{
+    if (target.is_nil()) {
+        return;
+    }
+
+    auto nanos =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(response_time)
+        .count();
+    std::lock_guard<std::mutex> guard(lock_);
+    auto& state = groups_[group_id];
+    auto& smoothed = state.response_nanos[target];
+    if (responder != target) {
+        // the client is not connected to the target
+        smoothed = UNREACHABLE;
+    } else if (smoothed == 0 || smoothed == UNREACHABLE) {
+        smoothed = (std::max)(nanos, static_cast<int64_t>(1));
+    } else {
+        smoothed += (nanos - smoothed) / RESPONSE_TIME_SMOOTHING;
+    }
+    elect_leader(state);
+}
+
+void
+raft_group_leader_cache::on_failure(const raft_group_id& group_id,
+                                    boost::uuids::uuid target)
+{
+    if (target.is_nil()) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> guard(lock_);
+    auto& state = groups_[group_id];
+    state.response_nanos[target] = UNREACHABLE;
+    elect_leader(state);
+}
+
+boost::uuids::uuid
+raft_group_leader_cache::get_leader(const raft_group_id& group_id)
+{
+    std::lock_guard<std::mutex> guard(lock_);
+    auto state = groups_.find(group_id);
+    return state == groups_.end() ? boost::uuids::uuid{}
+                                  : state->second.leader;
+}
+
+void
+raft_group_leader_cache::elect_leader(group_state& state)
+{
+    state.leader = boost::uuids::uuid{};
+    auto fastest = UNREACHABLE;
+    for (const auto& member : state.response_nanos) {
+        if (member.second < fastest) {
+            fastest = member.second;
+            state.leader = member.first;
+        }
+    }
+}
+
 namespace session {
 constexpr int64_t proxy_session_manager::NO_SESSION_ID;
 constexpr int64_t proxy_session_manager::SHUTDOWN_TIMEOUT_SECONDS;
@@ -40,70 +206,159 @@ proxy_session_manager::proxy_session_manager(
 int64_t
 proxy_session_manager::acquire_session(const raft_group_id& group_id)
 {
-    return get_or_create_session(group_id).acquire(1);
+    return acquire_session(group_id, 1);
 }
 
 int64_t
 proxy_session_manager::acquire_session(const raft_group_id& group_id,
                                        int32_t count)
 {
-    return get_or_create_session(group_id).acquire(count);
+    return acquire_session_async(group_id, count).get();
 }
 
-proxy_session_manager::session_state&
-proxy_session_manager::get_or_create_session(const raft_group_id& group_id)
+boost::future<int64_t>
+proxy_session_manager::acquire_session_async(const raft_group_id& group_id,
+                                             int32_t count)
 {
-    boost::upgrade_lock<boost::shared_mutex> read_lock(lock_);
+    {
+        boost::shared_lock<boost::shared_mutex> read_lock(lock_);
+        check_running();
+        auto session = sessions_.find(group_id);
+        if (session != sessions_.end() && session->second.is_valid()) {
+            return boost::make_ready_future(session->second.acquire(count));
+        }
+    }
+
+    boost::shared_future<session_response> creation;
+    std::shared_ptr<boost::promise<session_response>> creation_promise;
+    {
+        boost::unique_lock<boost::shared_mutex> write_lock(lock_);
+        check_running();
+        auto session = sessions_.find(group_id);
+        if (session != sessions_.end() && session->second.is_valid()) {
+            return boost::make_ready_future(session->second.acquire(count));
+        }
+        auto pending = pending_sessions_.find(group_id);
+        if (pending != pending_sessions_.end()) {
+            creation = pending->second;
+        } else {
+            creation_promise =
+              std::make_shared<boost::promise<session_response>>();
+            creation = creation_promise->get_future().share();
+            pending_sessions_.emplace(group_id, creation);
+        }
+    }
 
+    // the request is sent after the lock is released, its response may
+    // already be there when the continuation is attached
+    if (creation_promise) {
+        create_new_session(group_id, creation_promise);
+    }
+
+    return creation
+      .then(boost::launch::sync,
+            [=](boost::shared_future<session_response> f)
+              -> boost::future<int64_t> {
+                auto session_id = f.get().id;
+                {
+                    boost::shared_lock<boost::shared_mutex> read_lock(lock_);
+                    auto session = sessions_.find(group_id);
+                    if (session != sessions_.end() &&
+                        session->second.id == session_id) {
+                        return boost::make_ready_future(
+                          session->second.acquire(count));
+                    }
+                }
+                // the new session is invalidated before it could be acquired
+                return acquire_session_async(group_id, count);
+            })
+      .unwrap();
+}
+
+void
+proxy_session_manager::check_running() const
+{
     if (!running_) {
         BOOST_THROW_EXCEPTION(client::exception::hazelcast_instance_not_active(
-          "proxy_session_manager::get_or_create_session",
+          "proxy_session_manager::acquire_session",
           "Session manager is already shut down!"));
     }
+}
 
-    auto session = sessions_.find(group_id);
-    if (session == sessions_.end() || !session->second.is_valid()) {
-        // upgrade to write lock
-        boost::upgrade_to_unique_lock<boost::shared_mutex> write_lock(
-          read_lock);
-        session = sessions_.find(group_id);
-        if (session == sessions_.end() || !session->second.is_valid()) {
-            session = create_new_session(group_id);
+void
+proxy_session_manager::create_new_session(
+  const raft_group_id& group_id,
+  std::shared_ptr<boost::promise<session_response>> creation)
+{
+    auto fail = [=](boost::exception_ptr e) {
+        {
+            boost::unique_lock<boost::shared_mutex> write_lock(lock_);
+            pending_sessions_.erase(group_id);
         }
+        creation->set_exception(e);
+    };
+
+    try {
+        request_new_session(group_id).then(
+          boost::launch::sync, [=](boost::future<session_response> f) {
+              try {
+                  auto response = f.get();
+                  install_session(group_id, response);
+                  creation->set_value(response);
+              } catch (...) {
+                  fail(boost::current_exception());
+              }
+          });
+    } catch (...) {
+        fail(boost::current_exception());
     }
-    return session->second;
 }
 
-std::unordered_map<raft_group_id,
-                   proxy_session_manager::session_state>::iterator
-proxy_session_manager::create_new_session(const raft_group_id& group_id)
+void
+proxy_session_manager::install_session(const raft_group_id& group_id,
+                                       const session_response& response)
 {
-    // the lock_ is already acquired as write lock
-    auto response = request_new_session(group_id);
-    session_state state { response.id , response.ttl_millis };
-
-    auto result = sessions_.emplace( group_id, state );
+    {
+        boost::unique_lock<boost::shared_mutex> write_lock(lock_);
+        pending_sessions_.erase(group_id);
+        if (!running_) {
+            // the session is created after the shutdown, nobody will use it
+            close_session(group_id, response.id);
+            BOOST_THROW_EXCEPTION(
+              client::exception::hazelcast_instance_not_active(
+                "proxy_session_manager::install_session",
+                "Session manager is already shut down!"));
+        }
 
-    if(!result.second)
-        result.first->second = state;
+        session_state state{ response.id, response.ttl_millis };
+        auto result = sessions_.emplace(group_id, state);
+        if (!result.second) {
+            result.first->second = state;
+        }
+    }
 
     schedule_heartbeat_task(response.heartbeat_millis);
-    return result.first;
 }
 
-proxy_session_manager::session_response
+boost::future<proxy_session_manager::session_response>
 proxy_session_manager::request_new_session(const raft_group_id& group_id)
 {
     auto request = client::protocol::codec::cpsession_createsession_encode(
       group_id, client_.get_name());
-    auto response = client::spi::impl::ClientInvocation::create(
-                      client_, request, "sessionManager")
-                      ->invoke()
-                      .get();
-    auto session_id = response.get_first_fixed_sized_field<int64_t>();
-    auto ttl_millis = response.get<int64_t>();
-    auto hearbeat_millis = response.get<int64_t>();
-    return { session_id, ttl_millis, hearbeat_millis };
+    return client::spi::impl::ClientInvocation::create(
+             client_, request, "sessionManager")
+      ->invoke()
+      .then(boost::launch::sync,
+            [](boost::future<client::protocol::ClientMessage> f) {
+                auto response = f.get();
+                auto session_id =
+                  response.get_first_fixed_sized_field<int64_t>();
+                auto ttl_millis = response.get<int64_t>();
+                auto hearbeat_millis = response.get<int64_t>();
+                return session_response{ session_id,
+                                         ttl_millis,
+                                         hearbeat_millis };
+            });
 }
 
 void
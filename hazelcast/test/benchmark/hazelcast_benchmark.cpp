@@ -14,6 +14,19 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
 #include <benchmark/benchmark.h>
 #include <hazelcast/client/hazelcast_client.h>
 
@@ -58,8 +71,351 @@ map_remove(benchmark::State& state)
     }
 }
 
+/**
+ * @return the map of a client which runs the given number of io threads and
+ * opens the given number of connections per member, the clients are shared
+ * between the benchmark threads
+ */
+static std::shared_ptr<imap>
+io_layout_map(int io_threads, int connections_per_member)
+{
+    static std::mutex clients_mutex;
+    static std::map<std::pair<int, int>, hazelcast_client> clients;
+
+    std::lock_guard<std::mutex> guard(clients_mutex);
+    auto key = std::make_pair(io_threads, connections_per_member);
+    auto it = clients.find(key);
+    if (it == clients.end()) {
+        client_config config;
+        config.set_property(client_properties::IO_THREAD_COUNT,
+                            std::to_string(io_threads));
+        config.get_network_config().set_connections_per_member(
+          connections_per_member);
+        it = clients
+               .emplace(key, hazelcast::new_client(std::move(config)).get())
+               .first;
+    }
+    return it->second.get_map("map_put").get();
+}
+
+static void
+map_put_io_layout(benchmark::State& state)
+{
+    auto map = io_layout_map(static_cast<int>(state.range(0)),
+                             static_cast<int>(state.range(1)));
+    int number_of_puts = 0;
+    for (auto _ : state) {
+        auto key = rand() % 10000;
+        map->put(key, key).get();
+        state.counters["Put Rate"] =
+          benchmark::Counter(++number_of_puts, benchmark::Counter::kIsRate);
+    }
+}
+
+// shared io_context (1 io thread) vs sharded io_contexts for different
+// numbers of connections per member
+static void
+io_layouts(benchmark::internal::Benchmark* benchmark)
+{
+    benchmark->ArgNames({ "io_threads", "connections_per_member" });
+    for (int io_threads : { 1, 4 }) {
+        for (int connections_per_member : { 1, 2, 4, 8 }) {
+            benchmark->Args({ io_threads, connections_per_member });
+        }
+    }
+}
+
+/**
+ * map get latency when the futures are completed by the user executor (arg 0)
+ * vs inline on the io thread (arg 1), reported as p50/p99 in microseconds
+ */
+static void
+map_get_completion(benchmark::State& state)
+{
+    auto inline_completion = state.range(0) != 0;
+    auto map =
+      client.get_map(inline_completion ? "map_get_inline" : "map_get").get();
+    map->set_inline_completion(inline_completion);
+
+    std::vector<double> latencies;
+    latencies.reserve(1 << 16);
+    for (auto _ : state) {
+        auto key = rand() % 10000;
+        auto start = std::chrono::steady_clock::now();
+        map->get<int, int>(key).get();
+        latencies.push_back(std::chrono::duration<double, std::micro>(
+                              std::chrono::steady_clock::now() - start)
+                              .count());
+    }
+
+    if (latencies.empty()) {
+        return;
+    }
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&latencies](double p) {
+        return latencies[static_cast<size_t>(p * (latencies.size() - 1))];
+    };
+    state.counters["p50_us"] =
+      benchmark::Counter(percentile(0.50), benchmark::Counter::kAvgThreads);
+    state.counters["p99_us"] =
+      benchmark::Counter(percentile(0.99), benchmark::Counter::kAvgThreads);
+}
+
+/**
+ * @return the map of a client which deserializes bulk results in chunks of
+ * the given size (0 for single threaded deserialization), the map is filled
+ * with 100k entries once
+ */
+static std::shared_ptr<imap>
+bulk_map(int chunk_size)
+{
+    static std::mutex clients_mutex;
+    static std::map<int, hazelcast_client> clients;
+    static bool filled = false;
+
+    std::lock_guard<std::mutex> guard(clients_mutex);
+    auto it = clients.find(chunk_size);
+    if (it == clients.end()) {
+        client_config config;
+        config.set_property(client_properties::DESERIALIZATION_CHUNK_SIZE,
+                            std::to_string(chunk_size));
+        it = clients
+               .emplace(chunk_size,
+                        hazelcast::new_client(std::move(config)).get())
+               .first;
+    }
+    auto map = it->second.get_map("bulk_map").get();
+    if (!filled) {
+        std::unordered_map<int, std::string> entries;
+        for (int i = 0; i < 100000; ++i) {
+            entries.emplace(i, "value-" + std::to_string(i));
+        }
+        map->put_all(entries).get();
+        filled = true;
+    }
+    return map;
+}
+
+static void
+map_entry_set_deserialization(benchmark::State& state)
+{
+    auto map = bulk_map(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(map->entry_set<int, std::string>().get());
+    }
+    state.SetItemsProcessed(state.iterations() * 100000);
+}
+
+static void
+map_get_all_deserialization(benchmark::State& state)
+{
+    auto map = bulk_map(static_cast<int>(state.range(0)));
+    std::unordered_set<int> keys;
+    for (int i = 0; i < 100000; ++i) {
+        keys.insert(i);
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(map->get_all<int, std::string>(keys).get());
+    }
+    state.SetItemsProcessed(state.iterations() * 100000);
+}
+
+static void
+sql_full_scan(benchmark::State& state)
+{
+    (void)bulk_map(0);
+    client.get_sql()
+      .execute("CREATE OR REPLACE MAPPING bulk_map (__key INT, this VARCHAR) "
+               "TYPE IMap OPTIONS ('keyFormat' = 'int', "
+               "'valueFormat' = 'varchar')")
+      .get();
+
+    sql::sql_statement statement(client, "SELECT __key, this FROM bulk_map");
+    statement.prefetch_depth(static_cast<int32_t>(state.range(0)));
+    for (auto _ : state) {
+        auto result = client.get_sql().execute(statement).get();
+        for (auto itr = result->iterator(); itr.has_next();) {
+            benchmark::DoNotOptimize(itr.next().get());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * 100000);
+}
+
+/**
+ * @return a map with a near cache (OBJECT in memory format), the 10k entries
+ * of the map are put and loaded into the near cache once
+ */
+static std::shared_ptr<imap>
+near_cached_map()
+{
+    static std::mutex client_mutex;
+    static std::unique_ptr<hazelcast_client> near_cache_client;
+    static std::shared_ptr<imap> map;
+
+    std::lock_guard<std::mutex> guard(client_mutex);
+    if (!map) {
+        client_config config;
+        config::near_cache_config near_cache("near_cached_map");
+        near_cache.set_in_memory_format(config::OBJECT);
+        config.add_near_cache_config(near_cache);
+        near_cache_client.reset(
+          new hazelcast_client(hazelcast::new_client(std::move(config)).get()));
+        map = near_cache_client->get_map("near_cached_map").get();
+        for (int i = 0; i < 10000; ++i) {
+            map->put(i, i).get();
+        }
+        for (int i = 0; i < 10000; ++i) {
+            map->get<int, int>(i).get();
+        }
+    }
+    return map;
+}
+
+static void
+near_cache_get(benchmark::State& state)
+{
+    auto map = near_cached_map();
+    int key = static_cast<int>(state.thread_index()) * 313;
+    for (auto _ : state) {
+        key = (key + 1) % 10000;
+        benchmark::DoNotOptimize(map->get<int, int>(key).get());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+/**
+ * @return a map of 100k entries with a near cache of 1000 entries which uses
+ * the LRU eviction policy and the given admission policy
+ */
+static std::shared_ptr<imap>
+bounded_near_cached_map(bool tiny_lfu)
+{
+    static std::mutex client_mutex;
+    static std::unique_ptr<hazelcast_client> near_cache_client;
+
+    std::lock_guard<std::mutex> guard(client_mutex);
+    if (!near_cache_client) {
+        client_config config;
+        for (auto admission_policy : { config::eviction_config::ALWAYS,
+                                       config::eviction_config::TINY_LFU }) {
+            config::near_cache_config near_cache(
+              admission_policy == config::eviction_config::ALWAYS
+                ? "bounded_near_cached_map_always"
+                : "bounded_near_cached_map_tiny_lfu");
+            near_cache.set_in_memory_format(config::OBJECT);
+            near_cache.get_eviction_config()
+              .set_eviction_policy(config::LRU)
+              .set_maximum_size_policy(config::eviction_config::ENTRY_COUNT)
+              .set_size(1000)
+              .set_admission_policy(admission_policy);
+            config.add_near_cache_config(near_cache);
+        }
+        near_cache_client.reset(
+          new hazelcast_client(hazelcast::new_client(std::move(config)).get()));
+        std::unordered_map<int, int> entries;
+        for (int i = 0; i < 100000; ++i) {
+            entries.emplace(i, i);
+        }
+        near_cache_client->get_map("bounded_near_cached_map_always")
+          .get()
+          ->put_all(entries)
+          .get();
+        near_cache_client->get_map("bounded_near_cached_map_tiny_lfu")
+          .get()
+          ->put_all(entries)
+          .get();
+    }
+    return near_cache_client
+      ->get_map(tiny_lfu ? "bounded_near_cached_map_tiny_lfu"
+                         : "bounded_near_cached_map_always")
+      .get();
+}
+
+/**
+ * @return the keys of a zipfian (skew 0.99) access trace over 100k keys, with
+ * a sequential scan of 2000 keys after every 4096 accesses if requested
+ */
+static std::vector<int>
+near_cache_trace(bool with_scans)
+{
+    std::vector<double> weights;
+    for (int i = 1; i <= 100000; ++i) {
+        weights.push_back(1.0 / std::pow(i, 0.99));
+    }
+    std::mt19937 random(42);
+    std::discrete_distribution<int> zipf(weights.begin(), weights.end());
+
+    std::vector<int> trace;
+    int scan_start = 50000;
+    for (int i = 0; i < 1 << 16; ++i) {
+        trace.push_back(zipf(random));
+        if (with_scans && i % 4096 == 4095) {
+            for (int j = 0; j < 2000; ++j) {
+                trace.push_back(scan_start++ % 100000);
+            }
+        }
+    }
+    return trace;
+}
+
+static void
+near_cache_hit_ratio(benchmark::State& state)
+{
+    auto map = bounded_near_cached_map(state.range(0) != 0);
+    auto trace = near_cache_trace(state.range(1) != 0);
+    auto stats = map->get_local_map_stats().get_near_cache_stats();
+    int64_t hits = stats->get_hits();
+    int64_t misses = stats->get_misses();
+    size_t next = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(map->get<int, int>(trace[next]).get());
+        next = (next + 1) % trace.size();
+    }
+    hits = stats->get_hits() - hits;
+    misses = stats->get_misses() - misses;
+    state.counters["hit_ratio"] =
+      hits + misses == 0 ? 0 : static_cast<double>(hits) / (hits + misses);
+    state.SetItemsProcessed(state.iterations());
+}
+
+// needs a cluster with the CP subsystem enabled
+static void
+cp_atomic_long_increment(benchmark::State& state)
+{
+    static auto counter =
+      client.get_cp_subsystem().get_atomic_long("cp_atomic_long").get();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(counter->increment_and_get().get());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
 BENCHMARK(map_put)->Threads(32);
 BENCHMARK(map_get)->Threads(32);
 BENCHMARK(map_remove)->Threads(32);
+BENCHMARK(map_put_io_layout)->Apply(io_layouts)->Threads(32);
+BENCHMARK(map_get_completion)->ArgName("inline")->Arg(0)->Arg(1)->Threads(32);
+// single threaded (0) vs parallel chunked deserialization
+BENCHMARK(map_entry_set_deserialization)
+  ->ArgName("chunk_size")
+  ->Arg(0)
+  ->Arg(4096)
+  ->Unit(benchmark::kMillisecond);
+BENCHMARK(sql_full_scan)
+  ->ArgName("prefetch_depth")
+  ->Arg(0)
+  ->Arg(2)
+  ->UseRealTime();
+BENCHMARK(near_cache_get)->ThreadRange(1, 32)->UseRealTime();
+BENCHMARK(near_cache_hit_ratio)
+  ->ArgNames({ "tiny_lfu", "scans" })
+  ->ArgsProduct({ { 0, 1 }, { 0, 1 } })
+  ->Iterations(1 << 17);
+BENCHMARK(map_get_all_deserialization)
+  ->ArgName("chunk_size")
+  ->Arg(0)
+  ->Arg(4096)
+  ->Unit(benchmark::kMillisecond);
+BENCHMARK(cp_atomic_long_increment)->Threads(8)->UseRealTime();
 
 BENCHMARK_MAIN();
@@ -16,8 +16,10 @@
 
 #include <chrono>
 #include <cmath>
+#include <functional>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <ostream>
 #include <thread>
 #include <unordered_set>
@@ -44,10 +46,13 @@
 #include <hazelcast/client/imap.h>
 #include <hazelcast/client/impl/Partition.h>
 #include <hazelcast/client/initial_membership_event.h>
+#include <hazelcast/client/internal/socket/BaseSocket.h>
+#include <hazelcast/client/internal/socket/SocketFactory.h>
 #include <hazelcast/client/itopic.h>
 #include <hazelcast/client/lifecycle_listener.h>
 #include <hazelcast/client/membership_listener.h>
 #include <hazelcast/client/multi_map.h>
+#include <hazelcast/client/protocol/codec/codecs.h>
 #include <hazelcast/client/proxy/PNCounterImpl.h>
 #include <hazelcast/client/reliable_topic.h>
 #include <hazelcast/client/serialization/pimpl/data_input.h>
@@ -56,6 +61,7 @@
 #include <hazelcast/client/socket_interceptor.h>
 #include <hazelcast/client/socket.h>
 #include <hazelcast/client/spi/ClientContext.h>
+#include <hazelcast/client/spi/impl/ClientInvocation.h>
 #include <hazelcast/logger.h>
 #include <hazelcast/util/AddressHelper.h>
 #include <hazelcast/util/AddressUtil.h>
@@ -1293,6 +1299,243 @@ TEST_F(ClientConnectionTest, testTcpSocketTimeoutToOutsideNetwork)
                  exception::illegal_state);
 }
 
+TEST_F(ClientConnectionTest, test_connections_per_member_are_replaced)
+{
+    HazelcastServer instance1(default_server_factory());
+    HazelcastServer instance2(default_server_factory());
+
+    client_config config;
+    config.get_network_config().set_connections_per_member(3);
+    auto client = hazelcast::new_client(std::move(config)).get();
+    ASSERT_EQ_EVENTUALLY(2, client.get_cluster().get_members().size());
+
+    spi::ClientContext context(client);
+    auto& connection_manager = context.get_connection_manager();
+    auto members = client.get_cluster().get_members();
+    for (const auto& m : members) {
+        ASSERT_EQ_EVENTUALLY(
+          3U, connection_manager.get_member_connections(m.get_uuid()).size());
+    }
+    ASSERT_EQ(2U, connection_manager.get_active_connections().size());
+    ASSERT_EQ(6U, connection_manager.get_all_connections().size());
+
+    // the member has all its connections and none of them is the closed one
+    auto replaced = [&](boost::uuids::uuid member_uuid,
+                        const std::shared_ptr<connection::Connection>& closed) {
+        auto connections =
+          connection_manager.get_member_connections(member_uuid);
+        for (const auto& c : connections) {
+            if (c == closed || !c->is_alive()) {
+                return false;
+            }
+        }
+        return connections.size() == 3;
+    };
+
+    auto member_uuid = members[0].get_uuid();
+    auto extra_connection =
+      connection_manager.get_member_connections(member_uuid)[1];
+    extra_connection->close("Closed by the test");
+    ASSERT_TRUE_EVENTUALLY(replaced(member_uuid, extra_connection));
+    ASSERT_EQ_EVENTUALLY(6U, connection_manager.get_all_connections().size());
+
+    // the extra connections are closed together with the member connection
+    auto member_connection = connection_manager.get_connection(member_uuid);
+    member_connection->close("Closed by the test");
+    ASSERT_TRUE_EVENTUALLY(replaced(member_uuid, member_connection));
+    ASSERT_EQ_EVENTUALLY(6U, connection_manager.get_all_connections().size());
+    ASSERT_EQ(3U,
+              connection_manager.get_member_connections(members[1].get_uuid())
+                .size());
+
+    client.shutdown().get();
+}
+
+namespace {
+/**
+ * A stream which records the gather writes made to it. The first write is
+ * kept in flight until release_first_write is called.
+ */
+class recording_stream
+{
+public:
+    using executor_type = boost::asio::io_context::executor_type;
+
+    struct write
+    {
+        size_t buffer_count;
+        std::vector<char> bytes;
+    };
+
+    explicit recording_stream(boost::asio::io_context& io)
+      : io_(io)
+      , socket_(io)
+    {}
+
+    executor_type get_executor() { return io_.get_executor(); }
+
+    boost::asio::ip::tcp::socket& lowest_layer() { return socket_; }
+
+    const boost::asio::ip::tcp::socket& lowest_layer() const
+    {
+        return socket_;
+    }
+
+    template<typename ConstBufferSequence, typename WriteHandler>
+    void async_write_some(const ConstBufferSequence& buffers,
+                          WriteHandler&& handler)
+    {
+        write w{ 0, {} };
+        for (auto it = boost::asio::buffer_sequence_begin(buffers);
+             it != boost::asio::buffer_sequence_end(buffers);
+             ++it) {
+            boost::asio::const_buffer buffer(*it);
+            auto data = static_cast<const char*>(buffer.data());
+            w.bytes.insert(w.bytes.end(), data, data + buffer.size());
+            ++w.buffer_count;
+        }
+        auto bytes_written = w.bytes.size();
+        auto shared_handler =
+          std::make_shared<typename std::decay<WriteHandler>::type>(
+            std::forward<WriteHandler>(handler));
+        std::function<void()> complete = [shared_handler, bytes_written]() {
+            (*shared_handler)(boost::system::error_code(), bytes_written);
+        };
+
+        std::lock_guard<std::mutex> guard(lock_);
+        writes_.push_back(std::move(w));
+        if (writes_.size() == 1) {
+            in_flight_ = std::move(complete);
+        } else {
+            boost::asio::post(io_, std::move(complete));
+        }
+    }
+
+    template<typename MutableBufferSequence, typename ReadHandler>
+    void async_read_some(const MutableBufferSequence&, ReadHandler&&)
+    {}
+
+    template<typename ConstBufferSequence>
+    size_t write_some(const ConstBufferSequence& buffers)
+    {
+        return boost::asio::buffer_size(buffers);
+    }
+
+    template<typename ConstBufferSequence>
+    size_t write_some(const ConstBufferSequence& buffers,
+                      boost::system::error_code&)
+    {
+        return boost::asio::buffer_size(buffers);
+    }
+
+    void release_first_write()
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        boost::asio::post(io_, std::move(in_flight_));
+    }
+
+    std::vector<write> writes()
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        return writes_;
+    }
+
+private:
+    boost::asio::io_context& io_;
+    boost::asio::ip::tcp::socket socket_;
+    std::mutex lock_;
+    std::vector<write> writes_;
+    std::function<void()> in_flight_;
+};
+
+class recording_socket
+  : public internal::socket::BaseSocket<recording_stream>
+{
+public:
+    using BaseSocket::BaseSocket;
+
+    recording_stream& stream() { return socket_; }
+};
+
+std::vector<char>
+bytes_of(const protocol::ClientMessage& message)
+{
+    std::vector<char> bytes;
+    for (const auto& block : message.get_buffer()) {
+        bytes.insert(bytes.end(), block.begin(), block.end());
+    }
+    return bytes;
+}
+} // namespace
+
+TEST_F(ClientConnectionTest, test_queued_messages_are_written_in_one_batch)
+{
+    HazelcastServer instance(default_server_factory());
+    auto client = hazelcast::new_client(get_config()).get();
+    spi::ClientContext context(client);
+
+    boost::asio::io_context io;
+    auto run_ready_handlers = [&io]() {
+        io.restart();
+        io.poll();
+    };
+    boost::asio::ip::tcp::resolver resolver(io);
+    internal::socket::SocketFactory socket_factory(context, { &io }, resolver);
+    std::chrono::milliseconds connect_timeout(1000);
+    address member_address("127.0.0.1", 5701);
+    auto connection =
+      std::make_shared<connection::Connection>(member_address,
+                                               context,
+                                               -1,
+                                               socket_factory,
+                                               context.get_connection_manager(),
+                                               connect_timeout);
+    config::socket_options socket_options;
+    recording_socket socket(
+      resolver, member_address, socket_options, io, connect_timeout);
+
+    std::vector<std::shared_ptr<spi::impl::ClientInvocation>> invocations;
+    for (int i = 0; i < 5; ++i) {
+        invocations.push_back(spi::impl::ClientInvocation::create(
+          context,
+          std::make_shared<protocol::ClientMessage>(
+            protocol::codec::map_size_encode("map_" + std::to_string(i))),
+          "map"));
+    }
+
+    socket.async_write(connection, invocations[0]);
+    run_ready_handlers();
+    ASSERT_EQ(1U, socket.stream().writes().size());
+
+    // the messages are queued behind the write in flight
+    for (int i = 1; i < 5; ++i) {
+        socket.async_write(connection, invocations[i]);
+    }
+    run_ready_handlers();
+    ASSERT_EQ(1U, socket.stream().writes().size());
+
+    socket.stream().release_first_write();
+    run_ready_handlers();
+    ASSERT_EQ(2U, socket.stream().writes().size());
+
+    auto writes = socket.stream().writes();
+    ASSERT_EQ(bytes_of(*invocations[0]->get_client_message()),
+              writes[0].bytes);
+    std::vector<char> batch;
+    size_t buffer_count = 0;
+    for (int i = 1; i < 5; ++i) {
+        auto& message = *invocations[i]->get_client_message();
+        auto bytes = bytes_of(message);
+        batch.insert(batch.end(), bytes.begin(), bytes.end());
+        buffer_count += message.get_buffer().size();
+    }
+    ASSERT_EQ(buffer_count, writes[1].buffer_count);
+    ASSERT_EQ(batch, writes[1].bytes);
+    ASSERT_TRUE(connection->is_alive());
+
+    client.shutdown().get();
+}
+
 #ifdef HZ_BUILD_WITH_SSL
 TEST_F(ClientConnectionTest, testSslSocketTimeoutToOutsideNetwork)
 {
@@ -1615,7 +1858,9 @@ TEST_F(SocketOptionsTest, testConfiguration)
       .set_reuse_address(true)
       .set_tcp_no_delay(false)
       .set_linger_seconds(5)
-      .set_buffer_size_in_bytes(bufferSize);
+      .set_buffer_size_in_bytes(bufferSize)
+      .set_max_write_batch_size_in_bytes(bufferSize)
+      .set_max_write_batch_buffers(16);
 
     auto client = hazelcast::new_client(std::move(clientConfig)).get();
 
@@ -1625,6 +1870,8 @@ TEST_F(SocketOptionsTest, testConfiguration)
     ASSERT_FALSE(socketOptions.is_tcp_no_delay());
     ASSERT_EQ(5, socketOptions.get_linger_seconds());
     ASSERT_EQ(bufferSize, socketOptions.get_buffer_size_in_bytes());
+    ASSERT_EQ(bufferSize, socketOptions.get_max_write_batch_size_in_bytes());
+    ASSERT_EQ(16, socketOptions.get_max_write_batch_buffers());
 
     client.shutdown().get();
 }
@@ -2407,6 +2654,33 @@ TEST_F(FlakeIdGeneratorApiTest, testSmoke)
     ASSERT_EQ(4 * NUM_IDS_PER_THREAD, allIds.size());
 }
 
+TEST_F(FlakeIdGeneratorApiTest, testNewIds)
+{
+    // smaller than the prefetch count, served from the prefetched ids
+    auto small_batch = flake_id_generator_->new_ids(4).get();
+    ASSERT_EQ(4, small_batch.get_batch_size());
+    // larger than the prefetch count, requested from the cluster
+    auto large_batch = flake_id_generator_->new_ids(25).get();
+    ASSERT_EQ(25, large_batch.get_batch_size());
+
+    std::unordered_set<int64_t> ids;
+    for (auto* batch : { &small_batch, &large_batch }) {
+        int count = 0;
+        for (auto it = batch->iterator(); it != batch->end(); ++it) {
+            ASSERT_EQ(batch->get_base() + count * batch->get_increment(), *it);
+            ids.insert(*it);
+            ++count;
+        }
+        ASSERT_EQ(batch->get_batch_size(), count);
+    }
+    for (int i = 0; i < 30; ++i) {
+        ids.insert(flake_id_generator_->new_id().get());
+    }
+
+    ASSERT_EQ(4U + 25U + 30U, ids.size());
+    ASSERT_THROW(flake_id_generator_->new_ids(0), exception::illegal_argument);
+}
+
 TEST_F(FlakeIdGeneratorApiTest, testAddGetFlakeIdGeneratorIntegrity)
 {
     client_config clientConfig = get_config();
@@ -2436,6 +2710,15 @@ TEST_F(FlakeIdGeneratorApiTest, testAddGetFlakeIdGeneratorIntegrity)
     EXPECT_EQ(readed_flake_config->get_prefetch_count(), 20);
     EXPECT_EQ(readed_flake_config->get_prefetch_validity_duration(),
               std::chrono::seconds(30));
+    EXPECT_EQ(config::client_flake_id_generator_config::
+                DEFAULT_PREFETCH_LOW_WATER_MARK_PERCENTAGE,
+              readed_flake_config->get_prefetch_low_water_mark_percentage());
+
+    EXPECT_EQ(0,
+              flakeIdConfig.set_prefetch_low_water_mark_percentage(0)
+                .get_prefetch_low_water_mark_percentage());
+    EXPECT_THROW(flakeIdConfig.set_prefetch_low_water_mark_percentage(101),
+                 exception::illegal_argument);
 }
 
 } // namespace test
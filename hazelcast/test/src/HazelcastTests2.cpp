@@ -17,15 +17,18 @@
 #include <cerrno>
 #include <cmath>
 #include <cstdlib>
+#include <cstdio>
 #include <ctime>
 #include <fstream>
 #include <iostream>
 #include <ostream>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <boost/asio.hpp>
 #include <boost/thread/barrier.hpp>
+#include <boost/uuid/uuid_generators.hpp>
 #include <gtest/gtest.h>
 
 #ifdef HZ_BUILD_WITH_SSL
@@ -42,10 +45,14 @@
 #include <hazelcast/client/imap.h>
 #include <hazelcast/client/impl/Partition.h>
 #include <hazelcast/client/initial_membership_event.h>
+#include <hazelcast/client/internal/eviction/impl/admission/FrequencySketch.h>
 #include <hazelcast/client/internal/nearcache/impl/NearCacheRecordStore.h>
+#include <hazelcast/client/internal/nearcache/impl/invalidation/RepairingHandler.h>
+#include <hazelcast/client/internal/nearcache/impl/preloader/NearCachePreloader.h>
 #include <hazelcast/client/internal/nearcache/impl/store/NearCacheDataRecordStore.h>
 #include <hazelcast/client/internal/nearcache/impl/store/NearCacheObjectRecordStore.h>
 #include <hazelcast/client/internal/socket/SSLSocket.h>
+#include <hazelcast/client/monitor/impl/NearCacheStatsImpl.h>
 #include <hazelcast/client/lifecycle_listener.h>
 #include <hazelcast/client/pipelining.h>
 #include <hazelcast/client/serialization_config.h>
@@ -54,6 +61,7 @@
 #include <hazelcast/util/AddressHelper.h>
 #include <hazelcast/util/concurrent/locks/LockSupport.h>
 #include <hazelcast/util/MurmurHash3.h>
+#include <hazelcast/util/SampleableConcurrentHashMap.h>
 #include <hazelcast/util/Util.h>
 #include <hazelcast/client/big_decimal.h>
 
@@ -267,6 +275,63 @@ TEST(ClientUtilTest, print_older_steady_clock_time)
     ASSERT_EQ(std::string::npos,
               time_str.substr(time_str.find_last_of('.')).find('-'));
 }
+
+TEST(ClientUtilTest, sampleableConcurrentHashMapStripesAndSamples)
+{
+    struct value
+    {
+        explicit value(int v)
+          : v(v)
+        {}
+        virtual ~value() = default;
+        int v;
+    };
+    hazelcast::util::SampleableConcurrentHashMap<int, value, int, value> map(
+      100, 16);
+
+    std::vector<std::shared_ptr<int>> keys;
+    for (int i = 0; i < 1000; ++i) {
+        keys.push_back(std::make_shared<int>(i));
+    }
+
+    std::vector<std::thread> writers;
+    for (int t = 0; t < 4; ++t) {
+        writers.emplace_back([&map, &keys, t]() {
+            for (size_t i = t; i < keys.size(); i += 4) {
+                ASSERT_FALSE(map.put(keys[i], std::make_shared<value>(i)));
+            }
+        });
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+    ASSERT_EQ(keys.size(), map.size());
+    ASSERT_EQ(keys.size(), map.entry_set().size());
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_EQ(i, map.get(keys[i])->v);
+    }
+
+    auto samples = map.get_random_samples(15);
+    ASSERT_TRUE(samples);
+    int sampleCount = 0;
+    auto* iterator = samples->iterator();
+    while (iterator->has_next()) {
+        auto sample = iterator->next();
+        ASSERT_EQ(*sample->get_entry_key(), sample->get_entry_value()->v);
+        ++sampleCount;
+    }
+    ASSERT_EQ(15, sampleCount);
+
+    auto removed = map.remove_all({ keys[1], std::make_shared<int>(1), keys[2] });
+    ASSERT_TRUE(removed[0]);
+    ASSERT_FALSE(removed[1]) << "distinct pointers are distinct keys";
+    ASSERT_TRUE(removed[2]);
+    ASSERT_EQ(keys.size() - 2, map.size());
+
+    ASSERT_EQ(keys.size() - 2, map.clear().size());
+    ASSERT_TRUE(map.empty());
+    ASSERT_FALSE(map.get_random_samples(15));
+}
 } // namespace test
 } // namespace client
 } // namespace hazelcast
@@ -424,6 +489,22 @@ TEST_F(ClientConfigTest, test_set_label)
     EXPECT_FALSE(is_found);
 }
 
+TEST_F(ClientConfigTest, test_connections_per_member)
+{
+    client_config config;
+    auto& network_config = config.get_network_config();
+    ASSERT_EQ(1, network_config.get_connections_per_member());
+
+    network_config.set_connections_per_member(4);
+    ASSERT_EQ(4, network_config.get_connections_per_member());
+
+    ASSERT_THROW(network_config.set_connections_per_member(0),
+                 exception::illegal_argument);
+    ASSERT_THROW(network_config.set_connections_per_member(-1),
+                 exception::illegal_argument);
+    ASSERT_EQ(4, network_config.get_connections_per_member());
+}
+
 TEST(connection_retry_config_test, large_jitter)
 {
     ASSERT_THROW(client_config()
@@ -2383,6 +2464,40 @@ protected:
         ASSERT_EQ(0, nearCacheRecordStore->size());
     }
 
+    void invalidate_all_records(config::in_memory_format in_memory_format)
+    {
+        auto nearCacheConfig =
+          create_near_cache_config(DEFAULT_NEAR_CACHE_NAME, in_memory_format);
+        auto nearCacheRecordStore =
+          create_near_cache_record_store(nearCacheConfig, in_memory_format);
+
+        for (int i = 0; i < DEFAULT_RECORD_COUNT; i++) {
+            nearCacheRecordStore->put(get_shared_key(i), get_shared_value(i));
+        }
+
+        // invalidate the even keys and some keys which are not stored
+        std::vector<std::shared_ptr<serialization::pimpl::data>> keys;
+        for (int i = 0; i < DEFAULT_RECORD_COUNT + 10; i += 2) {
+            keys.push_back(get_shared_key(i));
+        }
+        ASSERT_EQ(DEFAULT_RECORD_COUNT / 2,
+                  nearCacheRecordStore->invalidate_all(keys));
+
+        ASSERT_EQ(DEFAULT_RECORD_COUNT / 2, nearCacheRecordStore->size());
+        for (int i = 0; i < DEFAULT_RECORD_COUNT; i++) {
+            ASSERT_EQ(i % 2 != 0,
+                      nullptr != nearCacheRecordStore->get(get_shared_key(i)));
+        }
+
+        auto stats =
+          std::static_pointer_cast<monitor::impl::NearCacheStatsImpl>(
+            nearCacheRecordStore->get_near_cache_stats());
+        ASSERT_EQ(DEFAULT_RECORD_COUNT / 2, stats->get_invalidations());
+        ASSERT_EQ(static_cast<int64_t>(keys.size()),
+                  stats->get_invalidation_requests());
+        ASSERT_EQ(DEFAULT_RECORD_COUNT / 2, stats->get_owned_entry_count());
+    }
+
     void clear_records_or_destroy_store(
       config::in_memory_format in_memory_format,
       bool destroy)
@@ -2447,13 +2562,7 @@ protected:
         ASSERT_EQ(expectedHits, nearCacheStats->get_hits());
         ASSERT_EQ(expectedMisses, nearCacheStats->get_misses());
         ASSERT_EQ(expectedEntryCount, nearCacheStats->get_owned_entry_count());
-        switch (in_memory_format) {
-            case config::BINARY:
-                ASSERT_TRUE(memoryCostWhenFull > 0);
-                break;
-            case config::OBJECT:
-                ASSERT_EQ(0, memoryCostWhenFull);
-        }
+        ASSERT_TRUE(memoryCostWhenFull > 0);
 
         for (int i = 0; i < DEFAULT_RECORD_COUNT; i++) {
             int selectedKey = i * 3;
@@ -2463,25 +2572,13 @@ protected:
         }
 
         ASSERT_EQ(expectedEntryCount, nearCacheStats->get_owned_entry_count());
-        switch (in_memory_format) {
-            case config::BINARY:
-                ASSERT_TRUE(nearCacheStats->get_owned_entry_memory_cost() > 0);
-                ASSERT_TRUE(nearCacheStats->get_owned_entry_memory_cost() <
-                            memoryCostWhenFull);
-                break;
-            case config::OBJECT:
-                ASSERT_EQ(0, nearCacheStats->get_owned_entry_memory_cost());
-                break;
-        }
+        ASSERT_TRUE(nearCacheStats->get_owned_entry_memory_cost() > 0);
+        ASSERT_TRUE(nearCacheStats->get_owned_entry_memory_cost() <
+                    memoryCostWhenFull);
 
         nearCacheRecordStore->clear();
 
-        switch (in_memory_format) {
-            case config::BINARY:
-            case config::OBJECT:
-                ASSERT_EQ(0, nearCacheStats->get_owned_entry_memory_cost());
-                break;
-        }
+        ASSERT_EQ(0, nearCacheStats->get_owned_entry_memory_cost());
     }
 
     void ttl_evaluated(config::in_memory_format in_memory_format)
@@ -2615,6 +2712,167 @@ protected:
         }
     }
 
+    void do_eviction_with_used_heap_max_size_policy(
+      config::in_memory_format in_memory_format,
+      config::eviction_config::max_size_policy max_size_policy)
+    {
+        const int64_t oneMegabyte = 1024 * 1024;
+
+        config::eviction_config evictionConfig;
+        evictionConfig.set_maximum_size_policy(max_size_policy);
+        if (max_size_policy == config::eviction_config::USED_HEAP_PERCENTAGE) {
+            // 50% of a 2 MB budget
+            evictionConfig.set_heap_budget_megabytes(2).set_size(50);
+        } else {
+            evictionConfig.set_size(1);
+        }
+
+        config::near_cache_config nearCacheConfig(
+          config::near_cache_config::DEFAULT_TTL_SECONDS,
+          config::near_cache_config::DEFAULT_MAX_IDLE_SECONDS,
+          true,
+          in_memory_format,
+          evictionConfig);
+
+        nearCacheConfig.set_name(DEFAULT_NEAR_CACHE_NAME);
+        auto nearCacheRecordStore =
+          create_near_cache_record_store(nearCacheConfig, in_memory_format);
+        auto nearCacheStats = nearCacheRecordStore->get_near_cache_stats();
+
+        // 100 KB values of which about 10 fit into the max size
+        std::string value(100 * 1024, 'x');
+        auto valueData = ss_->to_shared_data<std::string>(&value);
+        for (int i = 0; i < DEFAULT_RECORD_COUNT; i++) {
+            nearCacheRecordStore->do_eviction_if_required();
+            nearCacheRecordStore->put(get_shared_key(i), valueData);
+            ASSERT_TRUE(nearCacheStats->get_owned_entry_memory_cost() <
+                        oneMegabyte + 2 * valueData->total_size());
+        }
+        nearCacheRecordStore->do_eviction_if_required();
+        ASSERT_TRUE(nearCacheStats->get_owned_entry_memory_cost() <
+                    oneMegabyte);
+        ASSERT_TRUE(nearCacheRecordStore->size() > 0);
+        ASSERT_TRUE(nearCacheRecordStore->size() < 11);
+        ASSERT_EQ(DEFAULT_RECORD_COUNT - nearCacheRecordStore->size(),
+                  nearCacheStats->get_evictions());
+
+        nearCacheRecordStore->clear();
+        ASSERT_EQ(0, nearCacheStats->get_owned_entry_memory_cost());
+    }
+
+    void do_admission_with_tiny_lfu(config::in_memory_format in_memory_format)
+    {
+        const int32_t maxSize = 100;
+        const int hotKeyCount = 10;
+
+        config::eviction_config evictionConfig;
+        evictionConfig.set_maximum_size_policy(
+          config::eviction_config::ENTRY_COUNT);
+        evictionConfig.set_size(maxSize);
+        evictionConfig.set_eviction_policy(config::LRU);
+        evictionConfig.set_admission_policy(config::eviction_config::TINY_LFU);
+
+        config::near_cache_config nearCacheConfig(
+          config::near_cache_config::DEFAULT_TTL_SECONDS,
+          config::near_cache_config::DEFAULT_MAX_IDLE_SECONDS,
+          true,
+          in_memory_format,
+          evictionConfig);
+
+        nearCacheConfig.set_name(DEFAULT_NEAR_CACHE_NAME);
+        auto nearCacheRecordStore =
+          create_near_cache_record_store(nearCacheConfig, in_memory_format);
+        auto nearCacheStats = nearCacheRecordStore->get_near_cache_stats();
+
+        // the hot keys are accessed more frequently than the other keys
+        for (int i = 0; i < maxSize; i++) {
+            nearCacheRecordStore->put(get_shared_key(i), get_shared_value(i));
+        }
+        for (int access = 0; access < 10; access++) {
+            for (int i = 0; i < hotKeyCount; i++) {
+                ASSERT_TRUE(nearCacheRecordStore->get(get_shared_key(i)));
+            }
+        }
+
+        // a scan of keys which are accessed only once
+        for (int i = maxSize; i < 10 * maxSize; i++) {
+            auto key = get_shared_key(i);
+            ASSERT_FALSE(nearCacheRecordStore->get(key));
+            nearCacheRecordStore->do_eviction_if_required();
+            nearCacheRecordStore->put(key, get_shared_value(i));
+            ASSERT_TRUE(maxSize >= nearCacheRecordStore->size());
+        }
+
+        for (int i = 0; i < hotKeyCount; i++) {
+            ASSERT_TRUE(nearCacheRecordStore->get(get_shared_key(i)))
+              << "The hot key " << i << " should not be evicted by the scan";
+        }
+        auto stats =
+          std::static_pointer_cast<monitor::impl::NearCacheStatsImpl>(
+            nearCacheStats);
+        ASSERT_GT(stats->get_admission_rejections(), 0);
+        ASSERT_EQ(nearCacheStats->get_owned_entry_count(),
+                  nearCacheRecordStore->size());
+    }
+
+    void stale_records_detected(config::in_memory_format in_memory_format)
+    {
+        using hazelcast::client::internal::nearcache::impl::invalidation::
+          RepairingHandler;
+
+        auto nearCacheConfig =
+          create_near_cache_config(DEFAULT_NEAR_CACHE_NAME, in_memory_format);
+        auto nearCacheRecordStore =
+          create_near_cache_record_store(nearCacheConfig, in_memory_format);
+        auto handler =
+          std::make_shared<RepairingHandler>(DEFAULT_NEAR_CACHE_NAME, 271, 0);
+        nearCacheRecordStore->set_stale_read_detector(handler);
+
+        auto partition_uuid = boost::uuids::random_generator()();
+        for (int32_t i = 0; i < handler->get_partition_count(); ++i) {
+            handler->init_uuid(i, partition_uuid);
+        }
+
+        // find two keys on different partitions
+        auto key = get_shared_key(0);
+        auto partition = handler->get_partition_id(*key);
+        int other_key_value = 1;
+        while (handler->get_partition_id(*get_shared_key(other_key_value)) ==
+               partition) {
+            ++other_key_value;
+        }
+        auto other_key = get_shared_key(other_key_value);
+
+        nearCacheRecordStore->put(key, get_shared_value(0));
+        nearCacheRecordStore->put(other_key, get_shared_value(other_key_value));
+        ASSERT_TRUE(nearCacheRecordStore->get(key));
+        ASSERT_TRUE(nearCacheRecordStore->get(other_key));
+
+        // sequences 1 and 2 are lost
+        handler->check_or_repair_sequence(partition, 3);
+        auto& meta_data = handler->get_meta_data_container(partition);
+        ASSERT_EQ(2, meta_data.get_missed_sequence_count());
+        // the record is still served until the gap is repaired
+        ASSERT_TRUE(nearCacheRecordStore->get(key));
+
+        handler->update_last_known_stale_sequence(meta_data);
+        ASSERT_EQ(3, meta_data.get_stale_sequence());
+        ASSERT_FALSE(nearCacheRecordStore->get(key));
+        ASSERT_TRUE(nearCacheRecordStore->get(other_key))
+          << "Only the partition with the gap should be invalidated";
+
+        // the records put after the repair are fresh
+        nearCacheRecordStore->put(key, get_shared_value(0));
+        ASSERT_TRUE(nearCacheRecordStore->get(key));
+
+        // a new partition uuid makes the records of the partition stale
+        handler->check_or_repair_uuid(partition,
+                                      boost::uuids::random_generator()());
+        ASSERT_EQ(0, meta_data.get_sequence());
+        ASSERT_FALSE(nearCacheRecordStore->get(key));
+        ASSERT_TRUE(nearCacheRecordStore->get(other_key));
+    }
+
     std::unique_ptr<hazelcast::client::internal::nearcache::impl::
                       NearCacheRecordStore<serialization::pimpl::data,
                                            serialization::pimpl::data>>
@@ -2697,6 +2955,11 @@ TEST_P(NearCacheRecordStoreTest, putAndRemoveRecord)
     put_and_remove_record(GetParam());
 }
 
+TEST_P(NearCacheRecordStoreTest, invalidateAllRecords)
+{
+    invalidate_all_records(GetParam());
+}
+
 TEST_P(NearCacheRecordStoreTest, clearRecords)
 {
     clear_records_or_destroy_store(GetParam(), false);
@@ -2734,12 +2997,51 @@ TEST_P(NearCacheRecordStoreTest,
     expired_records_cleaned_up_successfully(GetParam(), true);
 }
 
+TEST_P(NearCacheRecordStoreTest, staleRecordsDetected)
+{
+    stale_records_detected(GetParam());
+}
+
 TEST_P(NearCacheRecordStoreTest, canCreateWithEntryCountMaxSizePolicy)
 {
     create_near_cache_with_max_size_policy(
       GetParam(), config::eviction_config::ENTRY_COUNT, 1000);
 }
 
+TEST_P(NearCacheRecordStoreTest, canCreateWithUsedHeapSizeMaxSizePolicy)
+{
+    create_near_cache_with_max_size_policy(
+      GetParam(), config::eviction_config::USED_HEAP_SIZE, 16);
+}
+
+TEST_P(NearCacheRecordStoreTest,
+       cannotCreateWithUsedHeapPercentageMaxSizePolicyWithoutBudget)
+{
+    ASSERT_THROW(
+      create_near_cache_with_max_size_policy(
+        GetParam(), config::eviction_config::USED_HEAP_PERCENTAGE, 50),
+      exception::illegal_argument);
+}
+
+TEST_P(NearCacheRecordStoreTest,
+       evictionTriggeredAndHandledSuccessfullyWithUsedHeapSizeMaxSizePolicy)
+{
+    do_eviction_with_used_heap_max_size_policy(
+      GetParam(), config::eviction_config::USED_HEAP_SIZE);
+}
+
+TEST_P(NearCacheRecordStoreTest,
+       evictionTriggeredAndHandledSuccessfullyWithUsedHeapPercentageMaxSizePolicy)
+{
+    do_eviction_with_used_heap_max_size_policy(
+      GetParam(), config::eviction_config::USED_HEAP_PERCENTAGE);
+}
+
+TEST_P(NearCacheRecordStoreTest, tinyLfuAdmissionKeepsHotKeysOnScan)
+{
+    do_admission_with_tiny_lfu(GetParam());
+}
+
 TEST_P(
   NearCacheRecordStoreTest,
   evictionTriggeredAndHandledSuccessfullyWithEntryCountMaxSizePolicyAndLRUEvictionPolicy)
@@ -2765,6 +3067,149 @@ INSTANTIATE_TEST_SUITE_P(BasicStoreTest,
                          NearCacheRecordStoreTest,
                          ::testing::Values(config::BINARY, config::OBJECT));
 
+class NearCacheInvalidationBatchTest : public ClientTest
+{
+protected:
+    static constexpr int KEY_COUNT = 1000;
+
+    /**
+     * Writes the keys [0, KEY_COUNT) with a single putAll on the member.
+     */
+    static bool put_all_on_member(HazelcastServer& server,
+                                  const std::string& map_name,
+                                  int value_offset)
+    {
+        auto script =
+          (boost::format(
+             "var map = instance_0.getMap(\"%1%\");\n"
+             "var entries = new java.util.HashMap();\n"
+             "for (var i = 0; i < %2%; i++) {\n"
+             "    entries.put(java.lang.Integer.valueOf(i),\n"
+             "                java.lang.Integer.valueOf(i + %3%));\n"
+             "}\n"
+             "map.putAll(entries);\n") %
+           map_name % KEY_COUNT % value_offset)
+            .str();
+
+        Response response;
+        remote_controller_client().executeOnController(
+          response, server.cluster_id(), script, Lang::JAVASCRIPT);
+        return response.success;
+    }
+};
+
+constexpr int NearCacheInvalidationBatchTest::KEY_COUNT;
+
+TEST_F(NearCacheInvalidationBatchTest, member_bulk_write_is_invalidated)
+{
+    HazelcastServer server(default_server_factory());
+    auto map_name = get_test_name();
+    ASSERT_TRUE(put_all_on_member(server, map_name, 0));
+
+    auto config = get_config();
+    config.add_near_cache_config(
+      config::near_cache_config(map_name).set_invalidate_on_change(true));
+    hazelcast_client client(new_client(std::move(config)).get());
+    auto map = client.get_map(map_name).get();
+    for (int i = 0; i < KEY_COUNT; ++i) {
+        auto value = map->get<int, int>(i).get();
+        ASSERT_TRUE(value);
+        ASSERT_EQ(i, *value);
+    }
+    auto stats = std::static_pointer_cast<monitor::impl::NearCacheStatsImpl>(
+      map->get_local_map_stats().get_near_cache_stats());
+    ASSERT_EQ(KEY_COUNT, stats->get_owned_entry_count());
+    auto batches = stats->get_invalidation_batches();
+    auto batch_keys = stats->get_invalidation_batch_keys();
+
+    ASSERT_TRUE(put_all_on_member(server, map_name, KEY_COUNT));
+
+    // the batch is recorded after its keys are removed
+    ASSERT_EQ_EVENTUALLY(0, stats->get_owned_entry_count());
+    ASSERT_TRUE_EVENTUALLY(stats->get_invalidation_batch_keys() >=
+                           batch_keys + KEY_COUNT);
+    ASSERT_GT(stats->get_invalidation_batches(), batches);
+    ASSERT_GT(stats->get_max_invalidation_batch_size(), 1);
+    for (int i = 0; i < KEY_COUNT; ++i) {
+        auto value = map->get<int, int>(i).get();
+        ASSERT_TRUE(value);
+        ASSERT_EQ(KEY_COUNT + i, *value);
+    }
+
+    client.shutdown().get();
+}
+
+TEST(FrequencySketchTest, estimatesAndAgesFrequencies)
+{
+    using hazelcast::client::internal::eviction::impl::admission::
+      FrequencySketch;
+
+    FrequencySketch sketch(1000);
+    ASSERT_EQ(1024U, sketch.get_width());
+    ASSERT_EQ(16U, FrequencySketch(1).get_width());
+
+    ASSERT_EQ(0, sketch.frequency(42));
+    for (int i = 0; i < 5; ++i) {
+        sketch.increment(42);
+    }
+    ASSERT_GE(sketch.frequency(42), 5);
+    ASSERT_LT(sketch.frequency(4242), sketch.frequency(42));
+
+    // saturates at the max frequency
+    for (int i = 0; i < 100; ++i) {
+        sketch.increment(7);
+    }
+    ASSERT_EQ(FrequencySketch::MAX_FREQUENCY, sketch.frequency(7));
+
+    // the counters are halved after ten times the width additions
+    for (int32_t i = 0; i < 10 * 1024; ++i) {
+        sketch.increment(1000000 + i);
+    }
+    ASSERT_LT(sketch.frequency(7), FrequencySketch::MAX_FREQUENCY);
+    ASSERT_GE(sketch.frequency(7), FrequencySketch::MAX_FREQUENCY / 4);
+}
+
+TEST(NearCachePreloaderTest, storesAndLoadsKeys)
+{
+    logger lg("test", "test", logger::level::off, logger::default_handler);
+    auto stats = std::make_shared<monitor::impl::NearCacheStatsImpl>();
+    impl::preloader::NearCachePreloader preloader(
+      "preloader/test:map", config::near_cache_preloader_config(""), stats, lg);
+    ASSERT_EQ("nearCache-preloader_test_map.store", preloader.get_store_file());
+
+    std::vector<std::shared_ptr<serialization::pimpl::data>> keys;
+    int64_t expected_bytes = 2 * sizeof(int32_t);
+    for (int i = 0; i < 3; ++i) {
+        std::vector<byte> bytes(serialization::pimpl::data::DATA_OVERHEAD + i,
+                                static_cast<byte>(i + 1));
+        keys.push_back(std::make_shared<serialization::pimpl::data>(bytes));
+        expected_bytes += sizeof(int32_t) + bytes.size();
+    }
+    keys.push_back(nullptr);
+
+    preloader.store_keys(keys);
+    ASSERT_EQ(1, stats->get_persistence_count());
+    ASSERT_EQ(3, stats->get_last_persistence_key_count());
+    ASSERT_EQ(expected_bytes, stats->get_last_persistence_written_bytes());
+    ASSERT_EQ("", stats->get_last_persistence_failure());
+
+    auto loaded = preloader.load_keys();
+    ASSERT_EQ(3U, loaded.size());
+    for (size_t i = 0; i < loaded.size(); ++i) {
+        ASSERT_EQ(*keys[i], loaded[i]);
+    }
+
+    {
+        std::ofstream out(preloader.get_store_file(),
+                          std::ios::binary | std::ios::trunc);
+        out << "not a key file";
+    }
+    ASSERT_TRUE(preloader.load_keys().empty());
+
+    std::remove(preloader.get_store_file().c_str());
+    ASSERT_TRUE(preloader.load_keys().empty());
+}
+
 } // namespace nearcache
 } // namespace internal
 } // namespace test
@@ -782,6 +782,15 @@ public:
         return config;
     }
 
+    static client_config create_chunked_deserialization_map_client_config()
+    {
+        client_config config = create_map_client_config();
+        // small chunks so that the bulk results of the tests are deserialized
+        // in parallel
+        config.set_property(client_properties::DESERIALIZATION_CHUNK_SIZE, "7");
+        return config;
+    }
+
     ClientMapTest()
       : client_(new_client(GetParam()()).get())
       , imap_(client_.get_map(imapName).get())
@@ -946,7 +955,8 @@ INSTANTIATE_TEST_SUITE_P(
   ::testing::Values(
     ClientMapTest::create_map_client_config,
     ClientMapTest::create_near_cached_map_client_config,
-    ClientMapTest::create_near_cached_object_map_client_config));
+    ClientMapTest::create_near_cached_object_map_client_config,
+    ClientMapTest::create_chunked_deserialization_map_client_config));
 
 TEST_P(ClientMapTest, testIssue537)
 {
@@ -1441,6 +1451,81 @@ TEST_P(ClientMapTest, testValues)
     ASSERT_EQ("value1", tempVector[0]);
 }
 
+TEST_P(ClientMapTest, testLazyResults)
+{
+    const int numItems = 20;
+    for (int i = 0; i < numItems; ++i) {
+        int_map_->put(i, 2 * i).get();
+    }
+
+    auto entries = int_map_->entry_set_lazy<int, int>().get();
+    ASSERT_EQ(static_cast<size_t>(numItems), entries.size());
+    for (size_t i = 0; i < entries.size(); ++i) {
+        ASSERT_FALSE(entries.is_key_deserialized(i));
+        ASSERT_FALSE(entries.is_value_deserialized(i));
+    }
+    // only the accessed key is deserialized, and only once
+    const int& key = entries.key(3);
+    ASSERT_TRUE(entries.is_key_deserialized(3));
+    ASSERT_FALSE(entries.is_value_deserialized(3));
+    ASSERT_EQ(&key, &entries.key(3));
+    ASSERT_EQ(2 * key, entries.value(3));
+    for (const auto& entry : entries) {
+        ASSERT_EQ(2 * entry.first, entry.second);
+    }
+
+    auto values = int_map_
+                    ->values_lazy<int>(query::equal_predicate(
+                      client_, query::query_constants::KEY_ATTRIBUTE_NAME, 5))
+                    .get();
+    ASSERT_EQ(1U, values.size());
+    ASSERT_FALSE(values.is_deserialized(0));
+    ASSERT_EQ(10, values[0]);
+    ASSERT_TRUE(values.is_deserialized(0));
+    ASSERT_THROW(values.at(1), std::out_of_range);
+
+    auto keys = int_map_->key_set_lazy<int>().get().to_vector();
+    std::sort(keys.begin(), keys.end());
+    ASSERT_EQ(static_cast<size_t>(numItems), keys.size());
+    for (int i = 0; i < numItems; ++i) {
+        ASSERT_EQ(i, keys[i]);
+    }
+}
+
+TEST_P(ClientMapTest, testIterateEntries)
+{
+    const int numItems = 100;
+    for (int i = 0; i < numItems; ++i) {
+        int_map_->put(i, 2 * i).get();
+    }
+
+    std::unordered_map<int, int> entries;
+    auto entry_it = int_map_->iterate_entries<int, int>(7);
+    while (entry_it.has_next()) {
+        auto batch = entry_it.next().get();
+        ASSERT_LE(batch.size(), 7U);
+        for (const auto& entry : batch) {
+            ASSERT_TRUE(entries.emplace(entry.first, entry.second).second);
+        }
+    }
+    ASSERT_EQ(static_cast<size_t>(numItems), entries.size());
+    for (int i = 0; i < numItems; ++i) {
+        ASSERT_EQ(2 * i, entries[i]);
+    }
+    ASSERT_TRUE(entry_it.next().get().empty());
+
+    std::unordered_set<int> keys;
+    auto key_it = int_map_->iterate_keys<int>(1000);
+    while (key_it.has_next()) {
+        for (auto key : key_it.next().get()) {
+            ASSERT_TRUE(keys.insert(key).second);
+        }
+    }
+    ASSERT_EQ(static_cast<size_t>(numItems), keys.size());
+
+    ASSERT_THROW(int_map_->iterate_keys<int>(0), exception::illegal_argument);
+}
+
 TEST_P(ClientMapTest, testValuesWithPredicate)
 {
     const int numItems = 20;
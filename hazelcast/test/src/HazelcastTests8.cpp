@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include <cmath>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <memory>
@@ -37,6 +38,7 @@
 #include <hazelcast/client/client_properties.h>
 #include <hazelcast/client/connection/ClientConnectionManagerImpl.h>
 #include <hazelcast/client/connection/Connection.h>
+#include <hazelcast/client/connection/ReadHandler.h>
 #include <hazelcast/client/connection/AddressProvider.h>
 #include <hazelcast/client/spi/impl/discovery/remote_address_provider.h>
 #include <hazelcast/client/entry_event.h>
@@ -2350,6 +2352,57 @@ TEST(ClientMessageTest, test_encode_sql_query_id)
     EXPECT_EQ(expected_bytes, actual_bytes);
 }
 
+TEST(ClientMessageTest, test_encode_moved_data_matches_copied_data)
+{
+    serialization::pimpl::data key(std::vector<byte>(16, 1));
+    for (size_t value_size :
+         { size_t(16), protocol::ClientMessage::EXPECTED_DATA_BLOCK_SIZE * 4 }) {
+        std::vector<byte> value_bytes(value_size, 7);
+        serialization::pimpl::data value(value_bytes);
+
+        auto copied =
+          protocol::codec::map_put_encode("map_name", key, value, 1, 2);
+        auto moved = protocol::codec::map_put_encode(
+          "map_name", key, serialization::pimpl::data(value_bytes), 1, 2);
+
+        std::vector<unsigned char> copied_bytes;
+        for (const auto& piece : copied.get_buffer()) {
+            copied_bytes.insert(copied_bytes.end(), piece.begin(), piece.end());
+        }
+        std::vector<unsigned char> moved_bytes;
+        for (const auto& piece : moved.get_buffer()) {
+            moved_bytes.insert(moved_bytes.end(), piece.begin(), piece.end());
+        }
+
+        EXPECT_EQ(copied_bytes, moved_bytes);
+        EXPECT_TRUE(moved.contains_serialized_data_in_request());
+    }
+}
+
+TEST(ClientMessageTest, test_frame_blocks_are_recycled)
+{
+    auto& pool = protocol::frame_buffer_pool::instance();
+    {
+        // make sure that at least one block is pooled
+        protocol::ClientMessage msg(protocol::ClientMessage::REQUEST_HEADER_LEN);
+    }
+
+    auto hits_before = pool.hits();
+    {
+        protocol::ClientMessage msg(protocol::ClientMessage::REQUEST_HEADER_LEN);
+        ASSERT_GE(msg.get_buffer()[0].capacity(),
+                  protocol::ClientMessage::EXPECTED_DATA_BLOCK_SIZE);
+    }
+    ASSERT_GT(pool.hits(), hits_before);
+    ASSERT_GT(pool.pooled_count(), 0);
+
+    auto misses_before = pool.misses();
+    auto large_block = pool.acquire(
+      protocol::ClientMessage::EXPECTED_DATA_BLOCK_SIZE * 1024);
+    ASSERT_GT(pool.misses(), misses_before);
+    ASSERT_TRUE(large_block.empty());
+}
+
 TEST(ClientMessageTest, test_decode_sql_column_metadata)
 {
     const unsigned char bytes[] = {
@@ -2411,6 +2464,14 @@ TEST(ClientMessageTest, test_decode_sql_page)
               row2.get_object<std::string>(0));
     ASSERT_EQ(boost::make_optional<std::string>(""),
               row2.get_object<std::string>(1));
+
+    auto foo_values = page->column_values<boost::string_view>(0);
+    ASSERT_EQ(2U, foo_values.size());
+    ASSERT_FALSE(foo_values.is_null(0));
+    ASSERT_EQ("foo", foo_values[0]);
+    ASSERT_EQ("bar", foo_values[1]);
+    ASSERT_EQ("", page->column_values<boost::string_view>(1)[1]);
+    ASSERT_THROW(row1.get_object<int32_t>(0), boost::bad_any_cast);
 }
 
 TEST(ClientMessageTest, test_decode_sql_error)
@@ -2436,6 +2497,233 @@ TEST(ClientMessageTest, test_decode_sql_error)
     EXPECT_EQ(boost::optional<std::string>{ "bar" }, err.suggestion);
 }
 
+namespace {
+struct recording_message_handler
+{
+    std::vector<std::shared_ptr<protocol::ClientMessage>> messages;
+    std::string close_reason;
+
+    void handle_client_message(
+      const std::shared_ptr<protocol::ClientMessage>& message)
+    {
+        messages.push_back(message);
+    }
+
+    void close(const std::string& reason) { close_reason = reason; }
+};
+} // namespace
+
+class ReadHandlerTest : public ::testing::Test
+{
+protected:
+    using read_handler = connection::ReadHandler<recording_message_handler>;
+
+    static std::vector<char> message_bytes(int64_t correlation_id,
+                                           size_t name_length)
+    {
+        auto message =
+          protocol::codec::map_size_encode(std::string(name_length, 'm'));
+        message.set_correlation_id(correlation_id);
+        return bytes_of(message);
+    }
+
+    static std::vector<char> bytes_of(const protocol::ClientMessage& message)
+    {
+        std::vector<char> bytes;
+        for (const auto& block : message.get_buffer()) {
+            bytes.insert(bytes.end(), block.begin(), block.end());
+        }
+        return bytes;
+    }
+
+    /**
+     * Passes the bytes [from, to) to the handler as a single read.
+     */
+    static void read(read_handler& handler,
+                     const std::vector<char>& bytes,
+                     size_t from,
+                     size_t to)
+    {
+        ASSERT_LE(to - from, handler.read_space());
+        std::memcpy(handler.read_position(), &bytes[from], to - from);
+        handler.handle(to - from);
+    }
+
+    /**
+     * Passes all the bytes to the handler in reads which fill the buffer.
+     */
+    static void read_all(read_handler& handler, const std::vector<char>& bytes)
+    {
+        size_t position = 0;
+        while (position < bytes.size()) {
+            auto length =
+              (std::min)(handler.read_space(), bytes.size() - position);
+            read(handler, bytes, position, position + length);
+            position += length;
+        }
+    }
+
+    recording_message_handler message_handler_;
+};
+
+TEST_F(ReadHandlerTest, test_frame_header_split_across_reads)
+{
+    read_handler handler(message_handler_, 1024);
+    auto bytes = message_bytes(1, 8);
+
+    read(handler, bytes, 0, 3);
+    ASSERT_TRUE(message_handler_.messages.empty());
+    read(handler, bytes, 3, bytes.size());
+
+    ASSERT_EQ(1U, message_handler_.messages.size());
+    ASSERT_EQ(bytes, bytes_of(*message_handler_.messages[0]));
+    ASSERT_EQ(1, message_handler_.messages[0]->get_correlation_id());
+}
+
+TEST_F(ReadHandlerTest, test_message_spanning_several_reads)
+{
+    read_handler handler(message_handler_, 16 << 10);
+    auto bytes = message_bytes(1, 1000);
+
+    size_t position = 0;
+    for (; position + 100 < bytes.size(); position += 100) {
+        read(handler, bytes, position, position + 100);
+        ASSERT_TRUE(message_handler_.messages.empty());
+    }
+    read(handler, bytes, position, bytes.size());
+
+    ASSERT_EQ(1U, message_handler_.messages.size());
+    ASSERT_EQ(bytes, bytes_of(*message_handler_.messages[0]));
+}
+
+TEST_F(ReadHandlerTest, test_several_messages_in_one_read)
+{
+    read_handler handler(message_handler_, 16 << 10);
+    std::vector<std::vector<char>> messages;
+    std::vector<char> bytes;
+    for (int64_t id = 1; id <= 4; ++id) {
+        messages.push_back(message_bytes(id, 10 * id));
+        auto& message = messages.back();
+        bytes.insert(bytes.end(), message.begin(), message.end());
+    }
+
+    // the last message is completed by the next read
+    auto first_read = bytes.size() - messages[3].size() / 2;
+    read(handler, bytes, 0, first_read);
+    ASSERT_EQ(3U, message_handler_.messages.size());
+    read(handler, bytes, first_read, bytes.size());
+
+    ASSERT_EQ(4U, message_handler_.messages.size());
+    for (size_t i = 0; i < messages.size(); ++i) {
+        ASSERT_EQ(static_cast<int64_t>(i + 1),
+                  message_handler_.messages[i]->get_correlation_id());
+        ASSERT_EQ(messages[i], bytes_of(*message_handler_.messages[i]));
+    }
+}
+
+TEST_F(ReadHandlerTest, test_message_larger_than_max_buffer_size)
+{
+    read_handler handler(message_handler_, 16 << 10);
+    auto large_message =
+      message_bytes(1, read_handler::MAX_BUFFER_SIZE + 1000);
+    auto bytes = large_message;
+    auto small_message = message_bytes(2, 8);
+    bytes.insert(bytes.end(), small_message.begin(), small_message.end());
+
+    read_all(handler, bytes);
+
+    // the large message is streamed instead of being kept in the buffer
+    ASSERT_LE(handler.capacity(), read_handler::MAX_BUFFER_SIZE);
+    ASSERT_EQ(2U, message_handler_.messages.size());
+    ASSERT_EQ(large_message, bytes_of(*message_handler_.messages[0]));
+    ASSERT_EQ(small_message, bytes_of(*message_handler_.messages[1]));
+    ASSERT_TRUE(message_handler_.close_reason.empty());
+}
+
+TEST_F(ReadHandlerTest, test_malformed_frame_length)
+{
+    for (int32_t frame_length : { -1, 0, 5 }) {
+        recording_message_handler message_handler;
+        read_handler handler(message_handler, 1024);
+        auto bytes = message_bytes(1, 8);
+        // corrupt the length of the second frame
+        auto second_frame =
+          reinterpret_cast<protocol::ClientMessage::frame_header_type*>(
+            &bytes[0])
+            ->frame_len;
+        std::memcpy(&bytes[second_frame], &frame_length, sizeof(int32_t));
+
+        read(handler, bytes, 0, bytes.size());
+
+        ASSERT_TRUE(message_handler.messages.empty()) << frame_length;
+        ASSERT_EQ("Received a malformed frame", message_handler.close_reason)
+          << frame_length;
+    }
+}
+
+TEST_F(ReadHandlerTest, test_capacity_grows_for_a_pending_message)
+{
+    read_handler handler(message_handler_, 1024);
+    auto bytes = message_bytes(1, 3000);
+
+    read(handler, bytes, 0, handler.read_space());
+    ASSERT_EQ(4096U, handler.capacity());
+    read(handler, bytes, 1024, bytes.size());
+
+    ASSERT_EQ(1U, message_handler_.messages.size());
+    ASSERT_EQ(bytes, bytes_of(*message_handler_.messages[0]));
+}
+
+TEST_F(ReadHandlerTest, test_capacity_grows_when_a_read_fills_the_buffer)
+{
+    read_handler handler(message_handler_, 1024);
+    auto bytes = message_bytes(1, 600);
+    auto second_message = message_bytes(2, 600);
+    bytes.insert(bytes.end(), second_message.begin(), second_message.end());
+
+    read(handler, bytes, 0, handler.read_space());
+    ASSERT_EQ(1U, message_handler_.messages.size());
+    ASSERT_EQ(2048U, handler.capacity());
+    read(handler, bytes, 1024, bytes.size());
+
+    ASSERT_EQ(2U, message_handler_.messages.size());
+    ASSERT_EQ(second_message, bytes_of(*message_handler_.messages[1]));
+}
+
+TEST_F(ReadHandlerTest, test_capacity_shrinks_after_small_reads)
+{
+    read_handler handler(message_handler_, 1024);
+    read_all(handler, message_bytes(1, 3000));
+    ASSERT_EQ(4096U, handler.capacity());
+
+    auto bytes = message_bytes(2, 8);
+    for (int i = 0; i < 63; ++i) {
+        read(handler, bytes, 0, bytes.size());
+    }
+    ASSERT_EQ(4096U, handler.capacity());
+    read(handler, bytes, 0, bytes.size());
+    ASSERT_EQ(2048U, handler.capacity());
+
+    // a larger read resets the count of the small reads
+    for (int i = 0; i < 32; ++i) {
+        read(handler, bytes, 0, bytes.size());
+    }
+    read_all(handler, message_bytes(3, 1000));
+    for (int i = 0; i < 63; ++i) {
+        read(handler, bytes, 0, bytes.size());
+    }
+    ASSERT_EQ(2048U, handler.capacity());
+    read(handler, bytes, 0, bytes.size());
+    ASSERT_EQ(1024U, handler.capacity());
+
+    // the buffer does not shrink below its initial capacity
+    for (int i = 0; i < 64; ++i) {
+        read(handler, bytes, 0, bytes.size());
+    }
+    ASSERT_EQ(1024U, handler.capacity());
+    ASSERT_EQ(1 + 64 + 32 + 1 + 64 + 64U, message_handler_.messages.size());
+}
+
 } // namespace test
 } // namespace client
 } // namespace hazelcast
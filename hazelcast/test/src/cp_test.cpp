@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+#include <sstream>
 #include <string>
 #include <memory>
 
@@ -256,6 +258,137 @@ TEST_F(basic_atomic_long_test, test_multiple_destroy)
     ASSERT_NO_THROW(cp_structure_->destroy().get());
 }
 
+TEST_F(basic_atomic_long_test, test_invocations_when_the_leader_is_unreachable)
+{
+    auto group_id = cp_structure_->get_group_id();
+    auto& leader_cache =
+      spi::ClientContext(*client_).get_raft_group_leader_cache();
+    for (int64_t i = 0; i < 10; ++i) {
+        ASSERT_EQ(i + 1, cp_structure_->increment_and_get().get());
+    }
+    auto leader = leader_cache.get_leader(group_id);
+    ASSERT_FALSE(leader.is_nil());
+
+    // the other members forward the invocations until the leader is probed
+    leader_cache.on_failure(group_id, leader);
+    ASSERT_NE(leader, leader_cache.get_leader(group_id));
+    int64_t invocations =
+      2 * hazelcast::cp::internal::raft_group_leader_cache::PROBE_INTERVAL;
+    for (int64_t i = 10; i < 10 + invocations; ++i) {
+        ASSERT_EQ(i + 1, cp_structure_->increment_and_get().get());
+    }
+}
+
+TEST_F(basic_atomic_long_test, test_raft_errors_keep_the_target_reachable)
+{
+    // the object is destroyed by another client, so that the first
+    // invocation of its group from this client fails on the member
+    auto name = get_test_name() + "@" + get_test_name();
+    auto other_client = hazelcast::new_client(get_client_config()).get();
+    auto other_proxy =
+      other_client.get_cp_subsystem().get_atomic_long(name).get();
+    other_proxy->destroy().get();
+    other_client.shutdown().get();
+
+    auto destroyed = client_->get_cp_subsystem().get_atomic_long(name).get();
+    auto& leader_cache =
+      spi::ClientContext(*client_).get_raft_group_leader_cache();
+    ASSERT_THROW(destroyed->increment_and_get().get(),
+                 exception::distributed_object_destroyed);
+
+    // the member which answered with the error stays a leader candidate
+    ASSERT_FALSE(leader_cache.get_leader(destroyed->get_group_id()).is_nil());
+}
+
+TEST_F(basic_atomic_long_test, test_leader_cache_follows_membership_changes)
+{
+    auto group_id = cp_structure_->get_group_id();
+    auto& leader_cache =
+      spi::ClientContext(*client_).get_raft_group_leader_cache();
+    for (int64_t i = 0; i < 10; ++i) {
+        ASSERT_EQ(i + 1, cp_structure_->increment_and_get().get());
+    }
+    auto members = client_->get_cluster().get_members();
+
+    // the joining member is probed by the next invocation
+    HazelcastServer joining_member(*factory);
+    ASSERT_EQ_EVENTUALLY(members.size() + 1,
+                         client_->get_cluster().get_members().size());
+    boost::uuids::uuid joined{};
+    for (const auto& m : client_->get_cluster().get_members()) {
+        if (std::find(members.begin(), members.end(), m) == members.end()) {
+            joined = m.get_uuid();
+        }
+    }
+    ASSERT_EQ_EVENTUALLY(joined, leader_cache.get_target(group_id));
+    leader_cache.on_response(
+      group_id, joined, joined, std::chrono::nanoseconds(1));
+    ASSERT_EQ(joined, leader_cache.get_leader(group_id));
+
+    // and it is dropped when it leaves
+    ASSERT_TRUE(joining_member.shutdown());
+    ASSERT_EQ_EVENTUALLY(members.size(),
+                         client_->get_cluster().get_members().size());
+    ASSERT_TRUE_EVENTUALLY(leader_cache.get_leader(group_id) != joined);
+    for (int64_t i = 0;
+         i < 2 * hazelcast::cp::internal::raft_group_leader_cache::
+                   PROBE_INTERVAL;
+         ++i) {
+        ASSERT_NE(joined, leader_cache.get_target(group_id));
+    }
+    ASSERT_EQ(11, cp_structure_->increment_and_get().get());
+}
+
+TEST_F(basic_atomic_long_test, test_leader_cache_routing)
+{
+    spi::ClientContext context(*client_);
+    hazelcast::cp::internal::raft_group_leader_cache leader_cache(context);
+    hazelcast::cp::raft_group_id group_id{ get_test_name(), 0, 1 };
+    auto respond = [&](boost::uuids::uuid target, int64_t millis) {
+        leader_cache.on_response(
+          group_id, target, target, std::chrono::milliseconds(millis));
+    };
+
+    // each member is probed once before the leader is chosen
+    std::vector<boost::uuids::uuid> probed;
+    for (int64_t millis : { 3, 1, 2 }) {
+        auto target = leader_cache.get_target(group_id);
+        ASSERT_EQ(probed.end(),
+                  std::find(probed.begin(), probed.end(), target));
+        probed.push_back(target);
+        respond(target, millis);
+    }
+    auto members = client_->get_cluster().get_members();
+    ASSERT_EQ(members.size(), probed.size());
+    for (const auto& m : members) {
+        ASSERT_NE(probed.end(),
+                  std::find(probed.begin(), probed.end(), m.get_uuid()));
+    }
+
+    // the fastest member gets the invocations except the periodic probes
+    ASSERT_EQ(probed[1], leader_cache.get_leader(group_id));
+    for (int64_t i = 1; i < hazelcast::cp::internal::raft_group_leader_cache::
+                              PROBE_INTERVAL;
+         ++i) {
+        ASSERT_EQ(probed[1], leader_cache.get_target(group_id));
+    }
+    auto probe = leader_cache.get_target(group_id);
+    ASSERT_NE(probed[1], probe);
+    respond(probe, 10);
+    ASSERT_EQ(probed[1], leader_cache.get_target(group_id));
+
+    // the leader is left when another member answers its invocations
+    leader_cache.on_response(
+      group_id, probed[1], probed[0], std::chrono::milliseconds(1));
+    ASSERT_EQ(probed[2], leader_cache.get_leader(group_id));
+    ASSERT_EQ(probed[2], leader_cache.get_target(group_id));
+
+    // and when its invocations fail
+    leader_cache.on_failure(group_id, probed[2]);
+    ASSERT_EQ(probed[0], leader_cache.get_leader(group_id));
+    ASSERT_EQ(probed[0], leader_cache.get_target(group_id));
+}
+
 class basic_atomic_ref_test : public cp_test<hazelcast::cp::atomic_reference>
 {
 protected:
@@ -884,6 +1017,56 @@ TEST_F(basic_lock_test, test_failed_try_lock_does_not_acquire_session)
               session_manager.get_session_acquire_count(group_id, session_id));
 }
 
+TEST_F(basic_lock_test, test_concurrent_session_acquisitions_share_session)
+{
+    auto group_id = cp_structure_->get_group_id();
+    auto& session_manager =
+      spi::ClientContext(*client_).get_proxy_session_manager();
+    ASSERT_EQ(
+      ::hazelcast::cp::internal::session::proxy_session_manager::NO_SESSION_ID,
+      session_manager.get_session(group_id));
+
+    constexpr int acquisition_count = 10;
+    std::vector<boost::future<int64_t>> acquisitions;
+    for (int i = 0; i < acquisition_count; ++i) {
+        acquisitions.emplace_back(
+          session_manager.acquire_session_async(group_id, 1));
+    }
+
+    auto session_id = acquisitions[0].get();
+    for (int i = 1; i < acquisition_count; ++i) {
+        ASSERT_EQ(session_id, acquisitions[i].get());
+    }
+    ASSERT_EQ(session_id, session_manager.get_session(group_id));
+    ASSERT_EQ(acquisition_count,
+              session_manager.get_session_acquire_count(group_id, session_id));
+
+    session_manager.release_session(group_id, session_id, acquisition_count);
+}
+
+TEST_F(basic_lock_test, test_failed_session_creation_fails_acquisitions)
+{
+    auto group_id = cp_structure_->get_group_id();
+    cp_structure_.reset();
+    spi::ClientContext context(*client_);
+    client_->shutdown().get();
+
+    // the session requests of this manager fail since the client is shut down
+    ::hazelcast::cp::internal::session::proxy_session_manager session_manager(
+      context);
+    auto first = session_manager.acquire_session_async(group_id, 1);
+    auto second = session_manager.acquire_session_async(group_id, 1);
+
+    ASSERT_THROW(first.get(), exception::hazelcast_client_not_active);
+    ASSERT_THROW(second.get(), exception::hazelcast_client_not_active);
+    ASSERT_EQ(
+      ::hazelcast::cp::internal::session::proxy_session_manager::NO_SESSION_ID,
+      session_manager.get_session(group_id));
+    // the failed creation is not reused by the next acquisition
+    ASSERT_THROW(session_manager.acquire_session_async(group_id, 1).get(),
+                 exception::hazelcast_client_not_active);
+}
+
 TEST_F(basic_lock_test, test_destroy)
 {
     cp_structure_->try_lock().get();
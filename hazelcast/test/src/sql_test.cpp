@@ -903,6 +903,33 @@ TEST_F(SqlTest, sql_page_column_types)
     ASSERT_EQ(types.at(1), hazelcast::client::sql::sql_column_type::varchar);
 }
 
+TEST_F(SqlTest, sql_page_column_values)
+{
+    create_mapping("VARCHAR");
+    auto expecteds = populate_map<std::string>(map);
+
+    auto page = select_all()->iterator().next().get();
+
+    auto keys = page->column_values<int32_t>(0);
+    auto values = page->column_values<boost::string_view>(1);
+    ASSERT_EQ(expecteds.size(), keys.size());
+    ASSERT_EQ(expecteds.size(), values.size());
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        ASSERT_FALSE(keys.is_null(i));
+        ASSERT_FALSE(values.is_null(i));
+        EXPECT_EQ(expecteds.at(keys[i]), values[i].to_string());
+        EXPECT_EQ(page->rows()[i].get_object<int32_t>(0), keys[i]);
+        EXPECT_EQ(page->rows()[i].get_object<std::string>(1),
+                  values[i].to_string());
+    }
+
+    EXPECT_THROW(page->column_values<int64_t>(0), boost::bad_any_cast);
+    EXPECT_THROW(page->column_values<std::string>(1), boost::bad_any_cast);
+    EXPECT_THROW(page->column_values<int32_t>(2),
+                 exception::index_out_of_bounds);
+    EXPECT_THROW(page->rows()[0].get_object<int64_t>(0), boost::bad_any_cast);
+}
+
 TEST_F(SqlTest, wrong_syntax)
 {
     auto result_f =
@@ -1400,6 +1427,175 @@ TEST_F(SqlTest, test_execute_with_cursor_buffer_size)
     }
 }
 
+TEST_F(SqlTest, test_execute_with_prefetch_depth)
+{
+    static constexpr int CURSOR_BUFFER_SIZE = 3;
+
+    create_mapping();
+    auto expecteds = populate_map(map, 50);
+
+    sql::sql_statement statement{
+        client, (boost::format("SELECT * FROM %1%") % map_name).str()
+    };
+
+    statement.cursor_buffer_size(CURSOR_BUFFER_SIZE).prefetch_depth(4);
+
+    auto result = client.get_sql().execute(statement).get();
+
+    std::unordered_map<int, int> actuals;
+    for (auto itr = result->iterator(); itr.has_next();) {
+        auto page = itr.next().get();
+        EXPECT_LE(page->row_count(), CURSOR_BUFFER_SIZE);
+        for (const auto& row : page->rows()) {
+            actuals.emplace(*row.get_object<int>(0), *row.get_object<int>(1));
+        }
+    }
+    EXPECT_EQ(expecteds, actuals);
+}
+
+TEST_F(SqlTest, test_close_with_prefetched_pages)
+{
+    create_mapping();
+    (void)populate_map(map, 50);
+
+    sql::sql_statement statement{
+        client, (boost::format("SELECT * FROM %1%") % map_name).str()
+    };
+
+    statement.cursor_buffer_size(3).prefetch_depth(4);
+
+    auto result = client.get_sql().execute(statement).get();
+
+    auto itr = result->iterator();
+    itr.next().get();
+    itr.next().get();
+
+    ASSERT_NO_THROW(result->close().get());
+    EXPECT_THROW(itr.next(), sql::hazelcast_sql_exception);
+}
+
+TEST_F(SqlTest, test_stream_rows)
+{
+    create_mapping();
+    auto expecteds = populate_map(map, 50);
+
+    sql::sql_statement statement{
+        client, (boost::format("SELECT * FROM %1%") % map_name).str()
+    };
+
+    statement.cursor_buffer_size(3).prefetch_depth(1);
+
+    auto result = client.get_sql().execute(statement).get();
+
+    std::unordered_map<int, int> actuals;
+    result
+      ->stream_rows([&actuals](const sql::sql_page::sql_row& row) {
+          actuals.emplace(*row.get_object<int>(0), *row.get_object<int>(1));
+          return true;
+      })
+      .get();
+
+    EXPECT_EQ(expecteds, actuals);
+    try {
+        result->iterator();
+        FAIL();
+    } catch (exception::illegal_state& e) {
+        EXPECT_EQ("Iterator can be requested only once", e.get_message());
+    }
+}
+
+TEST_F(SqlTest, test_stream_rows_stopped_by_the_consumer)
+{
+    create_mapping();
+    (void)populate_map(map, 50);
+
+    sql::sql_statement statement{
+        client, (boost::format("SELECT * FROM %1%") % map_name).str()
+    };
+
+    statement.cursor_buffer_size(3);
+
+    auto result = client.get_sql().execute(statement).get();
+
+    int consumed = 0;
+    result
+      ->stream_rows([&consumed](const sql::sql_page::sql_row&) {
+          return ++consumed < 5;
+      })
+      .get();
+
+    EXPECT_EQ(5, consumed);
+    // the result is closed when the consumer stops
+    EXPECT_THROW(result->iterator(), sql::hazelcast_sql_exception);
+}
+
+TEST_F(SqlTest, test_stream_rows_when_the_page_fetch_fails)
+{
+    create_mapping();
+    (void)populate_map(map, 50);
+
+    sql::sql_statement statement{
+        client, (boost::format("SELECT * FROM %1%") % map_name).str()
+    };
+
+    statement.cursor_buffer_size(3);
+
+    auto result = client.get_sql().execute(statement).get();
+
+    int consumed = 0;
+    auto streamed =
+      result->stream_rows([&consumed, result](const sql::sql_page::sql_row&) {
+          if (++consumed == 1) {
+              // the next page can not be fetched from a closed result
+              result->close();
+          }
+          return true;
+      });
+
+    EXPECT_THROW(streamed.get(), sql::hazelcast_sql_exception);
+    EXPECT_EQ(3, consumed);
+}
+
+TEST_F(SqlTest, test_stream_rows_when_the_consumer_throws)
+{
+    create_mapping();
+    (void)populate_map(map, 50);
+
+    sql::sql_statement statement{
+        client, (boost::format("SELECT * FROM %1%") % map_name).str()
+    };
+
+    statement.cursor_buffer_size(3);
+
+    auto result = client.get_sql().execute(statement).get();
+
+    int consumed = 0;
+    auto streamed =
+      result->stream_rows([&consumed](const sql::sql_page::sql_row&) -> bool {
+          if (++consumed == 5) {
+              throw exception::illegal_argument("consumer", "row rejected");
+          }
+          return true;
+      });
+
+    try {
+        streamed.get();
+        FAIL();
+    } catch (exception::illegal_argument& e) {
+        EXPECT_EQ("row rejected", e.get_message());
+    }
+    EXPECT_EQ(5, consumed);
+}
+
+TEST_F(SqlTest, test_negative_prefetch_depth)
+{
+    sql::sql_statement statement{ client, "SELECT 1" };
+
+    EXPECT_EQ(sql::sql_statement::DEFAULT_PREFETCH_DEPTH,
+              statement.prefetch_depth());
+    EXPECT_THROW(statement.prefetch_depth(-1), exception::illegal_argument);
+}
+
 TEST_F(SqlTest, test_execute_with_schema)
 {
     create_mapping_for_student();